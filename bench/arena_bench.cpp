@@ -0,0 +1,44 @@
+#include <vector>
+#include <cstdint>
+
+#include "edo/base/arena.hpp"
+#include "edo/base/bytebuf.hpp"
+
+#include "bench.hpp"
+
+EDO_BENCHMARK(arena)
+{
+    // What a tick typically builds: a list of hits and a packet
+    edo::FrameArena arena;
+    std::size_t total = 0;
+
+    edo::bench::measure("std::vector + Bytebuf, heap", 1000000, [&]()
+    {
+        std::vector<uintptr_t> hits;
+        for(uintptr_t i = 0; i < 64; i++)
+            hits.push_back(i);
+
+        edo::Bytebuf packet;
+        for(uintptr_t hit : hits)
+            packet.put(static_cast<uint64_t>(hit));
+
+        total += packet.size();
+    });
+
+    edo::bench::measure("FrameVector + Bytebuf, arena", 1000000, [&]()
+    {
+        edo::FrameVector<uintptr_t> hits{edo::FrameAllocator<uintptr_t>(
+            arena)};
+        for(uintptr_t i = 0; i < 64; i++)
+            hits.push_back(i);
+
+        edo::Bytebuf packet(arena);
+        for(uintptr_t hit : hits)
+            packet.put(static_cast<uint64_t>(hit));
+
+        total += packet.size();
+        arena.reset();
+    });
+
+    edo::bench::keep(total);
+}
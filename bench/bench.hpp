@@ -0,0 +1,72 @@
+#ifndef EDO_BENCH_HPP
+#define EDO_BENCH_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// Defines a benchmark run by edo-bench
+#define EDO_BENCHMARK(name)\
+    static void name();\
+    static ::edo::bench::Registrar name##_registrar(#name, name);\
+    static void name()
+
+namespace edo
+{
+    namespace bench
+    {
+        typedef void (*Function)();
+
+        struct Benchmark
+        {
+            const char* name;
+            Function function;
+        };
+
+        /// Returns every registered benchmark
+        inline std::vector<Benchmark>& benchmarks()
+        {
+            static std::vector<Benchmark> list;
+            return list;
+        }
+
+        /// Registers a benchmark, see EDO_BENCHMARK
+        struct Registrar
+        {
+            Registrar(const char* name, Function function)
+            {
+                benchmarks().push_back(Benchmark{name, function});
+            }
+        };
+
+        /// Keeps the compiler from optimizing away a value
+        template<typename T>
+        inline void keep(const T& value)
+        {
+            asm volatile("" : : "g"(&value) : "memory");
+        }
+
+        /// Runs a callable a given amount of times after a warm up and
+        /// prints the time per iteration
+        /// @returns The time per iteration in nanoseconds
+        template<typename F>
+        double measure(const std::string& label, std::size_t iterations, F f)
+        {
+            for(std::size_t i = 0; i < iterations / 10; i++)
+                f();
+
+            auto begin = std::chrono::steady_clock::now();
+            for(std::size_t i = 0; i < iterations; i++)
+                f();
+            auto end = std::chrono::steady_clock::now();
+
+            double ns = std::chrono::duration<double, std::nano>(
+                end - begin).count() / iterations;
+            std::printf("  %-44s %12.2f ns\n", label.c_str(), ns);
+
+            return ns;
+        }
+    }
+}
+#endif
@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <string>
+#include <cstdint>
+
+#include "edo/base/binlog.hpp"
+
+#include "bench.hpp"
+
+EDO_BENCHMARK(binlog)
+{
+    // A decoded packet as the game thread would log it
+    std::string name = "player_move";
+    uint32_t id = 0x1a2b;
+    double x = 12.5;
+    double y = -3.25;
+
+    char line[128];
+    std::size_t total = 0;
+    edo::bench::measure("snprintf", 1000000, [&]()
+    {
+        total += std::snprintf(line, sizeof(line),
+            "packet %s id=%u at %g,%g", name.c_str(), id, x, y);
+    });
+
+    {
+        // Holds every message, so the drain runs only after measuring and
+        // its cost is left out
+        edo::BinaryLogger logger("binlog_bench.log", 128 * 1024 * 1024,
+            1000000000000LL);
+        edo::bench::measure("EDO_LOG, call site", 1000000, [&]()
+        {
+            EDO_LOG(logger, "packet {} id={} at {},{}", name, id, x, y);
+        });
+
+        total += logger.dropped();
+    }
+
+    {
+        // Drains meanwhile, on few cores their cost shows up here
+        edo::BinaryLogger logger("binlog_bench.log", 64 * 1024 * 1024);
+        edo::bench::measure("EDO_LOG, draining", 1000000, [&]()
+        {
+            EDO_LOG(logger, "packet {} id={} at {},{}", name, id, x, y);
+        });
+
+        total += logger.dropped();
+    }
+
+    std::remove("binlog_bench.log");
+    edo::bench::keep(total);
+}
@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "edo/ipc/channel.hpp"
+
+#include "bench.hpp"
+
+namespace
+{
+    const std::size_t MESSAGES = 1000000;
+    const std::size_t MESSAGE_SIZE = 64;
+    const std::size_t ROUND_TRIPS = 20000;
+
+    double elapsed_ns(std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void report(const char* label, double ns, std::size_t count)
+    {
+        std::printf("  %-44s %12.2f ns/msg %10.1f MB/s\n", label, ns / count,
+            count * MESSAGE_SIZE / (ns / 1e9) / 1e6);
+    }
+}
+
+EDO_BENCHMARK(channel_throughput)
+{
+    edo::Channel channel(1 << 20);
+    edo::Channel done(4096);
+    std::vector<uint8_t> message(MESSAGE_SIZE, 0x5A);
+
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        std::size_t received = 0;
+        uint64_t checksum = 0;
+        while(received < MESSAGES && channel.wait(5000))
+        {
+            received += channel.drain([&](const uint8_t* data, std::size_t)
+            {
+                checksum += data[0];
+            });
+        }
+
+        done.send(reinterpret_cast<uint8_t*>(&checksum), sizeof(checksum));
+        _exit(0);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < MESSAGES; i++)
+        channel.send(message.data(), message.size());
+
+    edo::Bytebuf ack;
+    done.receive(ack, 5000);
+    report("channel, 64 byte records", elapsed_ns(begin), MESSAGES);
+    waitpid(pid, nullptr, 0);
+}
+
+EDO_BENCHMARK(pipe_throughput)
+{
+    int fds[2];
+    if(pipe(fds) != 0)
+        return;
+
+    std::vector<uint8_t> message(MESSAGE_SIZE, 0x5A);
+
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        close(fds[1]);
+        std::vector<uint8_t> buffer(1 << 16);
+        while(read(fds[0], buffer.data(), buffer.size()) > 0)
+        {
+
+        }
+
+        _exit(0);
+    }
+
+    close(fds[0]);
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < MESSAGES; i++)
+    {
+        if(write(fds[1], message.data(), message.size()) < 0)
+            break;
+    }
+
+    close(fds[1]);
+    waitpid(pid, nullptr, 0);
+    report("pipe, 64 byte writes", elapsed_ns(begin), MESSAGES);
+}
+
+EDO_BENCHMARK(channel_latency)
+{
+    edo::Channel ping(4096);
+    edo::Channel pong(4096);
+    uint64_t value = 0;
+
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        for(std::size_t i = 0; i < ROUND_TRIPS; i++)
+        {
+            if(!ping.wait(5000))
+                break;
+
+            ping.drain([&](const uint8_t*, std::size_t) {});
+            pong.send(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+        }
+
+        _exit(0);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < ROUND_TRIPS; i++)
+    {
+        ping.send(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+        pong.wait(5000);
+        pong.drain([](const uint8_t*, std::size_t) {});
+    }
+
+    double ns = elapsed_ns(begin);
+    waitpid(pid, nullptr, 0);
+    std::printf("  %-44s %12.2f ns\n", "channel, one way latency",
+        ns / ROUND_TRIPS / 2);
+}
@@ -0,0 +1,258 @@
+#include <map>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/configuration.hpp"
+#include "edo/base/config_snapshot.hpp"
+
+#include "bench.hpp"
+
+namespace
+{
+    const std::size_t ENTRIES = 200000;
+
+    /// The stringstream based edo::split the legacy parser called, kept
+    /// here so the baseline does not change with edo::split
+    std::vector<std::string> legacy_split(
+        const std::string& str,
+        const char delim
+    )
+    {
+        std::stringstream ss;
+        std::string line;
+        std::vector<std::string> result;
+        ss.str(str);
+
+        if(str == "")
+        {
+            result.push_back("");
+            return result;
+        }
+
+        while(std::getline(ss, line, delim))
+        {
+            result.push_back(line);
+        }
+
+        return result;
+    }
+
+    /// The stringstream based parser ConfigMap::parse used to be
+    void legacy_parse(
+        std::map<std::string, std::string>& kv_map,
+        const std::string& config_str
+    )
+    {
+        std::stringstream perLine;
+        std::string line;
+        perLine.str(config_str);
+
+        while(std::getline(perLine, line))
+        {
+            if(line == "")
+                continue;
+
+            auto split_res = legacy_split(line, '=');
+
+            if(split_res.size() == 2 && split_res[0] != "" &&
+                split_res[1] != "")
+            {
+                kv_map.emplace(split_res[0], split_res[1]);
+            }
+            else
+                throw std::runtime_error(MALFORMATTED_CONFIG_STR);
+        }
+    }
+
+    /// Times a callable in a forked child
+    /// Freeing a map of 200k nodes leaves the heap fragmented, which
+    /// slows down the next one by a multiple, while a config is usually
+    /// loaded into a fresh process
+    template<typename F>
+    double elapsed(F f)
+    {
+        int fds[2];
+        if(pipe(fds) != 0)
+            return 0;
+
+        pid_t pid = fork();
+        if(pid == 0)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            f();
+            double ns = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - begin).count();
+
+            ssize_t written = write(fds[1], &ns, sizeof(ns));
+            _exit(written == sizeof(ns) ? 0 : 1);
+        }
+
+        double ns = 0;
+        ssize_t result = read(fds[0], &ns, sizeof(ns));
+        (void) result;
+        waitpid(pid, nullptr, 0);
+        close(fds[0]);
+        close(fds[1]);
+
+        return ns;
+    }
+
+    /// Generates an offset config like the ones produced by our tooling
+    std::string offset_config(bool sorted)
+    {
+        std::string config;
+        char line[96];
+        for(std::size_t i = 0; i < ENTRIES; i++)
+        {
+            std::size_t n = sorted ? i : (i * 7919) % ENTRIES;
+            std::snprintf(line, sizeof(line),
+                "client.module_%03zu.offset_%06zu=0x%08zx\n",
+                n * 512 / ENTRIES, n, n * 0x40 + 0x1000);
+            config += line;
+        }
+
+        return config;
+    }
+}
+
+EDO_BENCHMARK(config_parse)
+{
+    // The best run of each parser counts
+    const int RUNS = 5;
+    const bool orders[] = {true, false};
+    for(bool sorted : orders)
+    {
+        std::string config = offset_config(sorted);
+        std::printf("  200k entries, %s, %.1f MB\n",
+            sorted ? "sorted" : "shuffled", config.size() / 1e6);
+
+        double legacy = 0;
+        double current = 0;
+        for(int run = 0; run < RUNS; run++)
+        {
+            double ns = elapsed([&]()
+            {
+                std::map<std::string, std::string> kv_map;
+                legacy_parse(kv_map, config);
+                edo::bench::keep(kv_map);
+            });
+            legacy = run == 0 || ns < legacy ? ns : legacy;
+
+            ns = elapsed([&]()
+            {
+                edo::ConfigMap map;
+                map.parse(config);
+                edo::bench::keep(map);
+            });
+            current = run == 0 || ns < current ? ns : current;
+        }
+
+        std::printf("  %-44s %12.2f ms\n", "stringstream + split", legacy / 1e6);
+        std::printf("  %-44s %12.2f ms\n", "ConfigMap::parse", current / 1e6);
+        std::printf("  speedup: %.2fx, %.0f ns per entry\n", legacy / current,
+            current / ENTRIES);
+    }
+}
+
+EDO_BENCHMARK(config_read)
+{
+    edo::ConfigMap map;
+    map.parse(offset_config(true));
+    map.put("scan.budget_us", "750");
+
+    int32_t sum = 0;
+    edo::bench::measure("ConfigMap::get<int32_t>", 1000000, [&]()
+    {
+        sum += map.get<int32_t>("scan.budget_us");
+    });
+
+    // The memory clobber of keep() forces a reload every iteration
+    edo::ConfigHandle<int32_t> budget = map.handle<int32_t>("scan.budget_us");
+    edo::bench::measure("ConfigHandle<int32_t>::get", 100000000, [&]()
+    {
+        sum += budget.get();
+        edo::bench::keep(sum);
+    });
+
+    edo::bench::keep(sum);
+}
+
+EDO_BENCHMARK(config_snapshot)
+{
+    const char* TEXT_PATH = "config_snapshot_bench.cfg";
+    const char* SNAPSHOT_PATH = "config_snapshot_bench.bin";
+
+    std::string config = offset_config(true);
+    edo::ConfigMap map;
+    map.parse(config);
+    map.put("scan.budget_us", "750");
+
+    edo::write_file(TEXT_PATH,
+        reinterpret_cast<const uint8_t*>(config.data()), config.size());
+    edo::Bytebuf buf = map.serialize_snapshot();
+    edo::write_file(SNAPSHOT_PATH, buf.data(), buf.size());
+    std::printf("  200k entries, text %.1f MB, snapshot %.1f MB\n",
+        config.size() / 1e6, buf.size() / 1e6);
+
+    // Startup, the best of a few runs in fresh processes
+    const int RUNS = 5;
+    double text = 0;
+    double snapshot = 0;
+    for(int run = 0; run < RUNS; run++)
+    {
+        double ns = elapsed([&]()
+        {
+            std::vector<uint8_t> data = edo::read_file(TEXT_PATH);
+            edo::ConfigMap loaded;
+            loaded.parse(reinterpret_cast<const char*>(data.data()),
+                data.size());
+            edo::bench::keep(loaded);
+        });
+        text = run == 0 || ns < text ? ns : text;
+
+        ns = elapsed([&]()
+        {
+            edo::ConfigSnapshot loaded(SNAPSHOT_PATH);
+            edo::bench::keep(loaded);
+        });
+        snapshot = run == 0 || ns < snapshot ? ns : snapshot;
+    }
+
+    std::printf("  %-44s %12.2f ms\n", "read_file + ConfigMap::parse",
+        text / 1e6);
+    std::printf("  %-44s %12.4f ms\n", "ConfigSnapshot open", snapshot / 1e6);
+
+    edo::ConfigSnapshot loaded(SNAPSHOT_PATH);
+    std::size_t length = 0;
+    edo::bench::measure("ConfigMap::get", 1000000, [&]()
+    {
+        length += map.get("client.module_256.offset_100000").size();
+    });
+    edo::bench::measure("ConfigSnapshot::get", 1000000, [&]()
+    {
+        length += loaded.get("client.module_256.offset_100000").size();
+    });
+
+    int64_t sum = 0;
+    edo::bench::measure("ConfigMap::get<int64_t>", 1000000, [&]()
+    {
+        sum += map.get<int64_t>("scan.budget_us");
+    });
+    edo::bench::measure("ConfigSnapshot::get<int64_t>", 1000000, [&]()
+    {
+        sum += loaded.get<int64_t>("scan.budget_us");
+    });
+
+    edo::bench::keep(length);
+    edo::bench::keep(sum);
+    std::remove(TEXT_PATH);
+    std::remove(SNAPSHOT_PATH);
+}
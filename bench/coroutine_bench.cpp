@@ -0,0 +1,78 @@
+#include <cstdio>
+
+#include "edo/base/scheduler.hpp"
+#include "edo/base/coroutine.hpp"
+
+#include "bench.hpp"
+
+#include <boost/asio/yield.hpp>
+
+namespace
+{
+    const std::size_t COROUTINES = 10000;
+    const std::size_t STEPS = 1000;
+
+    class Ticker : public edo::Coroutine
+    {
+    public:
+        Ticker(uint64_t& sum) : sum(sum)
+        {
+
+        }
+
+        edo::Await operator()() override
+        {
+            reenter(this)
+            {
+                while(true)
+                {
+                    sum++;
+                    yield return edo::Await::tick();
+                }
+            }
+            return edo::Await::done();
+        }
+
+        uint64_t& sum;
+    };
+
+    class Once : public edo::Coroutine
+    {
+    public:
+        edo::Await operator()() override
+        {
+            return edo::Await::done();
+        }
+    };
+}
+
+#include <boost/asio/unyield.hpp>
+
+EDO_BENCHMARK(coroutine_resume)
+{
+    edo::CoroutineRunner runner;
+    uint64_t sum = 0;
+    for(std::size_t i = 0; i < COROUTINES; i++)
+        runner.spawn<Ticker>(sum);
+
+    runner.step();
+    int64_t begin = edo::TickScheduler::now();
+    for(std::size_t i = 0; i < STEPS; i++)
+        runner.step();
+
+    double ns = static_cast<double>(edo::TickScheduler::now() - begin);
+    std::printf("  %-44s %12.2f ns\n", "resume of one of 10000 coroutines",
+        ns / (COROUTINES * STEPS));
+    edo::bench::keep(sum);
+}
+
+EDO_BENCHMARK(coroutine_spawn)
+{
+    // Frames come back to the pool, so only the first spawn allocates
+    edo::CoroutineRunner runner;
+    edo::bench::measure("spawn + run to completion", 1000000, [&]()
+    {
+        runner.spawn<Once>();
+        runner.step();
+    });
+}
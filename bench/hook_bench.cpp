@@ -0,0 +1,77 @@
+#include "edo/hook/hook.hpp"
+
+#include "bench.hpp"
+
+namespace
+{
+    typedef int (*Function)(int);
+
+    const std::size_t ITERATIONS = 50000000;
+
+    /// Optimized builds compile the target to lea and ret, too short to
+    /// hook, so it gets a 5 byte nop like a hot-patchable prologue
+    __attribute__((noinline)) int hook_bench_target(int x)
+    {
+        asm volatile(".byte 0x0F, 0x1F, 0x44, 0x00, 0x00");
+        return x + 1;
+    }
+
+    Function original = nullptr;
+
+    __attribute__((noinline)) int hook_bench_detour(int x)
+    {
+        return original(x);
+    }
+
+    __attribute__((noinline)) int hook_bench_replacement(int x)
+    {
+        asm volatile("");
+        return x + 1;
+    }
+}
+
+EDO_BENCHMARK(hook_call_overhead)
+{
+    Function volatile target = hook_bench_target;
+    int x = 0;
+
+    double base = edo::bench::measure("unhooked call", ITERATIONS,
+        [&]() { x = target(x); });
+
+    edo::HookEngine engine;
+    std::size_t id = engine.hook(reinterpret_cast<void*>(hook_bench_target),
+        reinterpret_cast<void*>(hook_bench_replacement));
+    engine.commit();
+
+    double replaced = edo::bench::measure("hooked, detour only", ITERATIONS,
+        [&]() { x = target(x); });
+
+    engine.unhook(id);
+    engine.commit();
+    id = engine.hook(reinterpret_cast<void*>(hook_bench_target),
+        reinterpret_cast<void*>(hook_bench_detour));
+    original = engine.original<Function>(id);
+    engine.commit();
+
+    double chained = edo::bench::measure("hooked, detour calls original",
+        ITERATIONS, [&]() { x = target(x); });
+
+    edo::bench::keep(x);
+    std::printf("  overhead: %.2f ns detour only, %.2f ns through trampoline\n",
+        replaced - base, chained - base);
+}
+
+EDO_BENCHMARK(hook_commit)
+{
+    // Hook and unhook the same target repeatedly, each commit touches one
+    // page twice
+    edo::HookEngine engine;
+    edo::bench::measure("hook + commit + unhook + commit", 2000, [&]()
+    {
+        std::size_t id = engine.hook(reinterpret_cast<void*>(hook_bench_target),
+            reinterpret_cast<void*>(hook_bench_replacement));
+        engine.commit();
+        engine.unhook(id);
+        engine.commit();
+    });
+}
@@ -0,0 +1,23 @@
+#include <cstdio>
+#include <cstring>
+
+#include "bench.hpp"
+
+int main(int argc, char** argv)
+{
+    #ifndef __OPTIMIZE__
+    std::printf("warning: benchmarks built without optimization\n");
+    #endif
+
+    // Runs every benchmark whose name contains the first argument
+    for(const edo::bench::Benchmark& benchmark : edo::bench::benchmarks())
+    {
+        if(argc > 1 && std::strstr(benchmark.name, argv[1]) == nullptr)
+            continue;
+
+        std::printf("%s\n", benchmark.name);
+        benchmark.function();
+    }
+
+    return 0;
+}
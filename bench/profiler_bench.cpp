@@ -0,0 +1,43 @@
+#include "edo/base/profiler.hpp"
+
+#include "bench.hpp"
+
+EDO_BENCHMARK(profiler)
+{
+    edo::Profiler profiler;
+    std::size_t counter = profiler.metric("counter",
+        edo::Profiler::Kind::counter);
+    std::size_t histogram = profiler.metric("histogram",
+        edo::Profiler::Kind::histogram);
+    std::size_t timer = profiler.metric("timer", edo::Profiler::Kind::timer);
+
+    edo::bench::measure("Profiler::add", 10000000, [&]()
+    {
+        profiler.add(counter);
+    });
+
+    uint64_t value = 0;
+    edo::bench::measure("Profiler::record", 10000000, [&]()
+    {
+        profiler.record(histogram, value++ & 0xFFFF);
+    });
+
+    edo::bench::measure("ScopedTimer", 1000000, [&]()
+    {
+        edo::ScopedTimer scoped(profiler, timer);
+    });
+
+    profiler.set_tracing(true);
+    edo::bench::measure("ScopedTimer, tracing", 50000, [&]()
+    {
+        edo::ScopedTimer scoped(profiler, timer);
+    });
+
+    // Compiles to nothing without the EDO_PROFILING option
+    edo::bench::measure("EDO_PROFILE_COUNT", 10000000, [&]()
+    {
+        EDO_PROFILE_COUNT("bench.count", 1);
+    });
+
+    edo::bench::keep(value);
+}
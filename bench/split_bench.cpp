@@ -0,0 +1,70 @@
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/split.hpp"
+
+#include "bench.hpp"
+
+namespace
+{
+    /// The stringstream based split edo::split used to be
+    std::vector<std::string> legacy_split(const std::string& str, char delim)
+    {
+        std::stringstream ss;
+        std::string line;
+        std::vector<std::string> result;
+        ss.str(str);
+
+        if(str == "")
+        {
+            result.push_back("");
+            return result;
+        }
+
+        while(std::getline(ss, line, delim))
+            result.push_back(line);
+
+        return result;
+    }
+}
+
+EDO_BENCHMARK(split)
+{
+    // A line of a maps file and a field list of a log line
+    std::string maps = "7f2a1c000000-7f2a1c021000 rw-p 00000000 00:00 0 "
+        "                         [heap]";
+    std::string fields = "tick=1024|module=client|offset=0x1a2b3c|"
+        "duration_ns=16384|overruns=0|late=0";
+
+    std::size_t total = 0;
+    edo::bench::measure("stringstream + getline", 1000000, [&]()
+    {
+        total += legacy_split(maps, ' ').size();
+        total += legacy_split(fields, '|').size();
+    });
+
+    edo::bench::measure("edo::split", 1000000, [&]()
+    {
+        total += edo::split(maps, ' ').size();
+        total += edo::split(fields, '|').size();
+    });
+
+    edo::bench::measure("edo::split_view", 1000000, [&]()
+    {
+        for(boost::string_view token : edo::split_view(maps, ' '))
+            total += token.size();
+
+        for(boost::string_view token : edo::split_view(fields, '|'))
+            total += token.size();
+    });
+
+    edo::bench::measure("edo::split_view, string delimiter", 1000000, [&]()
+    {
+        for(boost::string_view token : edo::split_view(fields, "|o"))
+            total += token.size();
+    });
+
+    edo::bench::keep(total);
+}
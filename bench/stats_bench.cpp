@@ -0,0 +1,32 @@
+#include "edo/base/stats.hpp"
+#include "edo/base/scheduler.hpp"
+
+#include "bench.hpp"
+
+namespace
+{
+    const std::size_t ITERATIONS = 20000000;
+}
+
+EDO_BENCHMARK(tick_stats_record)
+{
+    edo::Histogram histogram;
+    edo::TickStats stats;
+    uint64_t value = 12345;
+
+    edo::bench::measure("Histogram::record", ITERATIONS, [&]()
+    {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+        histogram.record(value >> 44);
+    });
+
+    // What a tick costs to instrument, including both clock reads
+    edo::bench::measure("clock reads + TickStats::record", ITERATIONS, [&]()
+    {
+        int64_t begin = edo::TickScheduler::now();
+        stats.record(edo::TickScheduler::now() - begin, 0, false);
+    });
+
+    edo::bench::keep(histogram.percentile(0.99));
+    edo::bench::keep(stats.p99());
+}
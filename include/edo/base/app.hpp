@@ -1,6 +1,16 @@
 #ifndef EDO_APP_HPP
 #define EDO_APP_HPP
 
+#include <atomic>
+#include <memory>
+
+#include "edo/base/pool.hpp"
+#include "edo/base/arena.hpp"
+#include "edo/base/stats.hpp"
+#include "edo/base/events.hpp"
+#include "edo/base/coroutine.hpp"
+#include "edo/base/scheduler.hpp"
+
 namespace edo
 {
     /**
@@ -19,29 +29,109 @@ namespace edo
 
         /**
          * Abstract main method of the application
-         * Will be called by the run() method a given amount of times per second
+         * Will be called by the run() method a given amount of times per second,
+         * see scheduler()
+         * In event mode it is called after every batch of events instead,
+         * see runEvents()
          * Setting the exit flag causes the application to exit
          */
         virtual void main() = 0;
 
         /**
         * Runs the application until the exit flag is set
-        * When this method returns, the application has finished
+        * When this method returns, the application has finished,
+        * including every task spawned on pool()
         */
         void run();
-        
+
+        /**
+         * Runs the application in event mode until the exit flag is set
+         * Sleeps until a source registered with events() becomes ready,
+         * dispatches its callbacks and then calls main()
+         */
+        void runEvents();
+
         /**
          * Returns whether the application should exit or not
+         * Safe to call from any thread, long tasks should check it
          */
         bool shouldExit();
 
         /**
          * Sets the exit flag of the application to given value
+         * Safe to call from any thread, setting it interrupts a waiting
+         * event loop
          */
         void setExit(bool exit);
 
+        /**
+         * Returns the scheduler pacing the calls to main(), 100 per second by default
+         * Its rate, overrun policy and spin window may be changed at any time
+         */
+        TickScheduler& scheduler();
+
+        /**
+         * Returns the event loop used by runEvents() to register file
+         * descriptors, timers and wakeups with
+         */
+        EventLoop& events();
+
+        /**
+         * Returns the thread pool tasks of the application are spawned on
+         * It is created with one worker per hardware thread on first use,
+         * and joined once run() or runEvents() return
+         */
+        ThreadPool& pool();
+
+        /**
+         * Sets whether every task spawned on pool() has to finish before
+         * main() is called again, false by default
+         * The calling thread runs tasks while it waits
+         */
+        void setJoinTasks(bool join);
+
+        /**
+         * Returns whether tasks are joined before every call to main()
+         */
+        bool joinTasks();
+
+        /**
+         * Returns the runner of the coroutines of the application, which
+         * is stepped after every call to main()
+         * In event mode, waited for file descriptors and delays wake up
+         * the event loop, and it does not sleep while a coroutine waits
+         * for a tick
+         */
+        CoroutineRunner& coroutines();
+
+        /**
+         * Returns the timing statistics of the ticks, each covering main(),
+         * the coroutines and the task join if enabled
+         * Readable from any thread while the application runs
+         */
+        TickStats& stats();
+
+        /**
+         * Returns the arena for memory which lives for one tick, reset
+         * before every call to main()
+         * Tasks spawned on pool() must not use it, it is not thread-safe
+         */
+        FrameArena& frame();
+
     private:
-        bool exit;
+        /**
+         * Waits for the outstanding tasks and joins the pool
+         */
+        void shutdown();
+
+        std::atomic<bool> exit;
+        bool join_tasks;
+        std::unique_ptr<ThreadPool> task_pool;
+        TickStats tick_stats;
+        FrameArena frame_arena;
+        TickScheduler tick_scheduler;
+        EventLoop event_loop;
+        CoroutineRunner coroutine_runner;
     };
 }
 #endif
\ No newline at end of file
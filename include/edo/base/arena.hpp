@@ -0,0 +1,167 @@
+#ifndef EDO_ARENA_HPP
+#define EDO_ARENA_HPP
+
+#include <new>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace edo
+{
+    /// A bump allocator for memory which lives until the next reset, such
+    /// as everything a tick allocates
+    /// Allocating moves a pointer and freeing does nothing. Once a chunk is
+    /// full another one is chained, and the next reset merges the chain
+    /// into a single chunk of the combined size, so a steady workload
+    /// allocates from one chunk without touching the heap
+    class FrameArena
+    {
+    public:
+        /// Size of the first chunk unless given otherwise
+        static const std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+        /// Constructs an arena with a first chunk of a given size
+        explicit FrameArena(const std::size_t capacity = DEFAULT_CAPACITY);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /// Frees every chunk
+        ~FrameArena();
+
+        /// Returns memory of a given size and alignment, valid until the
+        /// next reset
+        /// @throws invalid_argument If alignment is not a power of two
+        void* allocate(
+            const std::size_t size,
+            const std::size_t alignment = alignof(std::max_align_t)
+        );
+
+        /// Frees everything allocated since the last reset at once
+        void reset();
+
+        /// Returns the amount of bytes allocated since the last reset,
+        /// including alignment padding
+        std::size_t used() const;
+
+        /// Returns the amount of bytes of all chunks
+        std::size_t capacity() const;
+
+        /// Returns the largest amount of bytes allocated between two resets
+        std::size_t high_water() const;
+
+        /// Returns the amount of chunks chained because one ran full
+        uint64_t overflows() const;
+
+    private:
+        struct Chunk
+        {
+            uint8_t* data;
+            std::size_t size;
+        };
+
+        void* overflow(const std::size_t size, const std::size_t alignment);
+
+        std::vector<Chunk> chunks;
+        uint8_t* top;
+        uint8_t* limit;
+
+        std::size_t used_bytes;
+        std::size_t high_water_bytes;
+        uint64_t overflow_count;
+    };
+
+    /// An allocator for standard containers which allocates from a
+    /// FrameArena, or from the heap if it has none
+    /// Containers using an arena must not outlive its next reset. Copies of
+    /// them allocate from the heap and move assignment keeps the allocator
+    /// of the target, so copying or move assigning frame data into a longer
+    /// lived container is safe. Move construction and swapping carry the
+    /// arena along
+    template<typename T>
+    class FrameAllocator
+    {
+    public:
+        typedef T value_type;
+        typedef std::false_type propagate_on_container_copy_assignment;
+        typedef std::false_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        /// Constructs an allocator using the heap
+        FrameAllocator() : frame_arena(nullptr)
+        {
+
+        }
+
+        /// Constructs an allocator using a given arena
+        explicit FrameAllocator(FrameArena& arena) : frame_arena(&arena)
+        {
+
+        }
+
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U>& other) :
+            frame_arena(other.arena())
+        {
+
+        }
+
+        T* allocate(const std::size_t n)
+        {
+            if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+                throw std::bad_alloc();
+
+            if(frame_arena == nullptr)
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+
+            return static_cast<T*>(frame_arena->allocate(n * sizeof(T),
+                alignof(T)));
+        }
+
+        void deallocate(T* pointer, const std::size_t)
+        {
+            if(frame_arena == nullptr)
+                ::operator delete(pointer);
+        }
+
+        /// Returns the allocator of a copy of a container, which uses the
+        /// heap
+        FrameAllocator select_on_container_copy_construction() const
+        {
+            return FrameAllocator();
+        }
+
+        /// Returns the arena, nullptr if the heap is used
+        FrameArena* arena() const
+        {
+            return frame_arena;
+        }
+
+        template<typename U>
+        bool operator==(const FrameAllocator<U>& other) const
+        {
+            return frame_arena == other.arena();
+        }
+
+        template<typename U>
+        bool operator!=(const FrameAllocator<U>& other) const
+        {
+            return frame_arena != other.arena();
+        }
+
+    private:
+        FrameArena* frame_arena;
+    };
+
+    /// A vector which may allocate from a FrameArena
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    /// A string which may allocate from a FrameArena
+    typedef std::basic_string<char, std::char_traits<char>,
+        FrameAllocator<char>> FrameString;
+}
+#endif
@@ -0,0 +1,482 @@
+#ifndef EDO_BINLOG_HPP
+#define EDO_BINLOG_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <condition_variable>
+#include <boost/utility/string_view.hpp>
+
+#include "edo/base/padded.hpp"
+#include "edo/base/bytebuf.hpp"
+#include "edo/base/scheduler.hpp"
+
+/// Logs a message to a BinaryLogger, formatting it is deferred to the
+/// reader. The format is registered once per call site and every "{}" in
+/// it is replaced by the next argument
+#define EDO_LOG(logger, format_string, ...)\
+    do\
+    {\
+        static const uint32_t edo_log_format =\
+            ::edo::BinaryLogger::format(format_string);\
+        (logger).log(edo_log_format, ##__VA_ARGS__);\
+    } while(0)
+
+namespace edo
+{
+    /// A logger which defers formatting to when the log is read
+    /// A call site writes the id of its format string, a timestamp and its
+    /// raw arguments to a lock-free ring buffer of the calling thread. A
+    /// background thread drains the rings into a binary file, encoded the
+    /// way Bytebuf encodes values, which BinaryLogReader or the
+    /// edo-logdecode tool turns into text. Logging never blocks or
+    /// allocates, a message not fitting into the ring is dropped and
+    /// counted instead
+    /// Supported arguments are bools, chars, integers, floating point
+    /// numbers, strings and pointers
+    class BinaryLogger
+    {
+    public:
+        /// Size of the ring of every thread unless given otherwise
+        static const std::size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+        /// Nanoseconds between drains unless given otherwise
+        static const int64_t DEFAULT_INTERVAL = 10000000;
+
+        /// Creates or truncates a log file and starts draining into it
+        /// @param buffer_size Size of the ring of every thread, rounded up
+        /// to a power of two
+        /// @param interval Nanoseconds between drains
+        /// @throws EdoError If the file could not be opened
+        explicit BinaryLogger(
+            const std::string& path,
+            const std::size_t buffer_size = DEFAULT_BUFFER_SIZE,
+            const int64_t interval = DEFAULT_INTERVAL
+        );
+
+        BinaryLogger(const BinaryLogger&) = delete;
+        BinaryLogger& operator=(const BinaryLogger&) = delete;
+
+        /// Stops the background thread and writes the remaining messages
+        ~BinaryLogger();
+
+        /// Registers a format string for all loggers and returns its id,
+        /// or the id it was registered with before
+        static uint32_t format(const std::string& format);
+
+        /// Logs a message of a format registered through format()
+        template<typename... Args>
+        void log(const uint32_t format, const Args&... args)
+        {
+            ThreadBuffer& buffer = local();
+
+            std::size_t size = ENTRY_HEADER_SIZE + args_size(args...);
+            uint64_t head = buffer.head.value.load(std::memory_order_relaxed);
+            uint64_t tail = buffer.tail.value.load(std::memory_order_acquire);
+            if(size > buffer.mask + 1 - (head - tail))
+            {
+                buffer.dropped.store(
+                    buffer.dropped.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+                return;
+            }
+
+            Cursor cursor = {buffer.data.get(), buffer.mask, head};
+            cursor.put(ENTRY);
+            cursor.put(format);
+            cursor.put(TickScheduler::now());
+            cursor.put(buffer.index);
+            cursor.put(static_cast<uint8_t>(sizeof...(Args)));
+            put_args(cursor, args...);
+
+            // The drain takes the bytes below the head, so publish it last
+            buffer.head.value.store(head + size, std::memory_order_release);
+        }
+
+        /// Writes every message logged so far to the file
+        void flush();
+
+        /// Returns the amount of messages dropped because a ring was full
+        uint64_t dropped() const;
+
+        /// Returns the amount of failed writes to the file
+        uint64_t errors() const;
+
+    private:
+        friend class BinaryLogReader;
+
+        /// Kinds of records in the file
+        static const uint8_t FORMAT = 0;
+        static const uint8_t ENTRY = 1;
+
+        /// Kind, format, time, thread and argument count
+        static const std::size_t ENTRY_HEADER_SIZE = 18;
+
+        /// Kinds of arguments, each followed by its value
+        enum class ArgType : uint8_t
+        {
+            boolean,
+            character,
+            integer,
+            unsigned_integer,
+            floating,
+            string,
+            pointer
+        };
+
+        /// The ring of one thread, written by that thread only
+        struct ThreadBuffer
+        {
+            std::thread::id thread;
+            uint32_t index;
+
+            std::unique_ptr<uint8_t[]> data;
+            std::size_t mask;
+            std::atomic<uint64_t> dropped;
+
+            // The thread and the drain write to separate cache lines
+            CachePadded<std::atomic<uint64_t>> head;
+            CachePadded<std::atomic<uint64_t>> tail;
+        };
+
+        /// Writes to a ring, wrapping around at its end
+        struct Cursor
+        {
+            uint8_t* data;
+            std::size_t mask;
+            uint64_t position;
+
+            void write(const void* source, const std::size_t length)
+            {
+                std::size_t offset = position & mask;
+                std::size_t first = mask + 1 - offset;
+                if(first >= length)
+                {
+                    // Lets the copy of a fixed size become a single store
+                    std::memcpy(data + offset, source, length);
+                }
+                else
+                {
+                    std::memcpy(data + offset, source, first);
+                    std::memcpy(data,
+                        static_cast<const uint8_t*>(source) + first,
+                        length - first);
+                }
+
+                position += length;
+            }
+
+            template<typename T>
+            void put(const T value)
+            {
+                write(&value, sizeof(T));
+            }
+        };
+
+        static std::size_t arg_size(const bool)
+        {
+            return 2;
+        }
+
+        static std::size_t arg_size(const char)
+        {
+            return 2;
+        }
+
+        static std::size_t arg_size(const signed char)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const unsigned char)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const short)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const unsigned short)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const int)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const unsigned int)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const long)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const unsigned long)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const long long)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const unsigned long long)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const double)
+        {
+            return 9;
+        }
+
+        static std::size_t arg_size(const char* str)
+        {
+            return 5 + std::strlen(str);
+        }
+
+        static std::size_t arg_size(const std::string& str)
+        {
+            return 5 + str.size();
+        }
+
+        static std::size_t arg_size(const boost::string_view& str)
+        {
+            return 5 + str.size();
+        }
+
+        template<typename T>
+        static std::size_t arg_size(const T*)
+        {
+            return 9;
+        }
+
+        static std::size_t args_size()
+        {
+            return 0;
+        }
+
+        template<typename T, typename... Args>
+        static std::size_t args_size(const T& arg, const Args&... args)
+        {
+            return arg_size(arg) + args_size(args...);
+        }
+
+        static void put_arg(Cursor& cursor, const bool value)
+        {
+            cursor.put(ArgType::boolean);
+            cursor.put(static_cast<uint8_t>(value));
+        }
+
+        static void put_arg(Cursor& cursor, const char value)
+        {
+            cursor.put(ArgType::character);
+            cursor.put(value);
+        }
+
+        static void put_arg(Cursor& cursor, const signed char value)
+        {
+            put_signed(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const unsigned char value)
+        {
+            put_unsigned(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const short value)
+        {
+            put_signed(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const unsigned short value)
+        {
+            put_unsigned(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const int value)
+        {
+            put_signed(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const unsigned int value)
+        {
+            put_unsigned(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const long value)
+        {
+            put_signed(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const unsigned long value)
+        {
+            put_unsigned(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const long long value)
+        {
+            put_signed(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const unsigned long long value)
+        {
+            put_unsigned(cursor, value);
+        }
+
+        static void put_arg(Cursor& cursor, const double value)
+        {
+            cursor.put(ArgType::floating);
+            cursor.put(value);
+        }
+
+        static void put_arg(Cursor& cursor, const char* str)
+        {
+            put_string(cursor, str, std::strlen(str));
+        }
+
+        static void put_arg(Cursor& cursor, const std::string& str)
+        {
+            put_string(cursor, str.data(), str.size());
+        }
+
+        static void put_arg(Cursor& cursor, const boost::string_view& str)
+        {
+            put_string(cursor, str.data(), str.size());
+        }
+
+        template<typename T>
+        static void put_arg(Cursor& cursor, const T* pointer)
+        {
+            cursor.put(ArgType::pointer);
+            cursor.put(static_cast<uint64_t>(
+                reinterpret_cast<uintptr_t>(pointer)));
+        }
+
+        static void put_args(Cursor&)
+        {
+
+        }
+
+        template<typename T, typename... Args>
+        static void put_args(Cursor& cursor, const T& arg, const Args&... args)
+        {
+            put_arg(cursor, arg);
+            put_args(cursor, args...);
+        }
+
+        static void put_signed(Cursor& cursor, const int64_t value)
+        {
+            cursor.put(ArgType::integer);
+            cursor.put(value);
+        }
+
+        static void put_unsigned(Cursor& cursor, const uint64_t value)
+        {
+            cursor.put(ArgType::unsigned_integer);
+            cursor.put(value);
+        }
+
+        /// Writes a string length prefixed as a uint32_t, like Bytebuf
+        static void put_string(
+            Cursor& cursor,
+            const char* str,
+            const std::size_t length
+        )
+        {
+            cursor.put(ArgType::string);
+            cursor.put(static_cast<uint32_t>(length));
+            cursor.write(str, length);
+        }
+
+        /// Returns the ring of the calling thread
+        ThreadBuffer& local();
+
+        /// Returns the ring of the calling thread, allocating it
+        ThreadBuffer& attach();
+
+        /// Drains the rings until the logger is destroyed
+        void run();
+
+        /// Writes bytes to the file, counting a failure
+        void write(const uint8_t* data, const std::size_t length);
+
+        int fd;
+        std::size_t buffer_size;
+        int64_t interval;
+
+        /// Distinguishes loggers for the cached ring of each thread
+        uint64_t serial;
+
+        mutable std::mutex thread_mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+        /// Held while draining, guards everything below
+        std::mutex drain_mutex;
+        Bytebuf staging;
+        std::size_t written_formats;
+        std::atomic<uint64_t> error_count;
+
+        std::mutex stop_mutex;
+        std::condition_variable stop_condition;
+        bool stopping;
+        std::thread drainer;
+    };
+
+    /// A message read from a binary log
+    struct LogEntry
+    {
+        /// Nanoseconds since the Unix epoch
+        int64_t time;
+
+        /// Index of the logging thread, starting at 1
+        uint32_t thread;
+
+        /// Id of the format string
+        uint32_t format;
+
+        /// The formatted message
+        std::string message;
+    };
+
+    /// Reads the messages of a file written by BinaryLogger
+    class BinaryLogReader
+    {
+    public:
+        /// Reads a log file
+        /// @throws NotFoundError If the file could not be opened
+        /// @throws EdoError If the file is not a binary log
+        explicit BinaryLogReader(const std::string& path);
+
+        /// Reads and formats the next message
+        /// A message cut off at the end of the file, e.g. by a crash, ends
+        /// the log like the end of the file does
+        /// @returns False at the end of the log
+        /// @throws EdoError If a record is malformatted
+        bool next(LogEntry& entry);
+
+    private:
+        /// Appends the next argument to a message
+        void format_arg(std::string& message);
+
+        Bytebuf buf;
+        int64_t steady_origin;
+        int64_t wall_origin;
+        std::vector<std::string> formats;
+    };
+}
+#endif
@@ -2,7 +2,9 @@
 #define EDO_BYTEBUF_HPP
 
 #include <vector>
+#include <string>
 
+#include "edo/base/arena.hpp"
 #include "edo/base/strings.hpp"
 #include "edo/base/endian.hpp"
 
@@ -20,6 +22,10 @@ namespace edo
         /// Default constructor
         Bytebuf();
 
+        /// Constructs a buffer which allocates from a given arena, it must
+        /// not be used after the next reset of the arena
+        explicit Bytebuf(FrameArena& arena);
+
         /// Returns the size of the buffer
         std::size_t size();
 
@@ -127,6 +133,14 @@ namespace edo
         void put(const std::size_t index, const double value);
         void put(const double value);
 
+        /// Inserts a string at given index, prefixed by its length as a uint32_t
+        /// @throws out_of_range If index exceeds buffer size
+        void put(const std::size_t index, const std::string& str);
+
+        /// Appends a length prefixed string and advances the buffer position
+        /// past it
+        void put(const std::string& str);
+
         /// Gets an object of type T from given index
         /// @param index The index of where to get from
         /// @throws out_of_range If requested type is too large
@@ -157,8 +171,17 @@ namespace edo
             return res;
         }
 
+        /// Gets a length prefixed string from given index
+        /// @throws out_of_range If the string exceeds the buffer size
+        std::string get_string(const std::size_t index);
+
+        /// Gets a length prefixed string and advances the buffer position
+        /// past it
+        /// @throws out_of_range If the string exceeds the buffer size
+        std::string get_string();
+
     private:
-        std::vector<uint8_t> buffer;
+        std::vector<uint8_t, FrameAllocator<uint8_t>> buffer;
         std::size_t position;
     };
 }
@@ -0,0 +1,191 @@
+#ifndef EDO_CONFIG_SNAPSHOT_HPP
+#define EDO_CONFIG_SNAPSHOT_HPP
+
+#include <limits>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <boost/lexical_cast.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include "edo/base/bytebuf.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/configuration.hpp"
+
+namespace edo
+{
+    /// A read-only ConfigMap in binary form, written by
+    /// ConfigMap::serialize_snapshot()
+    /// Entries are fixed size records sorted by key which point into a
+    /// string table, so opening a snapshot maps the file and reads its
+    /// header, and a lookup is a binary search without allocating.
+    /// Integer values are stored converted as well, which spares get<T>()
+    /// of arithmetic types the lexical cast.
+    /// Snapshots use the native byte order. Entries are bounds checked as
+    /// they are read rather than when the snapshot is opened
+    class ConfigSnapshot
+    {
+    public:
+        /// Maps a snapshot file read only
+        /// @throws NotFoundError If the file could not be opened
+        /// @throws runtime_error If the file is not a snapshot
+        explicit ConfigSnapshot(const std::string& path);
+
+        /// Reads a snapshot from memory, which has to outlive it
+        /// @throws runtime_error If the data is not a snapshot
+        ConfigSnapshot(const uint8_t* data, const std::size_t length);
+
+        ConfigSnapshot(const ConfigSnapshot&) = delete;
+        ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+        /// Unmaps the file
+        ~ConfigSnapshot();
+
+        /// Serializes the key-value pairs of a map into a snapshot
+        /// @throws runtime_error If the keys and values exceed 4 GiB
+        static Bytebuf serialize(const ConfigMap& map);
+
+        /// Returns the amount of key-value pairs in the snapshot
+        std::size_t size() const;
+
+        /// Returns whether a given key exists in the snapshot
+        /// @throws runtime_error If the snapshot is malformatted
+        bool has_key(const std::string& key) const;
+
+        /// Returns the value assosciated with given key
+        /// @throws out_of_range If given key does not exist in the snapshot
+        /// @throws runtime_error If the snapshot is malformatted
+        std::string get(const std::string& key) const;
+
+        /// Returns the value assosciated with given key casted to type T,
+        /// as ConfigMap::get<T>() would
+        /// @throws out_of_range If given key does not exist in the snapshot
+        /// @throws runtime_error If the casting fails or the snapshot is
+        /// malformatted
+        template<typename T>
+        T get(const std::string& key) const
+        {
+            Entry found;
+            if(!find(key, found))
+                throw std::out_of_range(NONEXISTANT_KEY);
+
+            return convert<T>(found, typename Converted<T>::type());
+        }
+
+        /// Returns the key of the pair at a given index, pairs are sorted
+        /// by key
+        /// @throws out_of_range If index exceeds the size of the snapshot
+        /// @throws runtime_error If the snapshot is malformatted
+        boost::string_view key(const std::size_t index) const;
+
+        /// Returns the value of the pair at a given index
+        /// @throws out_of_range If index exceeds the size of the snapshot
+        /// @throws runtime_error If the snapshot is malformatted
+        boost::string_view value(const std::size_t index) const;
+
+    private:
+        /// A key-value pair as stored in the file, offsets are relative to
+        /// the string table
+        struct Entry
+        {
+            uint32_t key_offset;
+            uint32_t key_length;
+            uint32_t value_offset;
+            uint32_t value_length;
+            int64_t integer;
+            uint32_t flags;
+            uint32_t reserved;
+        };
+
+        /// Set on entries whose value is an integer in canonical form
+        static const uint32_t INTEGER = 1;
+
+        /// Whether get<T>() may use the stored integer, lexical_cast reads
+        /// single byte types as characters and bool from 0 and 1 only
+        template<typename T>
+        struct Converted
+        {
+            typedef std::integral_constant<bool,
+                std::is_arithmetic<T>::value && (sizeof(T) > 1)
+                && !std::is_same<T, wchar_t>::value
+                && !std::is_same<T, char16_t>::value
+                && !std::is_same<T, char32_t>::value> type;
+        };
+
+        template<typename T>
+        T convert(const Entry& found, std::true_type) const
+        {
+            // Integers T holds exactly come out as lexical_cast would
+            // parse them, the rest goes through lexical_cast
+            if((found.flags & INTEGER) != 0 && exact<T>(found.integer,
+                typename std::is_floating_point<T>::type()))
+            {
+                return static_cast<T>(found.integer);
+            }
+
+            return convert<T>(found, std::false_type());
+        }
+
+        template<typename T>
+        T convert(const Entry& found, std::false_type) const
+        {
+            boost::string_view text = string(found.value_offset,
+                found.value_length);
+
+            try
+            {
+                return boost::lexical_cast<T>(text.data(), text.size());
+            }
+            catch(const boost::bad_lexical_cast&)
+            {
+                throw std::runtime_error(BAD_CAST);
+            }
+        }
+
+        template<typename T>
+        static bool exact(const int64_t value, std::true_type)
+        {
+            const int digits = std::numeric_limits<T>::digits;
+            if(digits >= 63)
+                return true;
+
+            const int64_t limit = int64_t(1) << (digits < 63 ? digits : 62);
+            return value > -limit && value < limit;
+        }
+
+        template<typename T>
+        static bool exact(const int64_t value, std::false_type)
+        {
+            if(std::is_signed<T>::value)
+            {
+                return value >= static_cast<int64_t>(
+                    std::numeric_limits<T>::min())
+                    && value <= static_cast<int64_t>(
+                    std::numeric_limits<T>::max());
+            }
+
+            return value >= 0 && static_cast<uint64_t>(value)
+                <= static_cast<uint64_t>(std::numeric_limits<T>::max());
+        }
+
+        void read_header();
+        bool find(const std::string& key, Entry& found) const;
+        Entry entry(const std::size_t index) const;
+        boost::string_view string(
+            const uint32_t offset,
+            const uint32_t length
+        ) const;
+
+        const uint8_t* snapshot_data;
+        std::size_t snapshot_size;
+        bool mapped;
+
+        std::size_t entry_count;
+        const uint8_t* entries;
+        const uint8_t* strings;
+        std::size_t strings_size;
+    };
+}
+#endif
@@ -0,0 +1,157 @@
+#ifndef EDO_CONFIG_SOURCE_HPP
+#define EDO_CONFIG_SOURCE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#include "edo/base/padded.hpp"
+#include "edo/base/configuration.hpp"
+
+namespace edo
+{
+    /// A configuration file which is reloaded whenever it changes
+    /// A background thread watches the file through inotify and publishes
+    /// every successfully parsed version as a new immutable ConfigMap.
+    /// Readers pin the current version through snapshot() without locking
+    /// and never see a partially applied update, old versions are freed
+    /// by a later reload once no reader pins them anymore
+    /// A file written in place may be read while half-written and is
+    /// published if that part parses, writers should write a temporary
+    /// file and rename it over the watched one instead
+    class ConfigSource
+    {
+    public:
+        /// Called on the reload thread with the new and the previous value
+        /// of a key, nullptr where the key does not exist
+        typedef std::function<void(const std::string*, const std::string*)>
+            Callback;
+
+        /// Maximum amount of snapshots pinned at once, further calls to
+        /// snapshot() wait for one to be released
+        static const std::size_t MAX_READERS = 64;
+
+        /// A pinned version of the configuration
+        /// Has to be released before the ConfigSource is destroyed
+        class Snapshot
+        {
+        public:
+            Snapshot(Snapshot&& other);
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            /// Releases the version
+            ~Snapshot();
+
+            const ConfigMap& operator*() const;
+            const ConfigMap* operator->() const;
+
+            /// Returns the version number, starting at 1 for the initial
+            /// load and growing by one per reload
+            uint64_t version() const;
+
+        private:
+            friend class ConfigSource;
+
+            struct Version;
+
+            Snapshot(std::atomic<uint64_t>* slot, const Version* pinned);
+
+            std::atomic<uint64_t>* slot;
+            const Version* pinned;
+        };
+
+        /// Loads the file at a given path and starts watching it
+        /// @throws NotFoundError If the file could not be opened
+        /// @throws runtime_error If the file is malformatted
+        /// @throws EdoError If the file cannot be watched
+        explicit ConfigSource(const std::string& path);
+
+        ConfigSource(const ConfigSource&) = delete;
+        ConfigSource& operator=(const ConfigSource&) = delete;
+
+        /// Stops watching and frees every version
+        ~ConfigSource();
+
+        /// Pins the current version, safe to call from any thread
+        Snapshot snapshot() const;
+
+        /// Returns the number of the current version
+        uint64_t version() const;
+
+        /// Reloads the file now, as the watcher does on changes
+        /// A missing or malformatted file keeps the current version
+        /// @returns Whether a new version was published
+        bool reload();
+
+        /// Returns the amount of reloads which failed and kept the
+        /// current version, plus the amount of callbacks which threw
+        uint64_t errors() const;
+
+        /// Calls a callback whenever a reload changes, adds or removes a
+        /// given key and returns the subscription id
+        /// Callbacks run after the new version is published and must not
+        /// call reload(). An exception thrown by a callback is counted in
+        /// errors() and does not keep the others from running
+        std::size_t subscribe(const std::string& key, const Callback& callback);
+
+        /// Stops a subscription, its id is not reused
+        /// @throws out_of_range If no such subscription exists
+        void unsubscribe(const std::size_t id);
+
+    private:
+        struct Subscription
+        {
+            bool active;
+            std::string key;
+            Callback callback;
+        };
+
+        struct Retired
+        {
+            const Snapshot::Version* version;
+
+            /// Readers which announced this epoch or an earlier one may
+            /// still use the version
+            uint64_t epoch;
+        };
+
+        /// Padded so readers on different cores do not share a line
+        struct ReaderSlot
+        {
+            /// The epoch the reader pinned a version in, 0 if free
+            CachePadded<std::atomic<uint64_t>> epoch;
+        };
+
+        void watch();
+        void publish(const Snapshot::Version* next);
+        void notify(const ConfigMap& next, const ConfigMap& previous);
+        void reclaim();
+
+        std::string path;
+        std::string directory;
+        std::string name;
+
+        std::atomic<const Snapshot::Version*> current;
+        std::atomic<uint64_t> global_epoch;
+        mutable ReaderSlot readers[MAX_READERS];
+
+        /// Serializes reloads, owned versions are only touched under it
+        std::mutex reload_mutex;
+        std::vector<Retired> retired;
+        std::atomic<uint64_t> error_count;
+
+        std::mutex subscription_mutex;
+        std::vector<Subscription> subscriptions;
+
+        int inotify_fd;
+        int stop_fd;
+        std::thread watcher;
+    };
+}
+#endif
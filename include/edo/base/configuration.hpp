@@ -2,12 +2,125 @@
 #define EDO_CONFIGURATION_HPP
 
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
 #include <boost/lexical_cast.hpp>
 
+#include "edo/base/bytebuf.hpp"
 #include "edo/base/strings.hpp"
 
 namespace edo
 {
+    class ConfigSnapshot;
+
+    namespace config_detail
+    {
+        enum class SlotState
+        {
+            missing,
+            bad_cast,
+            valid
+        };
+
+        /// The converted value of a key, shared by a ConfigHandle with the
+        /// ConfigMap which refreshes it
+        class Slot
+        {
+        public:
+            virtual ~Slot();
+
+            /// Converts a new value of the key, nullptr if it was erased
+            virtual void update(const std::string* value) = 0;
+        };
+
+        template<typename T>
+        class TypedSlot : public Slot
+        {
+        public:
+            TypedSlot() : value(), state(SlotState::missing)
+            {
+
+            }
+
+            void update(const std::string* str) override
+            {
+                if(str == nullptr)
+                {
+                    state = SlotState::missing;
+                    return;
+                }
+
+                // A failed cast keeps the previous value around
+                try
+                {
+                    value = boost::lexical_cast<T>(*str);
+                    state = SlotState::valid;
+                }
+                catch(const boost::bad_lexical_cast&)
+                {
+                    state = SlotState::bad_cast;
+                }
+            }
+
+            T value;
+            SlotState state;
+        };
+    }
+
+    /// A value of a ConfigMap key, converted to type T once and refreshed
+    /// whenever put, erase, parse or clear change the key
+    /// Reading it is a load, no lookup or cast happens
+    template<typename T>
+    class ConfigHandle
+    {
+    public:
+        /// Constructs a handle to no key
+        ConfigHandle()
+        {
+
+        }
+
+        /// Returns whether the key exists and could be cast to type T
+        bool valid() const
+        {
+            return slot && slot->state == config_detail::SlotState::valid;
+        }
+
+        /// Returns the value of the key
+        /// @throws out_of_range If the key does not exist in the map
+        /// @throws runtime_error If the value could not be cast
+        const T& get() const
+        {
+            if(!slot || slot->state == config_detail::SlotState::missing)
+                throw std::out_of_range(NONEXISTANT_KEY);
+
+            if(slot->state == config_detail::SlotState::bad_cast)
+                throw std::runtime_error(BAD_CAST);
+
+            return slot->value;
+        }
+
+        /// Returns the value of the key without checking valid()
+        const T& operator*() const
+        {
+            return slot->value;
+        }
+
+    private:
+        friend class ConfigMap;
+
+        explicit ConfigHandle(
+            const std::shared_ptr<config_detail::TypedSlot<T>>& slot
+        ) : slot(slot)
+        {
+
+        }
+
+        std::shared_ptr<config_detail::TypedSlot<T>> slot;
+    };
+
     /// A simple string kv-pair based configuration map
     /// In external format, pairs are separated by newline and format
     /// is as follows:
@@ -15,35 +128,65 @@ namespace edo
     class ConfigMap
     {
     public:
+        typedef std::map<std::string, std::string>::const_iterator
+            const_iterator;
+
         /// Default constructor
         ConfigMap();
 
+        /// Copies the key-value pairs, handles stay with the original
+        ConfigMap(const ConfigMap& other);
+
+        /// Replaces the key-value pairs and refreshes every handle
+        ConfigMap& operator=(const ConfigMap& other);
+
         /// Parses a configuration string and inserts the keys
+        /// Keys which already exist keep their value
         /// @throws runtime_error If malformatted config string is given
         void parse(const std::string& config_str);
 
+        /// Parses a configuration string of a given length, e.g. the
+        /// contents of a file, without copying it first
+        /// @throws runtime_error If malformatted config string is given
+        void parse(const char* config_str, const std::size_t length);
+
+        /// Inserts the keys of a binary snapshot
+        /// Keys which already exist keep their value
+        /// @throws runtime_error If the snapshot is malformatted
+        void parse(const ConfigSnapshot& snapshot);
+
         /// Serializes the map into string format (see classwide comment)
-        std::string serialize();
+        std::string serialize() const;
+
+        /// Serializes the map into a binary snapshot, see ConfigSnapshot
+        /// @throws runtime_error If the keys and values exceed 4 GiB
+        Bytebuf serialize_snapshot() const;
+
+        /// Returns an iterator to the first pair in key order
+        const_iterator begin() const;
+
+        /// Returns an iterator past the last pair
+        const_iterator end() const;
 
         /// Returns the amount of key-value pairs in the map
-        std::size_t size();
+        std::size_t size() const;
 
         /// Clears the map
         void clear();
 
         /// Returns whether a given key exists in the map
-        bool has_key(const std::string& key);
+        bool has_key(const std::string& key) const;
 
         /// Returns the value assosciated with given key
         /// @throws out_of_range If given key does not exist in the map
-        std::string get(const std::string& key);
+        std::string get(const std::string& key) const;
 
         /// Returns the value assosciated with given key lexical casted
         /// to type T
         /// @throws out_of_range If given key does not exist in the map
         /// @throws runtime_error If the lexical casting fails
         template<typename T>
-        T get(const std::string& key)
+        T get(const std::string& key) const
         {
             std::string val = get(key);
 
@@ -87,8 +230,35 @@ namespace edo
         /// @throws out_of_range If given key does not exist in the map
         void erase(const std::string& key);
 
+        /// Returns a handle to the value of a given key lexical casted to
+        /// type T, see ConfigHandle
+        /// The key does not need to exist yet
+        template<typename T>
+        ConfigHandle<T> handle(const std::string& key)
+        {
+            std::shared_ptr<config_detail::TypedSlot<T>> slot =
+                std::make_shared<config_detail::TypedSlot<T>>();
+
+            auto it = kv_map.find(key);
+            slot->update(it != kv_map.end() ? &it->second : nullptr);
+            slots[key].push_back(slot);
+
+            return ConfigHandle<T>(slot);
+        }
+
     private:
+        /// Updates the handles of a key, nullptr if it was erased
+        void refresh(const std::string& key, const std::string* value);
+
+        /// Updates every handle
+        void refresh_all();
+
         std::map<std::string, std::string> kv_map;
+
+        /// Slots of the handles of each key, expired ones are dropped on
+        /// the next refresh
+        std::map<std::string, std::vector<std::weak_ptr<config_detail::Slot>>>
+            slots;
     };
 }
 #endif
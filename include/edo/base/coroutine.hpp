@@ -0,0 +1,248 @@
+#ifndef EDO_COROUTINE_HPP
+#define EDO_COROUTINE_HPP
+
+#include <new>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <functional>
+#include <boost/asio/coroutine.hpp>
+
+namespace edo
+{
+    /// What a suspended coroutine waits for before it is resumed
+    class Await
+    {
+    public:
+        enum class Kind
+        {
+            done,
+            tick,
+            delay,
+            readable,
+            writable,
+            until
+        };
+
+        /// Finishes the coroutine
+        static Await done();
+
+        /// Resumes on the next step of the runner, which is the next tick
+        /// of IApplication::run() or the next batch of events of
+        /// IApplication::runEvents()
+        static Await tick();
+
+        /// Resumes once a given amount of nanoseconds have passed
+        static Await delay(const int64_t nanoseconds);
+
+        /// Resumes once a file descriptor is readable
+        static Await readable(const int fd);
+
+        /// Resumes once a file descriptor is writable
+        static Await writable(const int fd);
+
+        /// Resumes on the first step a predicate holds on
+        static Await until(const std::function<bool()>& predicate);
+
+        /// Resumes on the first step a queue holds data on, works with
+        /// anything with a size() such as BoundedQueue or BufferQueue
+        template<typename Q>
+        static Await data(const Q& queue)
+        {
+            const Q* q = &queue;
+            return until([q]() { return q->size() > 0; });
+        }
+
+        Kind kind;
+
+        /// The delay, or the deadline once suspended, in nanoseconds
+        int64_t time;
+        int fd;
+        std::function<bool()> predicate;
+    };
+
+    /// A stackless coroutine run by a CoroutineRunner
+    /// Subclasses keep their state in members and write their body with
+    /// the reenter and yield macros of <boost/asio/yield.hpp>, yielding
+    /// what they wait for:
+    ///
+    ///     Await operator()() override
+    ///     {
+    ///         reenter(this)
+    ///         {
+    ///             yield return Await::until([this]() { return changed(); });
+    ///             patch();
+    ///         }
+    ///         return Await::done();
+    ///     }
+    class Coroutine : public boost::asio::coroutine
+    {
+    public:
+        virtual ~Coroutine();
+
+        /// Runs the coroutine to its next suspension
+        /// @returns What to wait for, done() once finished
+        virtual Await operator()() = 0;
+    };
+
+    /// Runs coroutines without threads, resuming each once what it waits
+    /// for has happened
+    /// Coroutine objects are allocated from pooled frames and the slots of
+    /// finished coroutines are reused, so spawning, suspending and resuming
+    /// do not touch the heap once the pools are warm
+    class CoroutineRunner
+    {
+    public:
+        /// Constructs a runner
+        /// @throws EdoError If epoll is not available
+        CoroutineRunner();
+
+        CoroutineRunner(const CoroutineRunner&) = delete;
+        CoroutineRunner& operator=(const CoroutineRunner&) = delete;
+
+        /// Destroys every coroutine which has not finished
+        ~CoroutineRunner();
+
+        /// Constructs a coroutine of type T and returns its id, it first
+        /// runs on the next step
+        template<typename T, typename... Args>
+        std::size_t spawn(Args&&... args)
+        {
+            static_assert(std::is_base_of<Coroutine, T>::value,
+                "Spawned type has to derive from Coroutine");
+            static_assert(alignof(T) <= alignof(std::max_align_t),
+                "Spawned type is overaligned");
+
+            void* frame = frames.allocate(sizeof(T));
+            Coroutine* coroutine;
+            try
+            {
+                coroutine = new (frame) T(std::forward<Args>(args)...);
+            }
+            catch(...)
+            {
+                frames.deallocate(frame, sizeof(T));
+                throw;
+            }
+
+            return add(coroutine, sizeof(T));
+        }
+
+        /// Destroys a coroutine before it finishes
+        /// A coroutine finishes itself by returning Await::done() instead.
+        /// Ids of finished coroutines never name another coroutine
+        /// The slot of the coroutine is reused from the next step on
+        /// @throws out_of_range If no such coroutine exists
+        void cancel(const std::size_t id);
+
+        /// Returns whether a coroutine has not finished yet
+        bool active(const std::size_t id) const;
+
+        /// Returns the amount of coroutines which have not finished
+        std::size_t size() const;
+
+        /// Resumes every coroutine whose wait is over
+        /// A coroutine which throws, or whose wait cannot be set up, is
+        /// destroyed. The step still resumes the others and passes the
+        /// first exception on once it is done
+        /// @returns The amount of resumed coroutines
+        std::size_t step();
+
+        /// Returns whether a coroutine waits for the next step, in which
+        /// case an event loop should not sleep before it
+        bool pending() const;
+
+        /// Returns a descriptor which becomes readable once a waited for
+        /// file descriptor is ready or a delay has passed, for sleeping in
+        /// an event loop between steps
+        int fd() const;
+
+    private:
+        /// Fixed size blocks in power of two size classes, larger frames
+        /// come from the heap
+        class FramePool
+        {
+        public:
+            FramePool();
+            ~FramePool();
+
+            void* allocate(const std::size_t size);
+            void deallocate(void* frame, const std::size_t size);
+
+        private:
+            static const std::size_t MIN_SHIFT = 6;
+            static const std::size_t CLASSES = 7;
+            static const std::size_t CHUNK_BLOCKS = 32;
+
+            static std::size_t size_class(const std::size_t size);
+
+            void* free_lists[CLASSES];
+            std::vector<void*> chunks;
+        };
+
+        struct Entry
+        {
+            Coroutine* coroutine;
+            std::size_t size;
+            Await wait;
+
+            /// Counts the coroutines the slot held, part of their ids
+            uint32_t generation;
+        };
+
+        /// The coroutines waiting for a file descriptor, which share one
+        /// registration with epoll
+        struct Watch
+        {
+            std::size_t readers;
+            std::size_t writers;
+
+            /// Events reported since the last step
+            uint32_t events;
+            bool registered;
+        };
+
+        std::size_t add(Coroutine* coroutine, const std::size_t size);
+        bool runnable(Entry& entry, const int64_t now);
+
+        /// @throws EdoError If a file descriptor cannot be waited for
+        void suspend(const std::size_t slot, Await wait, const int64_t now);
+
+        /// @throws EdoError If a file descriptor cannot be waited for
+        void watch(const int fd, const Await::Kind kind);
+        void unwatch(Entry& entry);
+
+        /// Registers a file descriptor for what its coroutines wait for
+        /// @returns False if epoll refused the descriptor
+        bool rearm(const int fd);
+
+        void destroy(const std::size_t slot);
+        void arm(const int64_t deadline);
+
+        FramePool frames;
+        std::vector<Entry> entries;
+        std::vector<std::size_t> free_slots;
+
+        /// Indexed by file descriptor
+        std::vector<Watch> watches;
+
+        /// Descriptors with events since the last step
+        std::vector<int> fired;
+
+        /// Slots of the coroutines which have not finished, in spawn order
+        std::vector<std::size_t> running;
+        std::vector<std::size_t> resumable;
+        std::size_t active_count;
+
+        /// Coroutines waiting for the next step, as of the last step
+        std::size_t tick_count;
+
+        /// Epoll instance of the waited for file descriptors and the timer
+        int epoll_fd;
+        int timer_fd;
+        int64_t armed;
+    };
+}
+#endif
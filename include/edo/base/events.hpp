@@ -0,0 +1,141 @@
+#ifndef EDO_EVENTS_HPP
+#define EDO_EVENTS_HPP
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <sys/epoll.h>
+
+namespace edo
+{
+    /// Dispatches callbacks on readiness of file descriptors, timers and
+    /// wakeups through epoll
+    /// Sources are added and removed on the thread running the loop,
+    /// notify(), interrupt() and stop() may be called from any thread
+    class EventLoop
+    {
+    public:
+        /// Called with the ready epoll events of a file descriptor
+        typedef std::function<void(uint32_t)> Callback;
+
+        /// Called with the amount of expirations since the last call
+        typedef std::function<void(uint64_t)> TimerCallback;
+
+        /// Called once for any amount of notifications since the last call
+        typedef std::function<void()> WakeupCallback;
+
+        /// Constructs an event loop
+        /// @throws EdoError If epoll is not available
+        EventLoop();
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        /// Closes the timers and wakeups, watched file descriptors stay open
+        ~EventLoop();
+
+        /// Watches a file descriptor for given epoll events, EPOLLIN by
+        /// default, and returns the source id
+        /// The descriptor is not owned and has to outlive the watch
+        /// @throws EdoError If the descriptor cannot be watched
+        std::size_t watch(
+            const int fd,
+            const Callback& callback,
+            const uint32_t events = EPOLLIN
+        );
+
+        /// Changes the epoll events of a watched file descriptor
+        /// @throws out_of_range If no such watch exists
+        void modify(const std::size_t id, const uint32_t events);
+
+        /// Adds a timer firing after a given interval in nanoseconds and
+        /// returns the source id
+        /// A timer which does not repeat is removed after firing once
+        /// @throws invalid_argument If the interval is not positive
+        std::size_t timer(
+            const int64_t interval,
+            const TimerCallback& callback,
+            const bool repeat = true
+        );
+
+        /// Adds a wakeup triggered by notify() and returns the source id
+        std::size_t wakeup(const WakeupCallback& callback);
+
+        /// Triggers a wakeup, notifications coalesce until it is dispatched
+        /// @throws out_of_range If no such wakeup exists
+        void notify(const std::size_t id);
+
+        /// Removes a source
+        /// Its slot is reused by later sources, but its id never names
+        /// another source
+        /// @throws out_of_range If no such source exists
+        void remove(const std::size_t id);
+
+        /// Returns whether a source exists
+        bool active(const std::size_t id) const;
+
+        /// Returns the amount of sources
+        std::size_t size() const;
+
+        /// Waits for events and dispatches them
+        /// @param timeout Milliseconds to wait at most, -1 waits until an
+        /// event or an interrupt arrives
+        /// @returns The amount of dispatched callbacks
+        std::size_t poll(const int timeout = -1);
+
+        /// Dispatches events until stop() is called
+        void run();
+
+        /// Makes run() return after the current batch of events
+        void stop();
+
+        /// Makes a blocked poll() return without dispatching anything
+        void interrupt();
+
+    private:
+        enum class Kind
+        {
+            fd,
+            timer,
+            wakeup
+        };
+
+        struct Source
+        {
+            bool active;
+            Kind kind;
+            int fd;
+            bool repeat;
+            Callback callback;
+            TimerCallback timer_callback;
+            WakeupCallback wakeup_callback;
+
+            /// Counts the sources the slot held, part of their ids
+            uint32_t generation;
+        };
+
+        std::size_t add(Source& source, const uint32_t events);
+
+        /// Invokes the callback of a ready source
+        /// @returns Whether a callback was invoked
+        bool dispatch(const std::size_t id, const uint32_t events);
+
+        int epoll_fd;
+
+        /// Eventfd behind interrupt() and stop()
+        int interrupt_fd;
+        std::atomic<bool> stopping;
+
+        /// Guards changes to the source list against notify() on other
+        /// threads, the loop thread reads it without locking
+        std::mutex source_mutex;
+        std::vector<Source> source_list;
+        std::vector<std::size_t> free_slots;
+        std::vector<epoll_event> ready;
+        std::size_t sources;
+    };
+}
+#endif
@@ -3,19 +3,43 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 #define EDO_ADDR(value) (reinterpret_cast<uint8_t*>(&value))
 
 namespace edo
 {
     /// Returns the result of splitting a given string at a given delim
+    /// Copies every token, see split_view() for a lazy split
     std::vector<std::string> split(const std::string& str, const char delim);
 
     /// Offsets a memory address by a given amount of offsets
+    /// Pointers are dereferenced without validation, see PointerPath for
+    /// safe and batched resolution
     uint8_t* follow(
         uint8_t* address,
         std::vector<intptr_t>::iterator begin,
         std::vector<intptr_t>::iterator end
     );
+
+    /// Returns the entire contents of the file at a given path
+    /// @throws NotFoundError If the file could not be opened
+    std::vector<uint8_t> read_file(const std::string& path);
+
+    /// Replaces the contents of the file at a given path
+    /// @throws EdoError If the file could not be written
+    void write_file(
+        const std::string& path,
+        const uint8_t* data,
+        const std::size_t length
+    );
+
+    /// Returns the 64-bit FNV-1a hash of a given array of bytes
+    /// @param seed A previous hash to continue from
+    uint64_t fnv1a(
+        const uint8_t* data,
+        const std::size_t length,
+        uint64_t seed = 0xcbf29ce484222325ULL
+    );
 }
 #endif
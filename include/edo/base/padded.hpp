@@ -0,0 +1,24 @@
+#ifndef EDO_PADDED_HPP
+#define EDO_PADDED_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace edo
+{
+    /// Size of a cache line on the supported CPUs
+    const std::size_t CACHE_LINE = 64;
+
+    /// Keeps a value off the cache lines of whatever lies next to it, so
+    /// threads writing neighbouring values do not contend for a line
+    /// The value is padded on both sides instead of aligned to a line, as
+    /// new ignores alignments above that of max_align_t before C++17
+    template<typename T>
+    struct CachePadded
+    {
+        uint8_t before[CACHE_LINE - alignof(T)];
+        T value;
+        uint8_t after[CACHE_LINE - alignof(T)];
+    };
+}
+#endif
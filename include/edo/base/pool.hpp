@@ -0,0 +1,134 @@
+#ifndef EDO_POOL_HPP
+#define EDO_POOL_HPP
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace edo
+{
+    class ThreadPool;
+
+    /// A handle to a task spawned on a ThreadPool
+    class Task
+    {
+    public:
+        /// Constructs an empty handle
+        Task();
+
+        /// Returns whether the task has finished
+        /// An empty handle counts as finished
+        bool done() const;
+
+        /// Runs queued tasks of the pool until this task has finished
+        /// @throws Whatever the task threw
+        void wait() const;
+
+    private:
+        friend class ThreadPool;
+
+        struct State
+        {
+            std::function<void()> function;
+            ThreadPool* pool;
+
+            /// Unfinished dependencies, plus one while spawning
+            std::atomic<std::size_t> dependencies;
+            std::atomic<bool> finished;
+            std::exception_ptr error;
+
+            /// Guards the continuations against the task finishing
+            std::mutex mutex;
+            std::vector<std::shared_ptr<State>> continuations;
+        };
+
+        Task(const std::shared_ptr<State>& state);
+
+        std::shared_ptr<State> state;
+    };
+
+    /// A work-stealing pool of threads
+    /// Every worker has its own queue. Tasks spawned by a worker go to its
+    /// own queue and are taken newest first, idle workers steal the oldest
+    /// tasks of the others. Threads waiting on the pool run tasks meanwhile
+    class ThreadPool
+    {
+    public:
+        /// Constructs a pool with a given amount of workers, 0 uses one
+        /// per hardware thread
+        explicit ThreadPool(std::size_t threads = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Waits for every task and joins the workers
+        ~ThreadPool();
+
+        /// Spawns a task
+        Task spawn(const std::function<void()>& function);
+
+        /// Spawns a task which runs once all given tasks have finished
+        /// Dependencies which failed still count as finished
+        Task spawn(
+            const std::function<void()>& function,
+            const std::vector<Task>& dependencies
+        );
+
+        /// Spawns a continuation of a given task
+        Task then(const Task& task, const std::function<void()>& function);
+
+        /// Runs queued tasks until every spawned task, including the ones
+        /// spawned meanwhile, has finished
+        /// Tasks of the pool have to wait for given tasks through
+        /// Task::wait() instead
+        /// @throws logic_error If called from within a task of the pool
+        void wait();
+
+        /// Runs one queued task on the calling thread
+        /// @returns Whether a task was run
+        bool run_one();
+
+        /// Returns the amount of workers
+        std::size_t size() const;
+
+        /// Returns the amount of spawned tasks which have not finished
+        std::size_t pending() const;
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::shared_ptr<Task::State>> queue;
+            std::thread thread;
+        };
+
+        void work(const std::size_t index);
+        void schedule(const std::shared_ptr<Task::State>& state);
+        void execute(const std::shared_ptr<Task::State>& state);
+        std::shared_ptr<Task::State> take(const std::size_t index);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        /// Tasks in the worker queues
+        std::atomic<std::size_t> queued;
+
+        /// Spawned tasks which have not finished
+        std::atomic<std::size_t> unfinished;
+        std::atomic<std::size_t> sleeping;
+        std::atomic<std::size_t> next_worker;
+        std::atomic<bool> stopping;
+
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_condition;
+        std::mutex done_mutex;
+        std::condition_variable done_condition;
+    };
+}
+#endif
@@ -0,0 +1,220 @@
+#ifndef EDO_PROFILER_HPP
+#define EDO_PROFILER_HPP
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "edo/base/stats.hpp"
+
+#ifdef EDO_PROFILING
+
+#define EDO_PROFILE_JOIN_(a, b) a##b
+#define EDO_PROFILE_JOIN(a, b) EDO_PROFILE_JOIN_(a, b)
+
+/// Times the rest of the enclosing scope under a given name
+#define EDO_PROFILE_SCOPE(name)\
+    static const std::size_t EDO_PROFILE_JOIN(edo_profile_id_, __LINE__) =\
+        ::edo::Profiler::instance().metric(name,\
+            ::edo::Profiler::Kind::timer);\
+    ::edo::ScopedTimer EDO_PROFILE_JOIN(edo_profile_timer_, __LINE__)(\
+        ::edo::Profiler::instance(), EDO_PROFILE_JOIN(edo_profile_id_, __LINE__))
+
+/// Adds a given amount to the counter of a given name
+#define EDO_PROFILE_COUNT(name, delta)\
+    do\
+    {\
+        static const std::size_t edo_profile_id =\
+            ::edo::Profiler::instance().metric(name,\
+                ::edo::Profiler::Kind::counter);\
+        ::edo::Profiler::instance().add(edo_profile_id, delta);\
+    } while(0)
+
+/// Records a value into the histogram of a given name
+#define EDO_PROFILE_RECORD(name, value)\
+    do\
+    {\
+        static const std::size_t edo_profile_id =\
+            ::edo::Profiler::instance().metric(name,\
+                ::edo::Profiler::Kind::histogram);\
+        ::edo::Profiler::instance().record(edo_profile_id, value);\
+    } while(0)
+
+#else
+
+#define EDO_PROFILE_SCOPE(name) static_cast<void>(0)
+#define EDO_PROFILE_COUNT(name, delta) static_cast<void>(0)
+#define EDO_PROFILE_RECORD(name, value) static_cast<void>(0)
+
+#endif
+
+namespace edo
+{
+    /// Named counters, histograms and timers for instrumenting hot paths
+    /// Every thread writes to slots of its own without locking or shared
+    /// cache lines, reads sum the slots of all threads. Timers record
+    /// their durations in nanoseconds and, while tracing, a trace event
+    /// per run for exporting to chrome://tracing or Perfetto.
+    /// The EDO_PROFILE_* macros instrument code through instance(), they
+    /// compile to nothing unless the EDO_PROFILING CMake option is set
+    class Profiler
+    {
+    public:
+        enum class Kind
+        {
+            counter,
+            histogram,
+            timer
+        };
+
+        /// Maximum amount of metrics of a profiler
+        static const std::size_t MAX_METRICS = 256;
+
+        /// Trace events kept per thread, later ones are dropped
+        static const std::size_t MAX_EVENTS = 65536;
+
+        /// Constructs a profiler without metrics, tracing is off
+        Profiler();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        ~Profiler();
+
+        /// Returns the profiler the EDO_PROFILE_* macros use
+        static Profiler& instance();
+
+        /// Registers a metric and returns its id, or returns the id of the
+        /// metric registered with that name before
+        /// @throws invalid_argument If the name has another kind
+        /// @throws runtime_error If MAX_METRICS are registered already
+        std::size_t metric(const std::string& name, const Kind kind);
+
+        /// Adds a given amount to a counter
+        void add(const std::size_t id, const uint64_t delta = 1);
+
+        /// Records a value into a histogram
+        void record(const std::size_t id, const uint64_t value);
+
+        /// Records a run of a timer between two TickScheduler::now() times
+        void time(const std::size_t id, const int64_t begin, const int64_t end);
+
+        /// Sets whether timers record trace events
+        void set_tracing(const bool enabled);
+
+        /// Returns whether timers record trace events
+        bool tracing() const;
+
+        /// Returns the sum of a counter over all threads
+        /// @throws out_of_range If no such metric exists
+        uint64_t count(const std::size_t id) const;
+
+        /// Adds the values of a histogram or timer of all threads to a
+        /// given histogram
+        /// @throws out_of_range If no such metric exists
+        void merge(const std::size_t id, Histogram& histogram) const;
+
+        /// Returns the amount of trace events dropped as threads ran out
+        /// of space
+        uint64_t dropped() const;
+
+        /// Clears every metric and trace event
+        /// Values recorded meanwhile may be lost or kept
+        void reset();
+
+        /// Returns every metric as a JSON object of counters, histograms
+        /// and timers
+        std::string json() const;
+
+        /// Returns the trace events in the Chrome trace event format
+        std::string trace() const;
+
+        /// Writes json() to a file
+        /// @throws EdoError If the file could not be written
+        void save_json(const std::string& path) const;
+
+        /// Writes trace() to a file
+        /// @throws EdoError If the file could not be written
+        void save_trace(const std::string& path) const;
+
+    private:
+        struct Metric
+        {
+            std::string name;
+            Kind kind;
+        };
+
+        struct Event
+        {
+            std::size_t id;
+            int64_t begin;
+            int64_t duration;
+        };
+
+        /// The slots of one thread, written by that thread only
+        struct ThreadSlots
+        {
+            ThreadSlots();
+            ~ThreadSlots();
+
+            std::thread::id thread;
+            std::size_t index;
+
+            std::atomic<uint64_t> counters[MAX_METRICS];
+
+            /// Allocated by the thread on its first record
+            std::atomic<Histogram*> histograms[MAX_METRICS];
+
+            /// Allocated by the thread on its first trace event
+            std::atomic<Event*> events;
+            std::atomic<std::size_t> event_count;
+            std::atomic<uint64_t> dropped_count;
+        };
+
+        /// Returns the slots of the calling thread
+        ThreadSlots& local();
+
+        /// Returns the slots of the calling thread, registering them
+        ThreadSlots& attach();
+
+        Histogram& local_histogram(const std::size_t id);
+        Kind kind(const std::size_t id) const;
+
+        /// Distinguishes profilers for the cached slots of each thread
+        uint64_t serial;
+        int64_t origin;
+        std::atomic<bool> trace_enabled;
+
+        mutable std::mutex metric_mutex;
+        std::vector<Metric> metrics;
+        std::map<std::string, std::size_t> names;
+
+        mutable std::mutex thread_mutex;
+        std::vector<std::unique_ptr<ThreadSlots>> threads;
+    };
+
+    /// Times its own lifetime into a timer of a profiler
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(Profiler& profiler, const std::size_t id);
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        /// Records the run
+        ~ScopedTimer();
+
+    private:
+        Profiler& profiler;
+        std::size_t id;
+        int64_t begin;
+    };
+}
+#endif
@@ -0,0 +1,221 @@
+#ifndef EDO_QUEUE_HPP
+#define EDO_QUEUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "edo/base/padded.hpp"
+#include "edo/base/bytebuf.hpp"
+
+namespace edo
+{
+    /// A bounded lock-free queue for any amount of producers and consumers
+    /// Every cell carries a sequence number telling whether it is free to
+    /// write or ready to read in the current lap, so push and pop are a
+    /// single compare and swap without ever blocking or allocating
+    template<typename T>
+    class BoundedQueue
+    {
+    public:
+        /// Constructs a queue holding at least capacity elements
+        /// The capacity is rounded up to a power of two
+        explicit BoundedQueue(const std::size_t capacity)
+        {
+            std::size_t size = 2;
+            while(size < capacity)
+                size *= 2;
+
+            mask = size - 1;
+            cells.reset(new Cell[size]);
+            for(std::size_t i = 0; i < size; i++)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+
+            head.value.store(0, std::memory_order_relaxed);
+            tail.value.store(0, std::memory_order_relaxed);
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /// Appends a value to the queue
+        /// @returns False if the queue is full
+        bool push(const T& value)
+        {
+            std::size_t pos = head.value.load(std::memory_order_relaxed);
+            while(true)
+            {
+                Cell& cell = cells[pos & mask];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) -
+                    static_cast<intptr_t>(pos);
+
+                if(diff == 0)
+                {
+                    if(head.value.compare_exchange_weak(pos, pos + 1,
+                        std::memory_order_relaxed))
+                    {
+                        cell.value = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if(diff < 0)
+                    return false;
+                else
+                    pos = head.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        /// Removes the oldest value from the queue
+        /// @returns False if the queue is empty
+        bool pop(T& out)
+        {
+            std::size_t pos = tail.value.load(std::memory_order_relaxed);
+            while(true)
+            {
+                Cell& cell = cells[pos & mask];
+                std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) -
+                    static_cast<intptr_t>(pos + 1);
+
+                if(diff == 0)
+                {
+                    if(tail.value.compare_exchange_weak(pos, pos + 1,
+                        std::memory_order_relaxed))
+                    {
+                        out = cell.value;
+                        cell.sequence.store(pos + mask + 1,
+                            std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if(diff < 0)
+                    return false;
+                else
+                    pos = tail.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        /// Returns the amount of elements the queue can hold
+        std::size_t capacity() const
+        {
+            return mask + 1;
+        }
+
+        /// Returns the amount of queued elements, only exact while no
+        /// other thread uses the queue
+        std::size_t size() const
+        {
+            std::size_t begin = tail.value.load(std::memory_order_relaxed);
+            std::size_t end = head.value.load(std::memory_order_relaxed);
+            return end > begin ? end - begin : 0;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask;
+
+        // Producers and consumers write to separate cache lines
+        CachePadded<std::atomic<std::size_t>> head;
+        CachePadded<std::atomic<std::size_t>> tail;
+    };
+
+    /// A bounded queue of pooled Bytebufs handing data from many producer
+    /// threads, e.g. hooked functions, to a single consumer such as the
+    /// IApplication::main() loop
+    /// Every buffer is allocated up front. Producers never block or
+    /// allocate, and a message that finds the pool exhausted is dropped
+    /// and counted instead
+    class BufferQueue
+    {
+    public:
+        /// Constructs a queue of capacity buffers, each reserving
+        /// buffer_size bytes
+        BufferQueue(const std::size_t capacity, const std::size_t buffer_size);
+
+        BufferQueue(const BufferQueue&) = delete;
+        BufferQueue& operator=(const BufferQueue&) = delete;
+
+        /// Takes an empty buffer from the pool, to be filled and passed to
+        /// publish() or release()
+        /// Writing more than buffer_size bytes to it allocates
+        /// @returns nullptr if the pool is exhausted, counting a drop
+        Bytebuf* acquire();
+
+        /// Enqueues a buffer taken from acquire() for the consumer
+        void publish(Bytebuf* buffer);
+
+        /// Returns a buffer taken from acquire() to the pool unpublished
+        void release(Bytebuf* buffer);
+
+        /// Copies a message into a pooled buffer and enqueues it
+        /// @returns False if the message was dropped because the pool is
+        /// exhausted or the message is larger than buffer_size
+        bool push(const uint8_t* data, const std::size_t length);
+
+        /// Calls handler with every queued buffer, oldest first, and
+        /// returns the buffers to the pool. Buffers are rewound before
+        /// they are handed out and must not be kept. Only one thread may
+        /// drain at a time
+        /// @param max The largest amount of buffers to drain
+        /// @returns The amount of buffers drained
+        template<typename F>
+        std::size_t drain(F handler, const std::size_t max = SIZE_MAX)
+        {
+            std::size_t count = 0;
+            uint32_t index;
+
+            while(count < max && ready.pop(index))
+            {
+                Bytebuf& buffer = pool[index];
+                buffer.rewind();
+
+                try
+                {
+                    handler(buffer);
+                }
+                catch(...)
+                {
+                    recycle(index);
+                    throw;
+                }
+
+                recycle(index);
+                count++;
+            }
+
+            return count;
+        }
+
+        /// Returns the amount of dropped messages
+        uint64_t dropped() const;
+
+        /// Returns the amount of queued buffers
+        std::size_t size() const;
+
+        /// Returns the amount of pooled buffers
+        std::size_t capacity() const;
+
+        /// Returns the amount of bytes reserved by every buffer
+        std::size_t buffer_size() const;
+
+    private:
+        /// Clears a buffer and returns it to the pool
+        void recycle(const uint32_t index);
+
+        std::vector<Bytebuf> pool;
+        std::size_t reserved;
+        BoundedQueue<uint32_t> free;
+        BoundedQueue<uint32_t> ready;
+        std::atomic<uint64_t> drop_count;
+    };
+}
+#endif
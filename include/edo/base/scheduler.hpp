@@ -0,0 +1,93 @@
+#ifndef EDO_SCHEDULER_HPP
+#define EDO_SCHEDULER_HPP
+
+#include <cstdint>
+
+namespace edo
+{
+    /// What a TickScheduler does about ticks whose deadline has passed
+    enum class OverrunPolicy
+    {
+        /// Runs the missed ticks back to back until on schedule again
+        catch_up,
+
+        /// Drops the missed ticks and continues at the next deadline
+        skip
+    };
+
+    /// Paces a loop to a fixed rate
+    /// Deadlines are computed from the start of the schedule rather than
+    /// the previous tick, so the rate does not drift with the time spent
+    /// per tick. The scheduler sleeps until an absolute deadline and can
+    /// spin through the last part of the wait for lower jitter
+    class TickScheduler
+    {
+    public:
+        /// Constructs a scheduler at a given amount of ticks per second
+        /// @throws invalid_argument If the rate is not positive
+        explicit TickScheduler(const double rate = 100.0);
+
+        /// Sets the amount of ticks per second, the schedule restarts at
+        /// the next deadline
+        /// @throws invalid_argument If the rate is not positive
+        void set_rate(const double rate);
+
+        /// Returns the amount of ticks per second
+        double rate() const;
+
+        /// Sets what happens to ticks whose deadline has passed
+        void set_overrun_policy(const OverrunPolicy policy);
+
+        /// Returns the overrun policy, catch_up by default
+        OverrunPolicy overrun_policy() const;
+
+        /// Sets how long before a deadline sleeping stops and spinning
+        /// starts, 0 by default. A few hundred microseconds keep the
+        /// jitter below the timer slack of the kernel at the cost of CPU
+        void set_spin_window(const int64_t nanoseconds);
+
+        /// Starts the schedule, the first deadline is now
+        void start();
+
+        /// Waits until the next deadline
+        /// @returns The amount of ticks skipped by this call
+        uint64_t wait();
+
+        /// Returns the deadline of the next tick in nanoseconds of the
+        /// monotonic clock
+        int64_t deadline() const;
+
+        /// Returns the amount of completed waits since start()
+        uint64_t ticks() const;
+
+        /// Returns the amount of waits which found their deadline passed
+        uint64_t overruns() const;
+
+        /// Returns the amount of ticks dropped by the skip policy
+        uint64_t skipped() const;
+
+        /// Returns the current time of the monotonic clock in nanoseconds
+        static int64_t now();
+
+    private:
+        /// Returns the deadline of tick n of the current schedule
+        int64_t deadline(const uint64_t n) const;
+
+        double tick_rate;
+
+        /// The time between ticks in nanoseconds
+        double period;
+        OverrunPolicy policy;
+        int64_t spin_window;
+
+        /// The schedule starts at origin, tick n is due at
+        /// origin + n * period
+        int64_t origin;
+        uint64_t next;
+
+        uint64_t tick_count;
+        uint64_t overrun_count;
+        uint64_t skip_count;
+    };
+}
+#endif
@@ -0,0 +1,81 @@
+#ifndef EDO_SPLIT_HPP
+#define EDO_SPLIT_HPP
+
+#include <string>
+#include <cstddef>
+#include <iterator>
+#include <boost/utility/string_view.hpp>
+
+namespace edo
+{
+    /// Splits a string at a delimiter lazily, without copying or allocating
+    /// Iterating yields views into the string, which has to outlive the
+    /// splitter and its iterators. Tokens are those of edo::split(): an
+    /// empty string is a single empty token and a trailing delimiter does
+    /// not start another one
+    class Splitter
+    {
+    public:
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef boost::string_view value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const boost::string_view* pointer;
+            typedef const boost::string_view& reference;
+
+            /// Constructs an end iterator
+            iterator();
+
+            reference operator*() const;
+            pointer operator->() const;
+
+            iterator& operator++();
+            iterator operator++(int);
+
+            bool operator==(const iterator& other) const;
+            bool operator!=(const iterator& other) const;
+
+        private:
+            friend class Splitter;
+
+            explicit iterator(const Splitter* splitter);
+
+            /// Makes the token starting at a given position the current one
+            void take(const char* position);
+
+            const Splitter* splitter;
+            boost::string_view token;
+
+            /// Start of the next token, nullptr if the current one is last
+            const char* next;
+        };
+
+        typedef iterator const_iterator;
+
+        /// Splits a string at a single character
+        Splitter(boost::string_view str, const char delim);
+
+        /// Splits a string at a sequence of characters
+        /// @throws invalid_argument If the delimiter is empty
+        Splitter(boost::string_view str, boost::string_view delim);
+
+        iterator begin() const;
+        iterator end() const;
+
+    private:
+        /// Returns the first delimiter in [position, end of the string),
+        /// nullptr if there is none
+        const char* find(const char* position) const;
+
+        boost::string_view str;
+        boost::string_view delim;
+        char single;
+    };
+
+    /// Returns a lazy split of a given string at a given delim, see Splitter
+    Splitter split_view(boost::string_view str, const char delim);
+    Splitter split_view(boost::string_view str, boost::string_view delim);
+}
+#endif
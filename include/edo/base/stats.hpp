@@ -0,0 +1,141 @@
+#ifndef EDO_STATS_HPP
+#define EDO_STATS_HPP
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace edo
+{
+    /// A histogram of unsigned values with logarithmic buckets
+    /// Every power of two is split into 16 linear buckets, so the bucket
+    /// bounds stay within 6.25% of any recorded value. Recording is a few
+    /// relaxed atomic increments, reading is safe from any thread without
+    /// locking, though a read racing a record may miss part of it
+    class Histogram
+    {
+    public:
+        /// Amount of linear buckets per power of two, as a power of two
+        static const unsigned SUB_BITS = 4;
+
+        /// Amount of buckets, enough for every 64 bit value
+        static const std::size_t BUCKETS = (64 - SUB_BITS + 1) << SUB_BITS;
+
+        /// Constructs an empty histogram
+        Histogram();
+
+        Histogram(const Histogram&) = delete;
+        Histogram& operator=(const Histogram&) = delete;
+
+        /// Records a value
+        void record(const uint64_t value);
+
+        /// Clears every bucket
+        /// Values recorded meanwhile may be lost or kept
+        void reset();
+
+        /// Adds the values of another histogram
+        void merge(const Histogram& other);
+
+        /// Returns the amount of recorded values
+        uint64_t count() const;
+
+        /// Returns the sum of the recorded values
+        uint64_t sum() const;
+
+        /// Returns the largest recorded value, 0 if there is none
+        uint64_t max() const;
+
+        /// Returns the mean of the recorded values, 0 if there are none
+        double mean() const;
+
+        /// Returns an upper bound of the value below which a given
+        /// fraction of the recorded values lie, e.g. 0.99 for the p99
+        uint64_t percentile(const double fraction) const;
+
+        /// Returns the amount of values in a bucket
+        uint64_t bucket_count(const std::size_t index) const;
+
+        /// Returns the index of the bucket a value falls into
+        static std::size_t bucket(const uint64_t value);
+
+        /// Returns the lowest value of a bucket
+        static uint64_t bucket_lower(const std::size_t index);
+
+        /// Returns the highest value of a bucket
+        static uint64_t bucket_upper(const std::size_t index);
+
+    private:
+        std::atomic<uint64_t> buckets[BUCKETS];
+        std::atomic<uint64_t> total;
+        std::atomic<uint64_t> value_sum;
+        std::atomic<uint64_t> value_max;
+    };
+
+    /// Timing statistics of the ticks of an IApplication
+    /// Written by the thread running the application, readable from any
+    /// thread without locking
+    class TickStats
+    {
+    public:
+        /// Constructs empty statistics with a late threshold of 1 ms
+        TickStats();
+
+        /// Records a tick
+        /// @param duration Nanoseconds spent in the tick
+        /// @param lateness Nanoseconds the tick started after its deadline
+        /// @param overrun Whether the deadline had already passed when the
+        /// previous tick finished
+        void record(
+            const int64_t duration,
+            const int64_t lateness,
+            const bool overrun
+        );
+
+        /// Sets how many nanoseconds after its deadline a tick which did
+        /// not overrun counts as a late wakeup
+        void set_late_threshold(const int64_t nanoseconds);
+
+        /// Returns the late wakeup threshold in nanoseconds
+        int64_t late_threshold() const;
+
+        /// Clears the statistics
+        void reset();
+
+        /// Returns the amount of recorded ticks
+        uint64_t ticks() const;
+
+        /// Returns the amount of ticks which started after their deadline
+        /// had already passed
+        uint64_t overruns() const;
+
+        /// Returns the amount of ticks which were woken up late
+        uint64_t late_wakeups() const;
+
+        /// Returns the largest lateness of a wakeup in nanoseconds
+        uint64_t max_lateness() const;
+
+        /// Returns the longest tick in nanoseconds
+        uint64_t max() const;
+
+        /// Returns an upper bound of the 99th percentile of the tick
+        /// durations in nanoseconds
+        uint64_t p99() const;
+
+        /// Returns the histogram of the tick durations in nanoseconds
+        const Histogram& durations() const;
+
+        /// Returns a human readable summary, followed by every non-empty
+        /// bucket of the duration histogram
+        std::string str() const;
+
+    private:
+        Histogram duration_histogram;
+        std::atomic<int64_t> threshold;
+        std::atomic<uint64_t> overrun_count;
+        std::atomic<uint64_t> late_count;
+        std::atomic<uint64_t> lateness_max;
+    };
+}
+#endif
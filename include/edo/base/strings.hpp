@@ -11,5 +11,41 @@ namespace edo
     #define BAD_CAST "Could not cast value to given type"
 	#define BAD_PTR "An invalid pointer was given"
 	#define MEMOP_FAILED "Could not perform operation on memory"
+    #define FILE_NOT_FOUND "The given file could not be opened"
+    #define FILE_WRITE_FAILED "Could not write to the given file"
+    #define MODULE_NOT_FOUND "The given module could not be found"
+    #define MALFORMATTED_PATTERN "The given pattern is malformatted"
+    #define MALFORMATTED_CACHE "The given signature cache is malformatted"
+    #define MALFORMATTED_MAPS_STR "The given memory maps string is malformatted"
+    #define MALFORMATTED_CHAINS "The given pointer chain set is malformatted"
+    #define TOO_MANY_CHAINS "The pointer chain set is too large to be serialized"
+    #define INVALID_SCAN_OP "The given scan operation is not valid here"
+    #define NONEXISTANT_WATCH "The given watch does not exist"
+    #define MALFORMATTED_ELF "The given file is not a supported ELF file"
+    #define UNMAPPED_ELF_ADDR "The given address is not backed by the ELF file"
+    #define MISMATCHED_OFFSETS "The given offsets do not match the given hits"
+    #define HOOK_FAILED "The given function could not be hooked"
+    #define ALREADY_HOOKED "The given function is already hooked"
+    #define NONEXISTANT_HOOK "The given hook does not exist"
+    #define ARENA_EXHAUSTED "Could not allocate a trampoline near the given address"
+    #define MALFORMATTED_CHANNEL "The given file descriptor is not a channel"
+    #define SHM_FAILED "Could not create shared memory"
+    #define INVALID_TICK_RATE "The tick rate has to be positive"
+    #define EVENT_LOOP_FAILED "Could not perform operation on the event loop"
+    #define NONEXISTANT_EVENT_SOURCE "The given event source does not exist"
+    #define INVALID_TIMER "The timer interval has to be positive"
+    #define NONEXISTANT_COROUTINE "The given coroutine does not exist"
+    #define CONFIG_WATCH_FAILED "Could not watch the given configuration file"
+    #define NONEXISTANT_SUBSCRIPTION "The given subscription does not exist"
+    #define MALFORMATTED_CONFIG_SNAPSHOT "The given configuration snapshot is malformatted"
+    #define CONFIG_SNAPSHOT_TOO_LARGE "The configuration is too large for a snapshot"
+    #define EMPTY_DELIMITER "The delimiter has to contain a character"
+    #define NONEXISTANT_METRIC "The given metric does not exist"
+    #define METRIC_KIND_MISMATCH "The given metric exists with another kind"
+    #define TOO_MANY_METRICS "The profiler cannot hold any more metrics"
+    #define INVALID_ALIGNMENT "The alignment has to be a power of two"
+    #define MALFORMATTED_BINARY_LOG "The given binary log is malformatted"
+    #define WAIT_IN_TASK "A task cannot wait for every task of its own pool"
+    #define EMPTY_PATTERN "The pattern has to contain a fixed byte"
 }
 #endif
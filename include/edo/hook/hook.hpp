@@ -0,0 +1,135 @@
+#ifndef EDO_HOOK_HPP
+#define EDO_HOOK_HPP
+
+#include <vector>
+#include <cstdint>
+
+/// The size of a trampoline slot in bytes
+#define EDO_TRAMPOLINE_SIZE 64
+
+/// The size of the memory chunks trampolines are allocated from
+#define EDO_ARENA_CHUNK_SIZE 0x10000
+
+namespace edo
+{
+    /// A pool of executable memory for hook trampolines
+    /// Slots are handed out from chunks placed within +-2GB of the
+    /// address they are requested for, so hooked code can reach them with
+    /// a 5 byte rel32 jump. Chunks are mapped read, write and execute
+    class TrampolineArena
+    {
+    public:
+        /// Default constructor, no memory is mapped until needed
+        TrampolineArena();
+
+        /// Unmaps every chunk, slots must not be in use anymore
+        ~TrampolineArena();
+
+        TrampolineArena(const TrampolineArena&) = delete;
+        TrampolineArena& operator=(const TrampolineArena&) = delete;
+
+        /// Returns a slot of EDO_TRAMPOLINE_SIZE bytes in rel32 reach of
+        /// every byte of a given address
+        /// @throws EdoError If no memory could be mapped near the address
+        uint8_t* allocate(const uintptr_t near);
+
+        /// Returns a slot to the arena
+        void release(uint8_t* slot);
+
+        /// Returns the amount of chunks mapped
+        std::size_t chunks() const;
+
+    private:
+        struct Chunk
+        {
+            uint8_t* begin;
+            std::vector<uint8_t*> free;
+        };
+
+        /// Maps a new chunk near a given address
+        Chunk& map_chunk(const uintptr_t near);
+
+        std::vector<Chunk> chunk_list;
+    };
+
+    /// Installs inline hooks on x86-64 functions of the current process
+    /// The first instructions of a target are replaced with a 5 byte jump
+    /// to the detour and relocated into a trampoline, which is called to
+    /// run the original function. Hooks are staged and applied by
+    /// commit(), which makes every touched page writable only once.
+    /// Targets should not be executed by other threads during a commit
+    class HookEngine
+    {
+    public:
+        /// Default constructor
+        HookEngine();
+
+        /// Removes every active hook
+        ~HookEngine();
+
+        HookEngine(const HookEngine&) = delete;
+        HookEngine& operator=(const HookEngine&) = delete;
+
+        /// Stages a hook redirecting a function to a detour and returns the
+        /// hook id. The trampoline is ready immediately, see original()
+        /// @throws EdoError If the start of the target cannot be relocated
+        /// or no trampoline could be allocated near it
+        /// @throws runtime_error If the target is already hooked, or the
+        /// removal of its previous hook was not committed yet
+        std::size_t hook(void* target, void* detour);
+
+        /// Stages the removal of a hook, its id is not reused
+        /// The trampoline stays valid until the engine is destroyed
+        /// @throws out_of_range If no such hook exists
+        void unhook(const std::size_t id);
+
+        /// Applies every staged hook and removal
+        /// @throws EdoError If the target pages could not be made writable
+        void commit();
+
+        /// Returns the trampoline running the original function of a hook
+        /// @throws out_of_range If no such hook exists
+        void* original(const std::size_t id) const;
+
+        /// Returns the trampoline of a hook as function pointer of type F
+        template<typename F>
+        F original(const std::size_t id) const
+        {
+            return reinterpret_cast<F>(original(id));
+        }
+
+        /// Returns whether a hook is applied to its target
+        /// @throws out_of_range If no such hook exists
+        bool active(const std::size_t id) const;
+
+        /// Returns the amount of hooks, including staged ones
+        std::size_t size() const;
+
+    private:
+        struct Hook
+        {
+            uint8_t* target;
+            uint8_t* detour;
+
+            /// The slot holding the trampoline and an absolute jump to the
+            /// detour, used if the detour is out of rel32 reach
+            uint8_t* slot;
+
+            /// The amount of bytes overwritten at the target
+            std::size_t length;
+            uint8_t original[EDO_TRAMPOLINE_SIZE / 2];
+
+            /// Whether the hook should be applied and whether it is
+            bool enabled;
+            bool applied;
+            bool removed;
+        };
+
+        /// Relocates the start of the target into the slot of a hook
+        void relocate(Hook& hook);
+
+        std::vector<Hook> hooks;
+        TrampolineArena arena;
+    };
+}
+#endif
@@ -0,0 +1,149 @@
+#ifndef EDO_CHANNEL_HPP
+#define EDO_CHANNEL_HPP
+
+#include <cstdint>
+
+#include "edo/base/bytebuf.hpp"
+
+namespace edo
+{
+    /// A single producer, single consumer channel of variable length
+    /// records between two processes
+    /// Records are written in place into a lock-free ring buffer in a
+    /// shared memfd mapping, so passing a record costs no copies through
+    /// the kernel and no system calls while both sides are busy. A side
+    /// only sleeps on a futex once the ring stays empty (or full) after a
+    /// short spin, and is woken by the other side
+    class Channel
+    {
+    public:
+        /// Creates a channel with a ring of at least capacity bytes
+        /// The capacity is rounded up to a power of two
+        /// @throws EdoError If the shared memory could not be created
+        explicit Channel(const std::size_t capacity);
+
+        /// Maps the channel behind a file descriptor received from the
+        /// process that created it, e.g. over a unix socket
+        /// The descriptor is duplicated
+        /// @throws runtime_error If the descriptor is not a channel
+        static Channel open(const int fd);
+
+        Channel(Channel&& other);
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        /// Unmaps the channel
+        ~Channel();
+
+        /// Returns the memfd of the channel, to be passed to the other
+        /// process
+        int fd() const;
+
+        /// Returns the capacity of the ring in bytes
+        std::size_t capacity() const;
+
+        /// Returns the largest record length the channel accepts
+        std::size_t max_record() const;
+
+        /// Reserves space for a record of given length to be written in
+        /// place, the record is sent by commit()
+        /// @returns nullptr if the ring is full
+        /// @throws out_of_range If length exceeds max_record()
+        uint8_t* reserve(const std::size_t length);
+
+        /// Sends the record reserved last
+        void commit();
+
+        /// Copies a record into the ring without waiting
+        /// @returns False if the ring is full
+        /// @throws out_of_range If length exceeds max_record()
+        bool try_send(const uint8_t* data, const std::size_t length);
+
+        /// Copies a record into the ring, waiting while it is full
+        /// @param timeout_ms The longest time to wait, -1 waits forever
+        /// @returns False if the ring stayed full
+        /// @throws out_of_range If length exceeds max_record()
+        bool send(
+            const uint8_t* data,
+            const std::size_t length,
+            const int timeout_ms = -1
+        );
+
+        /// Sends the contents of a Bytebuf
+        bool send(Bytebuf& buf, const int timeout_ms = -1);
+
+        /// Waits until a record can be read
+        /// @param timeout_ms The longest time to wait, -1 waits forever
+        /// @returns Whether a record can be read
+        bool wait(const int timeout_ms = -1);
+
+        /// Calls handler(const uint8_t* data, std::size_t length) with
+        /// every readable record, in place, then frees their space
+        /// @param max The largest amount of records to read
+        /// @returns The amount of records read
+        /// @throws runtime_error If the other side wrote a malformatted
+        /// record
+        template<typename F>
+        std::size_t drain(F handler, const std::size_t max = SIZE_MAX)
+        {
+            std::size_t count = 0;
+            const uint8_t* data;
+            std::size_t length;
+
+            while(count < max && peek(data, length))
+            {
+                handler(data, length);
+                pop();
+                count++;
+            }
+
+            if(count != 0)
+                notify();
+
+            return count;
+        }
+
+        /// Receives one record into a Bytebuf, replacing its contents
+        /// @param timeout_ms The longest time to wait, -1 waits forever
+        /// @returns False if no record arrived in time
+        /// @throws runtime_error If the other side wrote a malformatted
+        /// record
+        bool receive(Bytebuf& out, const int timeout_ms = -1);
+
+    private:
+        struct Shared;
+
+        Channel();
+
+        /// Returns the next readable record without freeing it
+        /// @throws runtime_error If the record is malformatted
+        bool peek(const uint8_t*& data, std::size_t& length);
+
+        /// Frees the record returned by peek()
+        void pop();
+
+        /// Wakes the producer if it waits for space
+        void notify();
+
+        /// Returns the space a record of given length takes up at the
+        /// current head, including padding
+        std::size_t required(const std::size_t length);
+
+        int memfd;
+        Shared* shared;
+        uint8_t* ring;
+        std::size_t mask;
+
+        /// Length of the mapping at shared, unmapped on destruction
+        std::size_t mapped_size;
+
+        /// Positions cached by the producer and the consumer, so the
+        /// other side's cache line is only read when needed
+        uint64_t cached_head;
+        uint64_t cached_tail;
+
+        /// The head after the reserved record, including padding
+        uint64_t reserved_head;
+    };
+}
+#endif
@@ -0,0 +1,55 @@
+#ifndef EDO_DIRTY_HPP
+#define EDO_DIRTY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace edo
+{
+    /// Tracks which pages of a process were written to through the
+    /// soft-dirty bits of the Linux kernel
+    /// Clearing is done for the whole process, so a process should only
+    /// be tracked by one tracker at a time
+    class DirtyTracker
+    {
+    public:
+        /// Constructs a tracker for the current process
+        DirtyTracker();
+
+        /// Constructs a tracker for a given process
+        DirtyTracker(const pid_t pid);
+
+        virtual ~DirtyTracker();
+
+        /// Returns whether the kernel reports soft-dirty bits
+        /// This is probed once within the current process, without
+        /// clearing its bits
+        static bool supported();
+
+        /// Returns the size of the pages tracked
+        static std::size_t page_size();
+
+        /// Returns the id of the tracked process
+        pid_t pid() const;
+
+        /// Clears the soft-dirty bit of every page of the process
+        /// @returns Whether the bits could be cleared
+        virtual bool clear();
+
+        /// Reads whether pages were written to since the last clear
+        /// @param begin The address of the first page
+        /// @param pages The amount of pages to read
+        /// @param out Set to one flag per page, non-zero if written to
+        /// @returns Whether the bits could be read
+        virtual bool dirty(
+            const uintptr_t begin,
+            const std::size_t pages,
+            std::vector<uint8_t>& out
+        );
+
+    private:
+        pid_t process_id;
+    };
+}
+#endif
@@ -0,0 +1,105 @@
+#ifndef EDO_ELF_HPP
+#define EDO_ELF_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace edo
+{
+    /// A section of an ELF file
+    struct ElfSection
+    {
+        std::string name;
+
+        /// Section type (SHT_PROGBITS, SHT_NOBITS, ...)
+        uint32_t type;
+
+        /// Section flags (SHF_ALLOC, SHF_EXECINSTR, ...)
+        uint64_t flags;
+
+        /// The virtual address of the section, 0 if it is not loaded
+        uint64_t address;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    /// A program header of an ELF file
+    struct ElfSegment
+    {
+        /// Segment type (PT_LOAD, PT_NOTE, ...)
+        uint32_t type;
+
+        /// Segment flags (PF_R, PF_W, PF_X)
+        uint32_t flags;
+
+        uint64_t address;
+        uint64_t offset;
+        uint64_t file_size;
+        uint64_t memory_size;
+    };
+
+    /// An ELF executable or shared object on disk, mapped read only
+    /// Used to work with binaries without loading them, e.g. to scan for
+    /// signatures before the target process runs. Only ELF files of the
+    /// native class and byte order are supported
+    class ElfFile
+    {
+    public:
+        /// Maps the ELF file at a given path
+        /// @throws NotFoundError If the file could not be opened
+        /// @throws runtime_error If the file is not a supported ELF file
+        ElfFile(const std::string& path);
+
+        /// Unmaps the file
+        ~ElfFile();
+
+        ElfFile(const ElfFile&) = delete;
+        ElfFile& operator=(const ElfFile&) = delete;
+
+        /// Returns the path of the file
+        const std::string& path() const;
+
+        /// Returns the mapped contents of the file
+        const uint8_t* data() const;
+
+        /// Returns the size of the file in bytes
+        std::size_t size() const;
+
+        /// Returns the sections of the file, in header order
+        const std::vector<ElfSection>& sections() const;
+
+        /// Returns the program headers of the file, in header order
+        const std::vector<ElfSegment>& segments() const;
+
+        /// Returns the section with a given name, or nullptr if there is
+        /// no such section
+        const ElfSection* section(const std::string& name) const;
+
+        /// Returns the GNU build-id of the file, or an empty vector if the
+        /// file has none
+        const std::vector<uint8_t>& build_id() const;
+
+        /// Returns the same id as Module::id() does for the loaded file
+        std::string id() const;
+
+        /// Converts a file offset to the virtual address it is loaded at
+        /// @throws out_of_range If the offset is not part of a PT_LOAD segment
+        uint64_t address(const uint64_t offset) const;
+
+        /// Converts a virtual address to the file offset it is loaded from
+        /// @throws out_of_range If the address is not backed by the file
+        uint64_t offset(const uint64_t address) const;
+
+    private:
+        void parse();
+
+        std::string file_path;
+        uint8_t* file_data;
+        std::size_t file_size;
+        std::vector<ElfSection> file_sections;
+        std::vector<ElfSegment> file_segments;
+        std::vector<uint8_t> file_build_id;
+    };
+}
+#endif
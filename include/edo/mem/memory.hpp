@@ -0,0 +1,70 @@
+#ifndef EDO_MEMORY_HPP
+#define EDO_MEMORY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace edo
+{
+    /// A single read of a batch
+    struct ReadOp
+    {
+        uintptr_t address;
+        void* out;
+        std::size_t length;
+
+        /// Set by Memory::read_batch() to whether the read succeeded
+        bool ok;
+    };
+
+    /// Reads and writes the memory of a process without risk of faulting
+    /// Accesses go through process_vm_readv and process_vm_writev, so an
+    /// invalid address is reported as a failed access instead of crashing,
+    /// and many reads can be issued with a single system call
+    class Memory
+    {
+    public:
+        /// Constructs for the current process
+        Memory();
+
+        /// Constructs for a given process
+        Memory(const pid_t pid);
+
+        /// Returns the id of the process
+        pid_t pid() const;
+
+        /// Reads length bytes at a given address into out
+        /// @returns Whether the whole range could be read
+        bool read(
+            const uintptr_t address,
+            void* out,
+            const std::size_t length
+        ) const;
+
+        /// Reads an object of type T at a given address
+        /// @returns Whether the object could be read
+        template<typename T>
+        bool read(const uintptr_t address, T& out) const
+        {
+            return read(address, &out, sizeof(T));
+        }
+
+        /// Performs a batch of reads with as few system calls as possible
+        /// The ok flag of every operation is set to whether it succeeded
+        /// @returns The amount of successful reads
+        std::size_t read_batch(std::vector<ReadOp>& ops) const;
+
+        /// Writes length bytes from data to a given address
+        /// @returns Whether the whole range could be written
+        bool write(
+            const uintptr_t address,
+            const void* data,
+            const std::size_t length
+        ) const;
+
+    private:
+        pid_t process_id;
+    };
+}
+#endif
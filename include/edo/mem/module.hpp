@@ -0,0 +1,85 @@
+#ifndef EDO_MODULE_HPP
+#define EDO_MODULE_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace edo
+{
+    /// A loaded segment of a module
+    struct Segment
+    {
+        uintptr_t begin;
+        uintptr_t end;
+
+        /// ELF segment flags (PF_R, PF_W, PF_X)
+        uint32_t flags;
+    };
+
+    /// An executable or shared object loaded into the current process
+    class Module
+    {
+    public:
+        /// Finds a loaded module by file name or full path
+        /// An empty name finds the main executable
+        /// @throws NotFoundError If no such module is loaded
+        static Module find(const std::string& name);
+
+        /// Returns every module loaded into the current process
+        static std::vector<Module> list();
+
+        /// Returns the path of the module file
+        const std::string& path() const;
+
+        /// Returns the load bias of the module
+        /// Adding a virtual address of the module file to the base gives
+        /// its address in memory
+        uintptr_t base() const;
+
+        /// Returns the loaded segments of the module
+        const std::vector<Segment>& segments() const;
+
+        /// Returns the GNU build-id of the module, or an empty vector if
+        /// the module has none
+        const std::vector<uint8_t>& build_id() const;
+
+        /// Returns a string uniquely identifying the build of the module
+        /// This is the hex encoded build-id if there is one, otherwise the
+        /// module file is read and hashed. The hash is cached until the
+        /// modification time or size of the file changes
+        std::string id() const;
+
+        /// Returns whether a given range lies within a readable segment
+        bool contains(const uintptr_t address, const std::size_t length) const;
+
+    private:
+        Module();
+
+        friend struct ModuleBuilder;
+
+        std::string module_path;
+        uintptr_t module_base;
+        std::vector<Segment> module_segments;
+        std::vector<uint8_t> module_build_id;
+    };
+
+    /// Returns the GNU build-id in an array of ELF notes, or an empty
+    /// vector if there is none
+    /// @param align The alignment of the notes, 4 or 8
+    std::vector<uint8_t> read_build_id(
+        const uint8_t* notes,
+        const std::size_t length,
+        const std::size_t align
+    );
+
+    /// Returns the string identifying a module build, see Module::id()
+    /// @param data The contents of the module file, only hashed if the
+    /// build-id is empty
+    std::string module_id(
+        const std::vector<uint8_t>& build_id,
+        const uint8_t* data,
+        const std::size_t length
+    );
+}
+#endif
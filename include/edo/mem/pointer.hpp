@@ -0,0 +1,118 @@
+#ifndef EDO_POINTER_HPP
+#define EDO_POINTER_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "edo/mem/memory.hpp"
+#include "edo/mem/region.hpp"
+
+namespace edo
+{
+    /// A chain of offsets followed from a base address, as done by
+    /// edo::follow. Resolving reads a pointer at (address + offset) for
+    /// every offset in order, starting at the base address
+    class PointerPath
+    {
+    public:
+        /// Default constructor, constructs an empty path at address 0
+        PointerPath();
+
+        /// Constructs a path from a base address and a list of offsets
+        PointerPath(const uintptr_t base, const std::vector<intptr_t>& offsets);
+
+        /// Returns the base address of the path
+        uintptr_t base() const;
+
+        /// Returns the offsets of the path
+        const std::vector<intptr_t>& offsets() const;
+
+        /// Returns the amount of pointers read when resolving the path
+        std::size_t depth() const;
+
+        /// Resolves the path, reading every hop through given memory
+        /// @param result Set to the resolved address on success
+        /// @returns Whether every hop could be read
+        bool resolve(const Memory& memory, uintptr_t& result) const;
+
+    private:
+        uintptr_t path_base;
+        std::vector<intptr_t> path_offsets;
+    };
+
+    /// Resolves many pointer paths at once with one batched read per depth
+    /// level. Resolved chains are memoized: later resolves reread every hop
+    /// from its memoized parent in a single batch, and only walk the chain
+    /// level by level again if an intermediate pointer changed, a read failed
+    /// or the refresh interval has passed
+    class PointerResolver
+    {
+    public:
+        /// Constructs a resolver for the current process
+        PointerResolver();
+
+        /// Constructs a resolver reading through given memory
+        PointerResolver(const Memory& memory);
+
+        /// Adds a path to resolve and returns its index
+        std::size_t add(const PointerPath& path);
+
+        /// Returns the path at given index
+        const PointerPath& path(const std::size_t index) const;
+
+        /// Returns the amount of paths
+        std::size_t size() const;
+
+        /// Removes every path
+        void clear();
+
+        /// Sets the amount of resolves after which every chain is reread
+        /// in full, 0 disables memoization
+        void set_refresh_interval(const std::size_t interval);
+
+        /// Sets a region table every hop is validated against before it is
+        /// read, saving a failed read on pointers into unmapped memory
+        /// The table must outlive the resolver, nullptr disables validation
+        void set_regions(const RegionTable* regions);
+
+        /// Discards every memoized chain
+        void invalidate();
+
+        /// Resolves every path
+        /// @returns The amount of paths which could be resolved
+        std::size_t resolve();
+
+        /// Returns whether the path at given index was resolved by the
+        /// last call to resolve()
+        bool valid(const std::size_t index) const;
+
+        /// Returns the address the path at given index resolved to
+        uintptr_t address(const std::size_t index) const;
+
+    private:
+        struct Entry
+        {
+            PointerPath path;
+
+            /// The pointer read at every hop
+            std::vector<uintptr_t> chain;
+            bool memoized;
+            bool valid;
+
+            /// Targets of the reads of the memoized fast path
+            std::vector<uintptr_t> reread;
+        };
+
+        bool readable(const uintptr_t address) const;
+        std::size_t resolve_memoized(std::vector<std::size_t>& stale);
+        void resolve_full(std::vector<std::size_t>& stale);
+
+        Memory memory;
+        const RegionTable* region_table;
+        std::vector<Entry> entries;
+        std::vector<ReadOp> ops;
+        std::size_t refresh_interval;
+        std::size_t resolves;
+    };
+}
+#endif
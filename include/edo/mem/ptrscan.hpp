@@ -0,0 +1,160 @@
+#ifndef EDO_PTRSCAN_HPP
+#define EDO_PTRSCAN_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "edo/base/bytebuf.hpp"
+#include "edo/mem/memory.hpp"
+#include "edo/mem/region.hpp"
+#include "edo/mem/pointer.hpp"
+
+namespace edo
+{
+    /// A pointer found in memory
+    struct PointerEntry
+    {
+        /// The pointer value
+        uintptr_t value;
+
+        /// The address the pointer is stored at
+        uintptr_t address;
+    };
+
+    /// A chain of pointers from a static address in a module to a target
+    /// Every offset but the last is dereferenced as done by edo::follow,
+    /// starting at the base of the module, and the last offset is added to
+    /// the result. The base of a module is the start of its first mapping
+    /// Modules are told apart by file name only, so that chains stay valid
+    /// when a module is loaded from elsewhere. Files sharing their name
+    /// with another mapped file are ambiguous, chains neither start in nor
+    /// resolve against them
+    struct PointerChain
+    {
+        /// File name of the module the chain starts in
+        std::string module;
+        std::vector<intptr_t> offsets;
+
+        /// Returns the dereferenced part of the chain as a path starting at
+        /// a given module base
+        PointerPath path(const uintptr_t module_base) const;
+
+        /// Returns the offset added to the resolved path
+        intptr_t last_offset() const;
+    };
+
+    /// Finds pointer chains leading to a target address
+    /// The scanner first builds a sorted map of every aligned pointer in
+    /// writable memory which points into writable memory, then searches it
+    /// backwards from the target. Both steps are spread over several threads
+    /// Chains start in writable mappings of files or in the anonymous
+    /// mapping directly following one, which holds the rest of its .bss
+    class PointerScanner
+    {
+    public:
+        /// Constructs a scanner for the current process
+        PointerScanner();
+
+        /// Constructs a scanner reading through given memory
+        PointerScanner(const Memory& memory);
+
+        /// Sets the maximum amount of pointers dereferenced by a chain
+        void set_max_depth(const std::size_t depth);
+
+        /// Sets the maximum offset between a pointer and the address
+        /// the chain continues at
+        void set_max_offset(const std::size_t offset);
+
+        /// Sets the alignment of pointers to look for
+        void set_alignment(const std::size_t alignment);
+
+        /// Sets the amount of threads to use, 0 uses one per core
+        void set_threads(const unsigned threads);
+
+        /// Sets the maximum amount of chains returned by scan(), 0 for
+        /// no limit
+        void set_max_results(const std::size_t results);
+
+        /// Builds the pointer map from the current memory of the process
+        void build(const RegionTable& regions);
+
+        /// Returns the pointer map sorted by value
+        const std::vector<PointerEntry>& entries() const;
+
+        /// Returns every chain leading to a given target
+        /// The pointer map must have been built
+        std::vector<PointerChain> scan(const uintptr_t target) const;
+
+    private:
+        struct Search;
+
+        unsigned thread_count() const;
+
+        Memory memory;
+        std::size_t max_depth;
+        std::size_t max_offset;
+        std::size_t alignment;
+        unsigned threads;
+        std::size_t max_results;
+
+        std::vector<PointerEntry> pointer_map;
+        std::vector<Region> static_regions;
+        std::map<std::string, uintptr_t> module_bases;
+    };
+
+    /// A set of pointer chains which can be stored on disk and narrowed
+    /// down by checking them against later snapshots of the process
+    class PointerChainSet
+    {
+    public:
+        /// Default constructor
+        PointerChainSet();
+
+        /// Constructs a set from a list of chains
+        PointerChainSet(const std::vector<PointerChain>& chains);
+
+        /// Returns the chains of the set
+        const std::vector<PointerChain>& chains() const;
+
+        /// Returns the amount of chains in the set
+        std::size_t size() const;
+
+        /// Serializes the set into binary format
+        /// @throws length_error If the set or a chain is too large
+        Bytebuf serialize() const;
+
+        /// Replaces the chains of the set with a serialized set
+        /// @throws out_of_range If the buffer is truncated
+        /// @throws runtime_error If the buffer is not a serialized set
+        void parse(Bytebuf& buf);
+
+        /// Saves the set to a file
+        /// @throws EdoError If the file could not be written
+        void save(const std::string& path) const;
+
+        /// Loads the set from a file
+        /// @throws NotFoundError If the file could not be read
+        /// @throws runtime_error If the file is not a serialized set
+        void load(const std::string& path);
+
+        /// Removes every chain not resolving to a given target
+        /// Chains are resolved together with one batched read per level
+        /// @returns The amount of chains left
+        std::size_t filter(
+            const Memory& memory,
+            const RegionTable& regions,
+            const uintptr_t target
+        );
+
+    private:
+        std::vector<PointerChain> chain_list;
+    };
+
+    /// Returns the base of every file mapped into a process by file name
+    /// The anonymous mapping holding the rest of the .bss of a file counts
+    /// as part of that file. Names of several mapped files are left out
+    std::map<std::string, uintptr_t> module_bases(const RegionTable& regions);
+}
+#endif
@@ -0,0 +1,68 @@
+#ifndef EDO_REGION_HPP
+#define EDO_REGION_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace edo
+{
+    /// A mapped region of process memory
+    struct Region
+    {
+        uintptr_t begin;
+        uintptr_t end;
+        bool readable;
+        bool writable;
+        bool executable;
+        bool shared;
+
+        /// Offset of the region into the mapped file
+        uint64_t offset;
+
+        /// The mapped file or pseudo path such as [heap], empty if anonymous
+        std::string path;
+
+        /// Returns the size of the region in bytes
+        std::size_t size() const;
+    };
+
+    /// The table of mapped memory regions of a process, sorted by address
+    class RegionTable
+    {
+    public:
+        /// Default constructor, constructs an empty table
+        RegionTable();
+
+        /// Loads the regions of the current process
+        /// @throws NotFoundError If the maps file could not be read
+        static RegionTable load();
+
+        /// Loads the regions of a given process
+        /// @throws NotFoundError If the maps file could not be read
+        static RegionTable load(const pid_t pid);
+
+        /// Parses the contents of a /proc/{pid}/maps file and replaces the
+        /// regions of the table
+        /// @throws runtime_error If malformatted maps string is given
+        void parse(const std::string& maps_str);
+
+        /// Returns the regions of the table
+        const std::vector<Region>& regions() const;
+
+        /// Returns the amount of regions in the table
+        std::size_t size() const;
+
+        /// Returns the region containing a given address, or nullptr
+        const Region* find(const uintptr_t address) const;
+
+        /// Returns whether a given range is readable
+        /// The range may span several adjacent regions
+        bool readable(const uintptr_t address, const std::size_t length) const;
+
+    private:
+        std::vector<Region> region_list;
+    };
+}
+#endif
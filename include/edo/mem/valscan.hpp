@@ -0,0 +1,176 @@
+#ifndef EDO_VALSCAN_HPP
+#define EDO_VALSCAN_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "edo/mem/dirty.hpp"
+#include "edo/mem/memory.hpp"
+#include "edo/mem/region.hpp"
+
+namespace edo
+{
+    /// A comparison performed by a value scan
+    enum class ScanOp
+    {
+        /// Equal to a given value
+        exact,
+        /// Within a given inclusive range
+        range,
+        /// Any value, only valid for first scans
+        unknown,
+        /// Different from the previous scan
+        changed,
+        /// Equal to the previous scan
+        unchanged,
+        /// Greater than in the previous scan
+        increased,
+        /// Less than in the previous scan
+        decreased,
+    };
+
+    /// Scans the writable memory of a process for values of a given type
+    /// A first scan finds every candidate address, and next scans narrow
+    /// the candidates down by comparing against the given values or the
+    /// values seen in the previous scan.
+    ///
+    /// Memory is processed in pages. Pages are compared with SIMD and only
+    /// pages containing a match are examined further. Candidates of a page
+    /// are stored as a bitmap or a delta encoded offset list, whichever is
+    /// smallest, together with their previous values, and pages without
+    /// candidates are dropped entirely. An unknown initial value scan has
+    /// to keep a copy of every page, except for pages filled with zeros.
+    ///
+    /// With a dirty tracker set, scans clear the soft-dirty bits of the
+    /// process and next scans only reread pages written to since the last
+    /// scan. Clean pages are compared against their stored values instead.
+    /// Writes landing between reading and clearing the bits of a page go
+    /// unnoticed until the page is written to again.
+    ///
+    /// Supported types are the fixed width integer types, float and double
+    class ValueScanner
+    {
+    public:
+        /// Constructs a scanner for the current process
+        ValueScanner();
+
+        /// Constructs a scanner reading through given memory
+        ValueScanner(const Memory& memory);
+
+        /// Sets the alignment of the addresses to scan, 0 aligns them to
+        /// the size of the scanned type
+        void set_alignment(const std::size_t alignment);
+
+        /// Sets the tracker used to skip rereading pages which were not
+        /// written to. If the tracker fails, every page is reread
+        /// The tracker must outlive the scanner, nullptr disables tracking
+        void set_dirty_tracker(DirtyTracker* tracker);
+
+        /// Scans every readable and writable region for values of type T
+        /// Discards the candidates of earlier scans
+        /// @param a The value of an exact scan, or lower bound of a range
+        /// @param b The upper bound of a range scan
+        /// @throws invalid_argument If op is not exact, range or unknown
+        /// @returns The amount of candidates found
+        template<typename T>
+        std::size_t first_scan(
+            const RegionTable& regions,
+            const ScanOp op,
+            const T a = T(),
+            const T b = T()
+        );
+
+        /// Narrows the candidates of the previous scan
+        /// @param a The value of an exact scan, or lower bound of a range
+        /// @param b The upper bound of a range scan
+        /// @throws invalid_argument If op is unknown, or T is not the type
+        /// of the first scan
+        /// @returns The amount of candidates left
+        template<typename T>
+        std::size_t next_scan(const ScanOp op, const T a = T(), const T b = T());
+
+        /// Returns the amount of candidates
+        std::size_t count() const;
+
+        /// Returns the addresses of the candidates in ascending order
+        /// @param max The maximum amount of addresses to return, 0 for all
+        std::vector<uintptr_t> addresses(const std::size_t max = 0) const;
+
+        /// Returns the amount of bytes used to store the candidates
+        std::size_t memory_usage() const;
+
+        /// Discards every candidate
+        void reset();
+
+    private:
+        /// A page of scanned memory with candidates
+        struct Block
+        {
+            uintptr_t address;
+
+            /// Length of the page, and the amount of readable bytes
+            /// following it that values at its end may extend into
+            uint16_t length;
+            uint8_t tail;
+
+            /// How the candidate offsets are stored
+            uint8_t encoding;
+            uint32_t count;
+            std::vector<uint8_t> candidates;
+
+            /// A copy of the page if every offset is a candidate, empty if
+            /// that copy would only contain zeros. Otherwise the values of
+            /// the candidates in order
+            std::vector<uint8_t> values;
+        };
+
+        /// Returns the amount of offsets in a block which can hold a value
+        std::size_t slots(const Block& block) const;
+
+        /// Stores given offsets and the values at them as the candidates
+        /// of a block
+        void encode(
+            Block& block,
+            const std::vector<uint16_t>& offsets,
+            const uint8_t* data
+        ) const;
+
+        /// Returns the candidate offsets of a block
+        void decode(const Block& block, std::vector<uint16_t>& offsets) const;
+
+        /// Sets a flag for every block, non-zero if the block has to be
+        /// reread
+        void find_dirty(std::vector<uint8_t>& dirty);
+
+        template<typename T>
+        void scan_block(
+            Block& block,
+            const uint8_t* data,
+            const ScanOp op,
+            const T a,
+            const T b
+        );
+
+        /// Scans a block not written to since the last scan
+        /// @param page Buffer to rebuild the page from stored values in
+        template<typename T>
+        void scan_clean_block(
+            Block& block,
+            uint8_t* page,
+            const ScanOp op,
+            const T a,
+            const T b
+        );
+
+        Memory memory;
+        DirtyTracker* tracker;
+        bool tracking;
+        std::vector<Block> blocks;
+        std::size_t alignment;
+        std::size_t stride;
+        std::size_t type_size;
+        int type_id;
+        std::vector<uint16_t> scratch;
+    };
+}
+#endif
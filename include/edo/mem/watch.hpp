@@ -0,0 +1,190 @@
+#ifndef EDO_WATCH_HPP
+#define EDO_WATCH_HPP
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+
+#include "edo/mem/memory.hpp"
+#include "edo/mem/pointer.hpp"
+
+namespace edo
+{
+    /// Polls many values in memory with a single batched read per poll
+    /// Watches on nearby addresses are coalesced into contiguous spans, so
+    /// neighbouring fields of a structure cost a single read element.
+    /// A watch notifies when its value is first read and then only when it
+    /// differs from the previous poll
+    class WatchList
+    {
+    public:
+        /// Called with the current and the previous value of a watch
+        typedef std::function<void(const uint8_t*, const uint8_t*)> Callback;
+
+        /// Constructs a watch list for the current process
+        WatchList();
+
+        /// Constructs a watch list reading through given memory
+        WatchList(const Memory& memory);
+
+        /// Watches a value at a fixed address and returns the watch id
+        std::size_t watch(
+            const uintptr_t address,
+            const std::size_t length,
+            const Callback& callback
+        );
+
+        /// Watches a value at an offset from the address a pointer path
+        /// resolves to and returns the watch id
+        /// The path is resolved every poll
+        std::size_t watch(
+            const PointerPath& path,
+            const intptr_t offset,
+            const std::size_t length,
+            const Callback& callback
+        );
+
+        /// Watches a value of type T at a fixed address
+        template<typename T>
+        std::size_t watch(
+            const uintptr_t address,
+            const std::function<void(const T&, const T&)>& callback
+        )
+        {
+            return watch(address, sizeof(T), typed(callback));
+        }
+
+        /// Watches a value of type T at an offset from a pointer path
+        template<typename T>
+        std::size_t watch(
+            const PointerPath& path,
+            const intptr_t offset,
+            const std::function<void(const T&, const T&)>& callback
+        )
+        {
+            return watch(path, offset, sizeof(T), typed(callback));
+        }
+
+        /// Stops a watch
+        /// Its slot is reused by later watches, but its id never names
+        /// another watch. The pointer path of a watch is no longer resolved
+        /// from the next poll on
+        /// @throws out_of_range If no such watch exists
+        void unwatch(const std::size_t id);
+
+        /// Sets the largest gap between two watches read as one span
+        void set_max_gap(const std::size_t gap);
+
+        /// Reads every watch and notifies the ones that changed
+        /// @returns The amount of watches which changed
+        std::size_t poll();
+
+        /// Returns the value of a watch as of the last poll
+        /// @returns Whether the value could be read by the last poll
+        /// @throws out_of_range If no such watch exists
+        template<typename T>
+        bool get(const std::size_t id, T& out) const
+        {
+            const uint8_t* value = get(id);
+            if(value == nullptr)
+                return false;
+
+            std::memcpy(&out, value, sizeof(T));
+            return true;
+        }
+
+        /// Returns the value of a watch as of the last poll, or nullptr if
+        /// it could not be read
+        /// @throws out_of_range If no such watch exists
+        const uint8_t* get(const std::size_t id) const;
+
+        /// Returns the amount of active watches
+        std::size_t size() const;
+
+        /// Returns the amount of spans read by the last poll
+        std::size_t spans() const;
+
+    private:
+        struct Watch
+        {
+            bool active;
+            bool valid;
+
+            /// Index of the pointer path in the resolver, or -1
+            std::size_t path;
+            intptr_t offset;
+            uintptr_t address;
+            std::size_t length;
+
+            /// Offset of the last read value in the value buffer
+            std::size_t value_offset;
+
+            /// Offset of the current value in the span buffer
+            std::size_t span_offset;
+            Callback callback;
+
+            /// Counts the watches the slot held, part of their ids
+            uint32_t generation;
+        };
+
+        /// A part of the value buffer no watch uses
+        struct Range
+        {
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        struct Span
+        {
+            uintptr_t address;
+            std::size_t length;
+            std::size_t buffer_offset;
+            std::vector<std::size_t> watches;
+        };
+
+        template<typename T>
+        static Callback typed(const std::function<void(const T&, const T&)>& f)
+        {
+            return [f](const uint8_t* value, const uint8_t* previous)
+            {
+                T v;
+                T p;
+                std::memcpy(&v, value, sizeof(T));
+                std::memcpy(&p, previous, sizeof(T));
+                f(v, p);
+            };
+        }
+
+        std::size_t add(Watch& watch);
+        void layout();
+
+        /// Returns the slot of a watch
+        /// @throws out_of_range If no such watch exists
+        std::size_t slot(const std::size_t id) const;
+
+        /// Returns the id of the watch in a slot
+        std::size_t id_of(const std::size_t index) const;
+
+        /// Returns the offset of a free part of the value buffer
+        std::size_t allocate(const std::size_t length);
+
+        /// Rebuilds the resolver from the paths of the active watches
+        void compact_paths();
+
+        Memory memory;
+        PointerResolver resolver;
+        std::vector<Watch> watch_list;
+        std::vector<std::size_t> free_slots;
+        std::vector<Range> free_values;
+        std::vector<Span> span_list;
+        std::vector<uint8_t> values;
+        std::vector<uint8_t> buffer;
+        std::vector<ReadOp> ops;
+        std::size_t max_gap;
+        std::size_t active;
+        bool dirty_layout;
+        bool dirty_paths;
+    };
+}
+#endif
@@ -0,0 +1,78 @@
+#ifndef EDO_PATTERN_HPP
+#define EDO_PATTERN_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace edo
+{
+    /// Returns a rough estimate of how common a byte is in x86-64 code and
+    /// data, higher meaning more common
+    /// Used to pick the rarest byte of a pattern as the scan anchor
+    constexpr int byte_frequency(const uint8_t byte)
+    {
+        return (byte == 0x00 || byte == 0xFF) ? 8 :
+            (byte == 0x48 || byte == 0x8B || byte == 0xCC) ? 6 :
+            (byte == 0x89 || byte == 0x0F || byte == 0x24 || byte == 0x44 ||
+                byte == 0x4C || byte == 0xE8 || byte == 0x8D || byte == 0x41 ||
+                byte == 0x90) ? 4 :
+            (byte == 0x01 || byte == 0x83 || byte == 0x84 || byte == 0x85 ||
+                byte == 0xC0 || byte == 0x74 || byte == 0x75 || byte == 0x45 ||
+                byte == 0x49 || byte == 0x08 || byte == 0x10 || byte == 0x20) ? 2 :
+            0;
+    }
+
+    /// A byte signature which may contain wildcards
+    /// In string format, bytes are written as pairs of hex digits separated
+    /// by whitespace and wildcards as ? or ??, e.g:
+    /// 48 8B ?? ?? E8
+    class Pattern
+    {
+    public:
+        /// Default constructor, constructs an empty pattern
+        Pattern();
+
+        /// Parses a pattern string
+        /// @throws runtime_error If malformatted pattern string is given
+        Pattern(const std::string& pattern_str);
+
+        /// Constructs a pattern from its bytes and mask, see mask()
+        /// @throws runtime_error If the sizes differ or no byte is fixed
+        Pattern(const std::vector<uint8_t>& bytes, const std::vector<uint8_t>& mask);
+
+        /// Returns the length of the pattern in bytes
+        std::size_t size() const;
+
+        /// Returns the bytes of the pattern, wildcards are stored as 0
+        const std::vector<uint8_t>& bytes() const;
+
+        /// Returns the mask of the pattern, 0xFF for bytes that must match
+        /// and 0 for wildcards
+        const std::vector<uint8_t>& mask() const;
+
+        /// Returns the index of the byte used as scan anchor
+        /// This is the least common non-wildcard byte of the pattern
+        std::size_t anchor() const;
+
+        /// Returns whether the pattern matches the memory at given address
+        /// At least size() bytes must be readable from data
+        bool matches(const uint8_t* data) const;
+
+        /// Returns a hash identifying the bytes and mask of the pattern
+        uint64_t hash() const;
+
+        /// Serializes the pattern into string format (see classwide comment)
+        std::string str() const;
+
+    private:
+        /// Chooses the anchor byte
+        /// @throws runtime_error If no byte is fixed
+        void choose_anchor();
+
+        std::vector<uint8_t> pattern_bytes;
+        std::vector<uint8_t> pattern_mask;
+        std::size_t anchor_index;
+    };
+}
+#endif
@@ -0,0 +1,89 @@
+#ifndef EDO_SCANNER_HPP
+#define EDO_SCANNER_HPP
+
+#include <vector>
+#include <string>
+
+#include "edo/mem/elf.hpp"
+#include "edo/scan/pattern.hpp"
+
+namespace edo
+{
+    /// Returns the first match of a pattern in the range [begin, end)
+    /// Returns nullptr if the pattern could not be found
+    const uint8_t* find(
+        const Pattern& pattern,
+        const uint8_t* begin,
+        const uint8_t* end
+    );
+
+    /// Returns every match of a pattern in the range [begin, end)
+    std::vector<const uint8_t*> find_all(
+        const Pattern& pattern,
+        const uint8_t* begin,
+        const uint8_t* end
+    );
+
+    /// Scans memory for many patterns in a single pass
+    /// Patterns are bucketed by their anchor byte, so each scanned byte
+    /// costs a single table lookup regardless of the amount of patterns
+    class Scanner
+    {
+    public:
+        /// Default constructor
+        Scanner();
+
+        /// Adds a pattern to scan for and returns its index
+        /// @throws invalid_argument If the pattern has no fixed byte, e.g.
+        /// an empty one
+        std::size_t add(const Pattern& pattern);
+
+        /// Returns the amount of patterns added
+        std::size_t size() const;
+
+        /// Removes all patterns
+        void clear();
+
+        /// Returns the first match of every pattern in the range
+        /// [begin, end), indexed as the patterns were added
+        /// Patterns without a match are given nullptr
+        std::vector<const uint8_t*> scan(
+            const uint8_t* begin,
+            const uint8_t* end
+        ) const;
+
+        /// Scans the range [begin, end) for patterns which have no hit yet
+        /// Used to scan several disjoint ranges, e.g. module segments
+        /// @param hits Hits indexed as the patterns were added, resized
+        /// to size() if needed. Only nullptr entries are updated
+        /// @returns The amount of patterns still without a hit
+        std::size_t scan(
+            const uint8_t* begin,
+            const uint8_t* end,
+            std::vector<const uint8_t*>& hits
+        ) const;
+
+        /// Scans given sections of an ELF file on disk, in the given order
+        /// Files without section headers have their read only PT_LOAD
+        /// segments scanned instead. Convert hits to virtual addresses
+        /// through ElfFile::address(hit - file.data())
+        /// @returns The first match of every pattern within the mapped
+        /// file, indexed as the patterns were added. Patterns without a
+        /// match are given nullptr
+        std::vector<const uint8_t*> scan(
+            const ElfFile& file,
+            const std::vector<std::string>& sections = {".text", ".rodata"}
+        ) const;
+
+    private:
+        struct Candidate
+        {
+            std::size_t index;
+            std::size_t anchor;
+        };
+
+        std::vector<Pattern> patterns;
+        std::vector<Candidate> anchors[256];
+    };
+}
+#endif
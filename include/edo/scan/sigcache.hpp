@@ -0,0 +1,100 @@
+#ifndef EDO_SIGCACHE_HPP
+#define EDO_SIGCACHE_HPP
+
+#include <map>
+#include <string>
+
+#include "edo/base/bytebuf.hpp"
+#include "edo/mem/elf.hpp"
+#include "edo/mem/module.hpp"
+#include "edo/scan/pattern.hpp"
+
+namespace edo
+{
+    /// A persistent cache of signature scan results for a module build
+    /// Hits are stored as offsets from the module base, together with a
+    /// hash of the pattern that produced them so edited patterns are
+    /// rescanned. The cache is keyed by Module::id(), so a new build of
+    /// the module invalidates every entry
+    class SignatureCache
+    {
+    public:
+        /// Default constructor
+        SignatureCache();
+
+        /// Loads the cache from a file
+        /// A missing or corrupt file leaves the cache empty
+        /// @returns Whether the cache file could be loaded
+        bool load(const std::string& path);
+
+        /// Saves the cache to a file
+        /// @throws EdoError If the file could not be written
+        void save(const std::string& path);
+
+        /// Serializes the cache into binary format
+        Bytebuf serialize();
+
+        /// Replaces the contents of the cache with a serialized cache
+        /// @throws out_of_range If the buffer is truncated
+        /// @throws runtime_error If the buffer is not a serialized cache
+        void parse(Bytebuf& buf);
+
+        /// Returns the id of the module build the cache belongs to
+        const std::string& key();
+
+        /// Returns the amount of cached hits
+        std::size_t size();
+
+        /// Clears every cached hit and the key
+        void clear();
+
+        /// Returns whether a hit is cached for a given signature
+        bool has_key(const std::string& name);
+
+        /// Caches a hit for a given signature
+        /// @param offset The offset of the hit from the module base
+        void put(
+            const std::string& name,
+            const Pattern& pattern,
+            const uintptr_t offset
+        );
+
+        /// Resolves the address of every signature in a given module
+        /// Cached hits are validated by matching their pattern in place,
+        /// only signatures without a valid hit are scanned for. The cache
+        /// is rekeyed to the module if it belonged to another build
+        /// @returns The address of every signature that could be found,
+        /// signatures which could not be found are left out
+        std::map<std::string, uintptr_t> resolve(
+            const Module& module,
+            const std::map<std::string, Pattern>& signatures
+        );
+
+        /// Fills the cache from a module file on disk, before it is loaded
+        /// The .text and .rodata sections are scanned for every signature
+        /// and hits are stored as virtual addresses, which are their
+        /// offsets from Module::base() once loaded. The cache is rekeyed to
+        /// the file if it belonged to another build
+        /// @returns The amount of signatures that could be found
+        std::size_t prepare(
+            const ElfFile& file,
+            const std::map<std::string, Pattern>& signatures
+        );
+
+        /// Returns the amount of signatures that had to be scanned for
+        /// during the last call to resolve()
+        std::size_t scanned();
+
+    private:
+        struct Entry
+        {
+            uint64_t pattern_hash;
+            uint64_t offset;
+        };
+
+        std::string module_key;
+        std::map<std::string, Entry> entries;
+        std::size_t scan_count;
+    };
+}
+#endif
@@ -0,0 +1,324 @@
+#ifndef EDO_STATIC_PATTERN_HPP
+#define EDO_STATIC_PATTERN_HPP
+
+#include <cstring>
+#include <cstdint>
+
+#include "edo/scan/pattern.hpp"
+
+/// The longest pattern string accepted by EDO_PATTERN
+#define EDO_PATTERN_MAX_LENGTH 256
+
+/// Declares the type of a pattern parsed at compile time, e.g:
+/// typedef EDO_PATTERN("48 8B ?? ?? E8") Sig;
+/// const uint8_t* hit = edo::find(Sig(), begin, end);
+/// Malformed patterns fail the build
+#define EDO_PATTERN(str)\
+    ::edo::StaticPattern<sizeof(str) - 1, EDO_PATTERN_CHARS_256(str, 0)>
+
+#define EDO_PATTERN_CHAR(str, i) ::edo::pattern_detail::char_at(str, i)
+#define EDO_PATTERN_CHARS_4(str, i)\
+    EDO_PATTERN_CHAR(str, i), EDO_PATTERN_CHAR(str, i + 1),\
+    EDO_PATTERN_CHAR(str, i + 2), EDO_PATTERN_CHAR(str, i + 3)
+#define EDO_PATTERN_CHARS_16(str, i)\
+    EDO_PATTERN_CHARS_4(str, i), EDO_PATTERN_CHARS_4(str, i + 4),\
+    EDO_PATTERN_CHARS_4(str, i + 8), EDO_PATTERN_CHARS_4(str, i + 12)
+#define EDO_PATTERN_CHARS_64(str, i)\
+    EDO_PATTERN_CHARS_16(str, i), EDO_PATTERN_CHARS_16(str, i + 16),\
+    EDO_PATTERN_CHARS_16(str, i + 32), EDO_PATTERN_CHARS_16(str, i + 48)
+#define EDO_PATTERN_CHARS_256(str, i)\
+    EDO_PATTERN_CHARS_64(str, i), EDO_PATTERN_CHARS_64(str, i + 64),\
+    EDO_PATTERN_CHARS_64(str, i + 128), EDO_PATTERN_CHARS_64(str, i + 192)
+
+namespace edo
+{
+    /// Constexpr parsing of pattern strings, see Pattern for the format
+    namespace pattern_detail
+    {
+        template<std::size_t N>
+        constexpr char char_at(const char (&str)[N], const std::size_t i)
+        {
+            return i < N ? str[i] : '\0';
+        }
+
+        constexpr bool is_end(const char* s, const std::size_t n,
+            const std::size_t i)
+        {
+            return i >= n || s[i] == '\0';
+        }
+
+        constexpr bool is_space(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        constexpr int hex_value(const char c)
+        {
+            return (c >= '0' && c <= '9') ? c - '0' :
+                (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                (c >= 'A' && c <= 'F') ? c - 'A' + 10 :
+                -1;
+        }
+
+        /// Returns the index of the first non-space at or after i
+        constexpr std::size_t skip_spaces(const char* s, const std::size_t n,
+            const std::size_t i)
+        {
+            return !is_end(s, n, i) && is_space(s[i]) ?
+                skip_spaces(s, n, i + 1) : i;
+        }
+
+        /// Returns the index after the token starting at i
+        constexpr std::size_t token_end(const char* s, const std::size_t n,
+            const std::size_t i)
+        {
+            return !is_end(s, n, i) && !is_space(s[i]) ?
+                token_end(s, n, i + 1) : i;
+        }
+
+        constexpr bool valid_token(const char* s, const std::size_t n,
+            const std::size_t i)
+        {
+            return (token_end(s, n, i) - i == 1 && s[i] == '?') ||
+                (token_end(s, n, i) - i == 2 &&
+                    ((s[i] == '?' && s[i + 1] == '?') ||
+                    (hex_value(s[i]) >= 0 && hex_value(s[i + 1]) >= 0)));
+        }
+
+        /// Returns the amount of tokens at or after i
+        constexpr std::size_t count_tokens(const char* s, const std::size_t n,
+            const std::size_t i)
+        {
+            return is_end(s, n, skip_spaces(s, n, i)) ? 0 :
+                1 + count_tokens(s, n, token_end(s, n, skip_spaces(s, n, i)));
+        }
+
+        /// Returns whether every token at or after i is well formed
+        constexpr bool valid(const char* s, const std::size_t n,
+            const std::size_t i)
+        {
+            return is_end(s, n, skip_spaces(s, n, i)) ? true :
+                valid_token(s, n, skip_spaces(s, n, i)) &&
+                valid(s, n, token_end(s, n, skip_spaces(s, n, i)));
+        }
+
+        /// Returns the index of token k, counting from i
+        constexpr std::size_t token_start(const char* s, const std::size_t n,
+            const std::size_t k, const std::size_t i)
+        {
+            return k == 0 ? skip_spaces(s, n, i) :
+                token_start(s, n, k - 1, token_end(s, n, skip_spaces(s, n, i)));
+        }
+
+        constexpr bool wildcard(const char* s, const std::size_t n,
+            const std::size_t k)
+        {
+            return s[token_start(s, n, k, 0)] == '?';
+        }
+
+        constexpr uint8_t byte(const char* s, const std::size_t n,
+            const std::size_t k)
+        {
+            return wildcard(s, n, k) ? 0 : static_cast<uint8_t>(
+                hex_value(s[token_start(s, n, k, 0)]) << 4 |
+                hex_value(s[token_start(s, n, k, 0) + 1]));
+        }
+
+        /// Returns whether token k is a fixed byte rarer than token best
+        constexpr bool rarer(const char* s, const std::size_t n,
+            const std::size_t k, const std::size_t best)
+        {
+            return !wildcard(s, n, k) && (wildcard(s, n, best) ||
+                byte_frequency(byte(s, n, k)) <
+                    byte_frequency(byte(s, n, best)));
+        }
+
+        /// Returns the index of the rarest fixed token from k onwards
+        constexpr std::size_t anchor(const char* s, const std::size_t n,
+            const std::size_t count, const std::size_t k, const std::size_t best)
+        {
+            return k >= count ? best :
+                anchor(s, n, count, k + 1, rarer(s, n, k, best) ? k : best);
+        }
+
+        template<std::size_t... I>
+        struct Indices
+        {
+
+        };
+
+        template<std::size_t N, std::size_t... I>
+        struct MakeIndices : MakeIndices<N - 1, N - 1, I...>
+        {
+
+        };
+
+        template<std::size_t... I>
+        struct MakeIndices<0, I...>
+        {
+            typedef Indices<I...> type;
+        };
+
+        template<char... Chars>
+        struct Text
+        {
+            static constexpr char value[sizeof...(Chars) + 1] = {Chars..., '\0'};
+        };
+
+        template<char... Chars>
+        constexpr char Text<Chars...>::value[sizeof...(Chars) + 1];
+
+        /// The bytes and mask of a pattern as arrays
+        template<typename T, std::size_t Length, typename I>
+        struct Bytes;
+
+        template<typename T, std::size_t Length, std::size_t... I>
+        struct Bytes<T, Length, Indices<I...>>
+        {
+            static constexpr uint8_t bytes[sizeof...(I) + 1] =
+                {byte(T::value, Length, I)..., 0};
+            static constexpr uint8_t mask[sizeof...(I) + 1] =
+                {(wildcard(T::value, Length, I) ? 0 : 0xFF)..., 0};
+        };
+
+        template<typename T, std::size_t Length, std::size_t... I>
+        constexpr uint8_t Bytes<T, Length, Indices<I...>>::bytes[];
+
+        template<typename T, std::size_t Length, std::size_t... I>
+        constexpr uint8_t Bytes<T, Length, Indices<I...>>::mask[];
+
+        /// Compares the bytes from I onwards, unrolled at compile time
+        template<typename P, std::size_t I, std::size_t N>
+        struct Match
+        {
+            static bool check(const uint8_t* data)
+            {
+                return (P::wildcard(I) || data[I] == P::byte(I)) &&
+                    Match<P, I + 1, N>::check(data);
+            }
+        };
+
+        template<typename P, std::size_t N>
+        struct Match<P, N, N>
+        {
+            static bool check(const uint8_t*)
+            {
+                return true;
+            }
+        };
+    }
+
+    /// A pattern parsed at compile time, declared through EDO_PATTERN
+    /// The length, anchor and every byte of the pattern are compile time
+    /// constants, and matching is unrolled with wildcards left out
+    template<std::size_t Length, char... Chars>
+    class StaticPattern
+    {
+    private:
+        typedef pattern_detail::Text<Chars...> text;
+
+        static_assert(Length <= EDO_PATTERN_MAX_LENGTH,
+            "Pattern string is too long");
+        static_assert(pattern_detail::valid(text::value, Length, 0),
+            "Malformatted pattern string");
+
+    public:
+        /// The length of the pattern in bytes
+        static constexpr std::size_t size =
+            pattern_detail::count_tokens(text::value, Length, 0);
+
+        /// The index of the byte used as scan anchor, the least common
+        /// non-wildcard byte of the pattern
+        static constexpr std::size_t anchor =
+            pattern_detail::anchor(text::value, Length, size, 0, 0);
+
+        /// The value of the anchor byte
+        static constexpr uint8_t anchor_byte =
+            pattern_detail::byte(text::value, Length, anchor);
+
+        static_assert(size > 0 &&
+            !pattern_detail::wildcard(text::value, Length, anchor),
+            "Pattern has no fixed bytes");
+
+        /// Returns the byte at given index, 0 for wildcards
+        static constexpr uint8_t byte(const std::size_t index)
+        {
+            return pattern_detail::byte(text::value, Length, index);
+        }
+
+        /// Returns whether the byte at given index is a wildcard
+        static constexpr bool wildcard(const std::size_t index)
+        {
+            return pattern_detail::wildcard(text::value, Length, index);
+        }
+
+        /// Returns whether the pattern matches the memory at given address
+        /// At least size bytes must be readable from data
+        static bool matches(const uint8_t* data)
+        {
+            return pattern_detail::Match<StaticPattern, 0, size>::check(data);
+        }
+
+        /// Returns the pattern string
+        static const char* str()
+        {
+            return text::value;
+        }
+
+        /// Returns the pattern as a runtime pattern, e.g. for use with a
+        /// Scanner or SignatureCache
+        static Pattern pattern()
+        {
+            typedef pattern_detail::Bytes<text, Length,
+                typename pattern_detail::MakeIndices<size>::type> arrays;
+
+            return Pattern(
+                std::vector<uint8_t>(arrays::bytes, arrays::bytes + size),
+                std::vector<uint8_t>(arrays::mask, arrays::mask + size)
+            );
+        }
+    };
+
+    template<std::size_t Length, char... Chars>
+    constexpr std::size_t StaticPattern<Length, Chars...>::size;
+
+    template<std::size_t Length, char... Chars>
+    constexpr std::size_t StaticPattern<Length, Chars...>::anchor;
+
+    template<std::size_t Length, char... Chars>
+    constexpr uint8_t StaticPattern<Length, Chars...>::anchor_byte;
+
+    /// Returns the first match of a compile time pattern in the range
+    /// [begin, end), or nullptr if it could not be found
+    template<std::size_t Length, char... Chars>
+    const uint8_t* find(
+        StaticPattern<Length, Chars...>,
+        const uint8_t* begin,
+        const uint8_t* end
+    )
+    {
+        typedef StaticPattern<Length, Chars...> P;
+
+        if(static_cast<std::size_t>(end - begin) < P::size)
+            return nullptr;
+
+        const uint8_t* pos = begin + P::anchor;
+        const uint8_t* last = end - P::size + P::anchor;
+
+        while(pos <= last)
+        {
+            const void* found = std::memchr(pos, P::anchor_byte, last - pos + 1);
+            if(found == nullptr)
+                return nullptr;
+
+            const uint8_t* candidate = static_cast<const uint8_t*>(found);
+            if(P::matches(candidate - P::anchor))
+                return candidate - P::anchor;
+
+            pos = candidate + 1;
+        }
+
+        return nullptr;
+    }
+}
+#endif
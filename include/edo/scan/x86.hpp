@@ -0,0 +1,102 @@
+#ifndef EDO_X86_HPP
+#define EDO_X86_HPP
+
+#include <vector>
+#include <cstdint>
+
+#include "edo/mem/elf.hpp"
+
+/// The maximum length of an x86 instruction in bytes
+#define EDO_X86_MAX_LENGTH 15
+
+namespace edo
+{
+    /// An x86-64 instruction decoded far enough to know its length and
+    /// the location of its operands
+    struct Instruction
+    {
+        /// The length of the instruction in bytes, 0 if it is invalid or
+        /// truncated
+        uint8_t length;
+
+        /// The opcode map, 0 for one byte opcodes, 1 for 0F, 2 for 0F 38
+        /// and 3 for 0F 3A
+        uint8_t map;
+
+        /// The opcode byte within its map
+        uint8_t opcode;
+
+        /// The REX prefix, 0 if there is none
+        uint8_t rex;
+
+        /// The ModRM byte, only valid if has_modrm is set
+        uint8_t modrm;
+        bool has_modrm;
+
+        /// Whether the instruction has a VEX or EVEX prefix
+        bool vex;
+
+        /// Position and size of the memory displacement, size 0 if none
+        uint8_t displacement_offset;
+        uint8_t displacement_size;
+        int32_t displacement;
+
+        /// Position and size of the immediate, size 0 if none
+        /// Relative branches store their displacement as immediate
+        uint8_t immediate_offset;
+        uint8_t immediate_size;
+        int64_t immediate;
+
+        /// Position and size of the RIP-relative field, size 0 if none
+        /// This is the displacement of a RIP-relative memory operand or
+        /// the immediate of a relative branch
+        uint8_t relative_offset;
+        uint8_t relative_size;
+        int32_t relative;
+
+        /// Returns whether the instruction has a RIP-relative operand
+        bool has_target() const;
+
+        /// Returns whether the instruction is a relative jump or call
+        bool branch() const;
+
+        /// Returns the target of the RIP-relative operand, given the address
+        /// the instruction is located at
+        uintptr_t target(const uintptr_t address) const;
+    };
+
+    /// Decodes the instruction at a given address
+    /// @param size The amount of readable bytes at code
+    /// @returns The decoded instruction, with length 0 if it is invalid or
+    /// longer than size
+    Instruction decode(
+        const uint8_t* code,
+        const std::size_t size = EDO_X86_MAX_LENGTH
+    );
+
+    /// Returns the length of the instruction at a given address, or 0 if
+    /// it is invalid
+    std::size_t instruction_length(const uint8_t* code);
+
+    /// Resolves the RIP-relative targets of many instructions in one pass,
+    /// e.g. scan hits pointing at a mov, lea or call
+    /// @param offsets The offset of the instruction from every hit, empty
+    /// if every hit points at its instruction
+    /// @returns The targets indexed like the hits. Hits which are nullptr,
+    /// invalid or have no RIP-relative operand resolve to 0
+    /// @throws invalid_argument If offsets are given for some hits only
+    std::vector<uintptr_t> resolve_targets(
+        const std::vector<const uint8_t*>& hits,
+        const std::vector<std::size_t>& offsets = {}
+    );
+
+    /// Resolves RIP-relative targets of hits within a mapped ELF file,
+    /// e.g. as returned by Scanner::scan(ElfFile)
+    /// @returns The targets as virtual addresses, see resolve_targets()
+    std::vector<uint64_t> resolve_targets(
+        const ElfFile& file,
+        const std::vector<const uint8_t*>& hits,
+        const std::vector<std::size_t>& offsets = {}
+    );
+}
+#endif
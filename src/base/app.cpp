@@ -1,29 +1,129 @@
-#include <thread>
-#include <chrono>
-
+#include "edo/base/profiler.hpp"
 #include "edo/base/app.hpp"
 
-edo::IApplication::IApplication()
+edo::IApplication::IApplication() : join_tasks(false)
 {
     setExit(false);
+
+    // Only wakes up the loop, the coroutines are stepped after main()
+    event_loop.watch(coroutine_runner.fd(), [](uint32_t) {});
+}
+
+edo::IApplication::~IApplication()
+{
+
 }
 
 void edo::IApplication::run()
 {
     setExit(false);
+    tick_scheduler.start();
+
+    while(!shouldExit())
+    {
+        int64_t deadline = tick_scheduler.deadline();
+        uint64_t overruns = tick_scheduler.overruns();
+        tick_scheduler.wait();
+
+        EDO_PROFILE_SCOPE("app.tick");
+        int64_t begin = TickScheduler::now();
+        frame_arena.reset();
+        main();
+        coroutine_runner.step();
+
+        if(join_tasks && task_pool)
+            task_pool->wait();
+
+        tick_stats.record(TickScheduler::now() - begin, begin - deadline,
+            tick_scheduler.overruns() != overruns);
+    }
+
+    shutdown();
+}
+
+void edo::IApplication::runEvents()
+{
+    setExit(false);
+
     while(!shouldExit())
     {
+        // Coroutines waiting for a tick get the next batch right away
+        event_loop.poll(coroutine_runner.pending() ? 0 : -1);
+        if(shouldExit())
+            break;
+
+        // Events have no deadline, so only the duration is recorded
+        EDO_PROFILE_SCOPE("app.tick");
+        int64_t begin = TickScheduler::now();
+        frame_arena.reset();
         main();
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        coroutine_runner.step();
+
+        if(join_tasks && task_pool)
+            task_pool->wait();
+
+        tick_stats.record(TickScheduler::now() - begin, 0, false);
     }
+
+    shutdown();
 }
 
 bool edo::IApplication::shouldExit()
 {
-    return exit;
+    return exit.load(std::memory_order_acquire);
 }
 
 void edo::IApplication::setExit(bool exit)
 {
-    this->exit = exit;
+    this->exit.store(exit, std::memory_order_release);
+    if(exit)
+        event_loop.interrupt();
+}
+
+edo::TickScheduler& edo::IApplication::scheduler()
+{
+    return tick_scheduler;
+}
+
+edo::EventLoop& edo::IApplication::events()
+{
+    return event_loop;
+}
+
+edo::ThreadPool& edo::IApplication::pool()
+{
+    if(!task_pool)
+        task_pool.reset(new ThreadPool());
+
+    return *task_pool;
+}
+
+void edo::IApplication::setJoinTasks(bool join)
+{
+    join_tasks = join;
+}
+
+bool edo::IApplication::joinTasks()
+{
+    return join_tasks;
+}
+
+edo::CoroutineRunner& edo::IApplication::coroutines()
+{
+    return coroutine_runner;
+}
+
+edo::TickStats& edo::IApplication::stats()
+{
+    return tick_stats;
+}
+
+edo::FrameArena& edo::IApplication::frame()
+{
+    return frame_arena;
+}
+
+void edo::IApplication::shutdown()
+{
+    task_pool.reset();
 }
@@ -0,0 +1,125 @@
+#include <new>
+#include <limits>
+#include <stdexcept>
+
+#include "edo/base/strings.hpp"
+#include "edo/base/arena.hpp"
+
+const std::size_t edo::FrameArena::DEFAULT_CAPACITY;
+
+edo::FrameArena::FrameArena(const std::size_t capacity) :
+    used_bytes(0), high_water_bytes(0), overflow_count(0)
+{
+    Chunk chunk;
+    chunk.size = capacity > 0 ? capacity : 1;
+    chunk.data = static_cast<uint8_t*>(::operator new(chunk.size));
+    chunks.push_back(chunk);
+
+    top = chunk.data;
+    limit = chunk.data + chunk.size;
+}
+
+edo::FrameArena::~FrameArena()
+{
+    for(Chunk& chunk : chunks)
+        ::operator delete(chunk.data);
+}
+
+void* edo::FrameArena::allocate(
+    const std::size_t size,
+    const std::size_t alignment
+)
+{
+    if(alignment == 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument(INVALID_ALIGNMENT);
+
+    std::size_t padding = -reinterpret_cast<uintptr_t>(top) & (alignment - 1);
+    if(padding > static_cast<std::size_t>(limit - top) ||
+        size > static_cast<std::size_t>(limit - top) - padding)
+    {
+        return overflow(size, alignment);
+    }
+
+    uint8_t* result = top + padding;
+    top = result + size;
+    used_bytes += padding + size;
+
+    return result;
+}
+
+void edo::FrameArena::reset()
+{
+    if(used_bytes > high_water_bytes)
+        high_water_bytes = used_bytes;
+
+    // Merge a chain into one chunk, which the next frame likely fits into
+    if(chunks.size() > 1)
+    {
+        std::size_t total = capacity();
+        for(Chunk& chunk : chunks)
+            ::operator delete(chunk.data);
+
+        chunks.clear();
+
+        Chunk chunk;
+        chunk.size = total;
+        chunk.data = static_cast<uint8_t*>(::operator new(chunk.size));
+        chunks.push_back(chunk);
+    }
+
+    top = chunks[0].data;
+    limit = chunks[0].data + chunks[0].size;
+    used_bytes = 0;
+}
+
+std::size_t edo::FrameArena::used() const
+{
+    return used_bytes;
+}
+
+std::size_t edo::FrameArena::capacity() const
+{
+    std::size_t total = 0;
+    for(const Chunk& chunk : chunks)
+        total += chunk.size;
+
+    return total;
+}
+
+std::size_t edo::FrameArena::high_water() const
+{
+    return used_bytes > high_water_bytes ? used_bytes : high_water_bytes;
+}
+
+uint64_t edo::FrameArena::overflows() const
+{
+    return overflow_count;
+}
+
+void* edo::FrameArena::overflow(
+    const std::size_t size,
+    const std::size_t alignment
+)
+{
+    if(size > std::numeric_limits<std::size_t>::max() / 2 - alignment)
+        throw std::bad_alloc();
+
+    // Chunks double, and a large allocation gets one of its own size
+    std::size_t next = chunks.back().size * 2;
+    if(next < size + alignment)
+        next = size + alignment;
+
+    chunks.reserve(chunks.size() + 1);
+
+    Chunk chunk;
+    chunk.size = next;
+    chunk.data = static_cast<uint8_t*>(::operator new(chunk.size));
+    chunks.push_back(chunk);
+    overflow_count++;
+
+    // The rest of the previous chunk is not counted as used
+    top = chunk.data;
+    limit = chunk.data + chunk.size;
+
+    return allocate(size, alignment);
+}
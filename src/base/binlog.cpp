@@ -0,0 +1,353 @@
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/binlog.hpp"
+
+namespace
+{
+    const uint32_t LOG_MAGIC = 0x4C424445; // "EDBL"
+    const uint32_t LOG_VERSION = 1;
+
+    /// Serial of the next logger, 0 marks an empty cache
+    std::atomic<uint64_t> next_serial(1);
+
+    /// The ring the calling thread used last and its logger
+    struct BufferCache
+    {
+        uint64_t serial;
+        void* buffer;
+    };
+
+    thread_local BufferCache buffer_cache = {0, nullptr};
+
+    /// The format strings of every logger, indexed by their ids
+    std::mutex format_mutex;
+    std::vector<std::string> format_strings;
+}
+
+const std::size_t edo::BinaryLogger::DEFAULT_BUFFER_SIZE;
+const int64_t edo::BinaryLogger::DEFAULT_INTERVAL;
+const uint8_t edo::BinaryLogger::FORMAT;
+const uint8_t edo::BinaryLogger::ENTRY;
+const std::size_t edo::BinaryLogger::ENTRY_HEADER_SIZE;
+
+edo::BinaryLogger::BinaryLogger(
+    const std::string& path,
+    const std::size_t buffer_size,
+    const int64_t interval
+) :
+    buffer_size(2), interval(interval), serial(next_serial.fetch_add(1)),
+    written_formats(0), error_count(0), stopping(false)
+{
+    while(this->buffer_size < buffer_size)
+        this->buffer_size *= 2;
+
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0)
+        throw edo::EdoError(FILE_WRITE_FAILED);
+
+    // Both clocks at once, so the reader can turn times into wall time
+    int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    Bytebuf header;
+    header.put(LOG_MAGIC);
+    header.put(LOG_VERSION);
+    header.put(TickScheduler::now());
+    header.put(wall);
+    write(header.data(), header.size());
+
+    drainer = std::thread(&BinaryLogger::run, this);
+}
+
+edo::BinaryLogger::~BinaryLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex);
+        stopping = true;
+    }
+
+    stop_condition.notify_one();
+    drainer.join();
+
+    flush();
+    close(fd);
+}
+
+uint32_t edo::BinaryLogger::format(const std::string& format)
+{
+    std::lock_guard<std::mutex> lock(format_mutex);
+    for(std::size_t i = 0; i < format_strings.size(); i++)
+    {
+        if(format_strings[i] == format)
+            return i;
+    }
+
+    format_strings.push_back(format);
+    return format_strings.size() - 1;
+}
+
+void edo::BinaryLogger::flush()
+{
+    std::lock_guard<std::mutex> lock(drain_mutex);
+
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex);
+        for(std::unique_ptr<ThreadBuffer>& buffer : threads)
+            buffers.push_back(buffer.get());
+    }
+
+    staging.clear();
+    for(ThreadBuffer* buffer : buffers)
+    {
+        uint64_t head = buffer->head.value.load(std::memory_order_acquire);
+        uint64_t tail = buffer->tail.value.load(std::memory_order_relaxed);
+        if(head == tail)
+            continue;
+
+        std::size_t offset = tail & buffer->mask;
+        std::size_t length = head - tail;
+        std::size_t first = buffer->mask + 1 - offset;
+        if(first > length)
+            first = length;
+
+        staging.put(buffer->data.get() + offset, first);
+        staging.put(buffer->data.get(), length - first);
+
+        // Hands the bytes back to the thread once they are copied
+        buffer->tail.value.store(head, std::memory_order_release);
+    }
+
+    // Formats are registered before messages using them are logged, so
+    // every format drained above is known by now and written before them
+    Bytebuf definitions;
+    {
+        std::lock_guard<std::mutex> lock(format_mutex);
+        for(; written_formats < format_strings.size(); written_formats++)
+        {
+            definitions.put(FORMAT);
+            definitions.put(static_cast<uint32_t>(written_formats));
+            definitions.put(format_strings[written_formats]);
+        }
+    }
+
+    write(definitions.data(), definitions.size());
+    write(staging.data(), staging.size());
+}
+
+uint64_t edo::BinaryLogger::dropped() const
+{
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    uint64_t sum = 0;
+    for(const std::unique_ptr<ThreadBuffer>& buffer : threads)
+        sum += buffer->dropped.load(std::memory_order_relaxed);
+
+    return sum;
+}
+
+uint64_t edo::BinaryLogger::errors() const
+{
+    return error_count.load(std::memory_order_relaxed);
+}
+
+edo::BinaryLogger::ThreadBuffer& edo::BinaryLogger::local()
+{
+    if(buffer_cache.serial == serial)
+        return *static_cast<ThreadBuffer*>(buffer_cache.buffer);
+
+    return attach();
+}
+
+edo::BinaryLogger::ThreadBuffer& edo::BinaryLogger::attach()
+{
+    std::lock_guard<std::mutex> lock(thread_mutex);
+
+    // A thread switching between loggers finds its ring again
+    std::thread::id thread = std::this_thread::get_id();
+    ThreadBuffer* found = nullptr;
+    for(std::unique_ptr<ThreadBuffer>& buffer : threads)
+    {
+        if(buffer->thread == thread)
+            found = buffer.get();
+    }
+
+    if(found == nullptr)
+    {
+        threads.emplace_back(new ThreadBuffer());
+        found = threads.back().get();
+        found->thread = thread;
+        found->index = threads.size();
+        found->data.reset(new uint8_t[buffer_size]);
+        found->mask = buffer_size - 1;
+        found->dropped.store(0);
+        found->head.value.store(0);
+        found->tail.value.store(0);
+    }
+
+    buffer_cache.serial = serial;
+    buffer_cache.buffer = found;
+    return *found;
+}
+
+void edo::BinaryLogger::run()
+{
+    std::unique_lock<std::mutex> lock(stop_mutex);
+    while(!stopping)
+    {
+        stop_condition.wait_for(lock, std::chrono::nanoseconds(interval));
+        if(stopping)
+            break;
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void edo::BinaryLogger::write(const uint8_t* data, const std::size_t length)
+{
+    std::size_t done = 0;
+    while(done < length)
+    {
+        ssize_t written = ::write(fd, data + done, length - done);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            error_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        done += written;
+    }
+}
+
+edo::BinaryLogReader::BinaryLogReader(const std::string& path)
+{
+    buf.put(read_file(path));
+    buf.rewind();
+
+    try
+    {
+        uint32_t magic = buf.get<uint32_t>();
+        uint32_t version = buf.get<uint32_t>();
+        if(magic != LOG_MAGIC || version != LOG_VERSION)
+            throw edo::EdoError(MALFORMATTED_BINARY_LOG);
+
+        steady_origin = buf.get<int64_t>();
+        wall_origin = buf.get<int64_t>();
+    }
+    catch(const std::out_of_range&)
+    {
+        throw edo::EdoError(MALFORMATTED_BINARY_LOG);
+    }
+}
+
+bool edo::BinaryLogReader::next(LogEntry& entry)
+{
+    try
+    {
+        while(buf.get_pos() < buf.size())
+        {
+            uint8_t kind = buf.get<uint8_t>();
+            if(kind == BinaryLogger::FORMAT)
+            {
+                uint32_t id = buf.get<uint32_t>();
+                std::string format = buf.get_string();
+                if(id >= formats.size())
+                    formats.resize(id + 1);
+
+                formats[id] = format;
+                continue;
+            }
+
+            if(kind != BinaryLogger::ENTRY)
+                throw edo::EdoError(MALFORMATTED_BINARY_LOG);
+
+            entry.format = buf.get<uint32_t>();
+            entry.time = wall_origin + (buf.get<int64_t>() - steady_origin);
+            entry.thread = buf.get<uint32_t>();
+            uint8_t count = buf.get<uint8_t>();
+
+            if(entry.format >= formats.size())
+                throw edo::EdoError(MALFORMATTED_BINARY_LOG);
+
+            // Every "{}" takes the next argument, ones left over are
+            // appended and missing ones leave the "{}" in place
+            const std::string& format = formats[entry.format];
+            entry.message.clear();
+
+            std::size_t begin = 0;
+            for(uint8_t i = 0; i < count; i++)
+            {
+                std::size_t found = format.find("{}", begin);
+                if(found == std::string::npos)
+                {
+                    entry.message.append(format, begin, std::string::npos);
+                    begin = format.size();
+                    entry.message += ' ';
+                }
+                else
+                {
+                    entry.message.append(format, begin, found - begin);
+                    begin = found + 2;
+                }
+
+                format_arg(entry.message);
+            }
+
+            entry.message.append(format, begin, std::string::npos);
+            return true;
+        }
+    }
+    catch(const std::out_of_range&)
+    {
+        // Cut off while written, the rest of the file holds no message
+        buf.set_pos(buf.size());
+    }
+
+    return false;
+}
+
+void edo::BinaryLogReader::format_arg(std::string& message)
+{
+    char formatted[32];
+    BinaryLogger::ArgType type = buf.get<BinaryLogger::ArgType>();
+    switch(type)
+    {
+    case BinaryLogger::ArgType::boolean:
+        message += buf.get<uint8_t>() != 0 ? "true" : "false";
+        break;
+    case BinaryLogger::ArgType::character:
+        message += buf.get<char>();
+        break;
+    case BinaryLogger::ArgType::integer:
+        message += std::to_string(buf.get<int64_t>());
+        break;
+    case BinaryLogger::ArgType::unsigned_integer:
+        message += std::to_string(buf.get<uint64_t>());
+        break;
+    case BinaryLogger::ArgType::floating:
+        std::snprintf(formatted, sizeof(formatted), "%g", buf.get<double>());
+        message += formatted;
+        break;
+    case BinaryLogger::ArgType::string:
+        message += buf.get_string();
+        break;
+    case BinaryLogger::ArgType::pointer:
+        std::snprintf(formatted, sizeof(formatted), "0x%llx",
+            static_cast<unsigned long long>(buf.get<uint64_t>()));
+        message += formatted;
+        break;
+    default:
+        throw edo::EdoError(MALFORMATTED_BINARY_LOG);
+    }
+}
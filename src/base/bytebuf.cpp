@@ -1,6 +1,7 @@
 #include <stdexcept>
 #include <cstring>
 
+#include "edo/base/profiler.hpp"
 #include "edo/base/bytebuf.hpp"
 
 // Helper to define all put operations of basic types
@@ -17,7 +18,12 @@ void edo::Bytebuf::put(const type value)\
 
 edo::Bytebuf::Bytebuf()
 {
-    buffer = std::vector<uint8_t>();
+    position = 0;
+}
+
+edo::Bytebuf::Bytebuf(FrameArena& arena) :
+    buffer(FrameAllocator<uint8_t>(arena))
+{
     position = 0;
 }
 
@@ -86,6 +92,7 @@ void edo::Bytebuf::put(const std::size_t index, const uint8_t* data,
     if(index > size())
         throw std::out_of_range(OPERATION_EXCEEDS_SIZE);
 
+    EDO_PROFILE_COUNT("bytebuf.put_bytes", length);
     auto it = buffer.begin() + index;
     buffer.insert(it, data, data + length);
 }
@@ -125,3 +132,34 @@ PUT(uint64_t)
 PUT(float)
 
 PUT(double)
+
+void edo::Bytebuf::put(const std::size_t index, const std::string& str)
+{
+    uint32_t length = static_cast<uint32_t>(str.size());
+    put(index, reinterpret_cast<const uint8_t*>(str.data()), str.size());
+    put(index, length);
+}
+
+void edo::Bytebuf::put(const std::string& str)
+{
+    put(static_cast<uint32_t>(str.size()));
+    put(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+std::string edo::Bytebuf::get_string(const std::size_t index)
+{
+    std::size_t length = get<uint32_t>(index);
+    std::size_t begin = index + sizeof(uint32_t);
+    if(begin + length > size())
+        throw std::out_of_range(OPERATION_EXCEEDS_SIZE);
+
+    return std::string(reinterpret_cast<const char*>(&buffer[begin]), length);
+}
+
+std::string edo::Bytebuf::get_string()
+{
+    std::string res = get_string(get_pos());
+    move(sizeof(uint32_t) + res.size());
+
+    return res;
+}
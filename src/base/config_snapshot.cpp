@@ -0,0 +1,292 @@
+#include <limits>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/config_snapshot.hpp"
+
+namespace
+{
+    const uint32_t SNAPSHOT_MAGIC = 0x53434445; // "EDCS"
+    const uint32_t SNAPSHOT_VERSION = 1;
+
+    /// Magic, version, entry count, reserved and string table size
+    const std::size_t HEADER_SIZE = 24;
+
+    /// Reads an integer in the form lexical_cast<std::string> writes it,
+    /// so the stored integer and the text cannot disagree
+    bool canonical_integer(const std::string& text, int64_t& value)
+    {
+        bool negative = !text.empty() && text[0] == '-';
+        std::size_t first = negative ? 1 : 0;
+        std::size_t digits = text.size() - first;
+
+        if(digits == 0 || digits > 19 || (text[first] == '0' && digits > 1)
+            || (negative && text[first] == '0'))
+        {
+            return false;
+        }
+
+        uint64_t magnitude = 0;
+        for(std::size_t i = first; i < text.size(); i++)
+        {
+            if(text[i] < '0' || text[i] > '9')
+                return false;
+
+            magnitude = magnitude * 10 + (text[i] - '0');
+        }
+
+        uint64_t limit = static_cast<uint64_t>(
+            std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+        if(magnitude > limit)
+            return false;
+
+        value = negative ? static_cast<int64_t>(0 - magnitude)
+            : static_cast<int64_t>(magnitude);
+        return true;
+    }
+}
+
+const uint32_t edo::ConfigSnapshot::INTEGER;
+
+edo::ConfigSnapshot::ConfigSnapshot(const std::string& path)
+{
+    snapshot_data = nullptr;
+    snapshot_size = 0;
+    mapped = false;
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        throw edo::NotFoundError(FILE_NOT_FOUND);
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(HEADER_SIZE))
+    {
+        ::close(fd);
+        throw std::runtime_error(MALFORMATTED_CONFIG_SNAPSHOT);
+    }
+
+    snapshot_size = st.st_size;
+    void* data = mmap(nullptr, snapshot_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if(data == MAP_FAILED)
+        throw edo::NotFoundError(FILE_NOT_FOUND);
+
+    // Lookups jump around the entries and the string table
+    snapshot_data = static_cast<const uint8_t*>(data);
+    mapped = true;
+    madvise(data, snapshot_size, MADV_RANDOM);
+
+    try
+    {
+        read_header();
+    }
+    catch(...)
+    {
+        munmap(data, snapshot_size);
+        throw;
+    }
+}
+
+edo::ConfigSnapshot::ConfigSnapshot(
+    const uint8_t* data,
+    const std::size_t length
+)
+{
+    snapshot_data = data;
+    snapshot_size = length;
+    mapped = false;
+
+    read_header();
+}
+
+edo::ConfigSnapshot::~ConfigSnapshot()
+{
+    if(mapped)
+        munmap(const_cast<uint8_t*>(snapshot_data), snapshot_size);
+}
+
+edo::Bytebuf edo::ConfigSnapshot::serialize(const ConfigMap& map)
+{
+    static_assert(sizeof(Entry) == 32, "Snapshot entries have to be packed");
+
+    // Lay out the string table first, entries point into it
+    std::vector<Entry> table;
+    table.reserve(map.size());
+
+    uint64_t offset = 0;
+    for(auto it = map.begin(); it != map.end(); it++)
+    {
+        if(offset + it->first.size() + it->second.size()
+            > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::runtime_error(CONFIG_SNAPSHOT_TOO_LARGE);
+        }
+
+        Entry entry = Entry();
+        entry.key_offset = static_cast<uint32_t>(offset);
+        entry.key_length = static_cast<uint32_t>(it->first.size());
+        offset += it->first.size();
+
+        entry.value_offset = static_cast<uint32_t>(offset);
+        entry.value_length = static_cast<uint32_t>(it->second.size());
+        offset += it->second.size();
+
+        if(canonical_integer(it->second, entry.integer))
+            entry.flags |= INTEGER;
+
+        table.push_back(entry);
+    }
+
+    Bytebuf buf;
+    buf.reserve(HEADER_SIZE + table.size() * sizeof(Entry) + offset);
+    buf.put(SNAPSHOT_MAGIC);
+    buf.put(SNAPSHOT_VERSION);
+    buf.put(static_cast<uint32_t>(table.size()));
+    buf.put(static_cast<uint32_t>(0));
+    buf.put(offset);
+
+    // The map iterates in key order, which the lookups rely on
+    if(!table.empty())
+    {
+        buf.put(reinterpret_cast<const uint8_t*>(table.data()),
+            table.size() * sizeof(Entry));
+    }
+
+    for(auto it = map.begin(); it != map.end(); it++)
+    {
+        buf.put(reinterpret_cast<const uint8_t*>(it->first.data()),
+            it->first.size());
+        buf.put(reinterpret_cast<const uint8_t*>(it->second.data()),
+            it->second.size());
+    }
+
+    return buf;
+}
+
+std::size_t edo::ConfigSnapshot::size() const
+{
+    return entry_count;
+}
+
+bool edo::ConfigSnapshot::has_key(const std::string& key) const
+{
+    Entry found;
+    return find(key, found);
+}
+
+std::string edo::ConfigSnapshot::get(const std::string& key) const
+{
+    Entry found;
+    if(!find(key, found))
+        throw std::out_of_range(NONEXISTANT_KEY);
+
+    boost::string_view value = string(found.value_offset, found.value_length);
+    return std::string(value.data(), value.size());
+}
+
+boost::string_view edo::ConfigSnapshot::key(const std::size_t index) const
+{
+    if(index >= entry_count)
+        throw std::out_of_range(INDEX_OUT_OF_RANGE);
+
+    Entry found = entry(index);
+    return string(found.key_offset, found.key_length);
+}
+
+boost::string_view edo::ConfigSnapshot::value(const std::size_t index) const
+{
+    if(index >= entry_count)
+        throw std::out_of_range(INDEX_OUT_OF_RANGE);
+
+    Entry found = entry(index);
+    return string(found.value_offset, found.value_length);
+}
+
+void edo::ConfigSnapshot::read_header()
+{
+    if(snapshot_size < HEADER_SIZE)
+        throw std::runtime_error(MALFORMATTED_CONFIG_SNAPSHOT);
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint64_t table_size;
+    std::memcpy(&magic, snapshot_data, sizeof(magic));
+    std::memcpy(&version, snapshot_data + 4, sizeof(version));
+    std::memcpy(&count, snapshot_data + 8, sizeof(count));
+    std::memcpy(&table_size, snapshot_data + 16, sizeof(table_size));
+
+    // A snapshot of the other byte order fails on the magic
+    if(magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+        throw std::runtime_error(MALFORMATTED_CONFIG_SNAPSHOT);
+
+    uint64_t entries_size = static_cast<uint64_t>(count) * sizeof(Entry);
+    if(entries_size > snapshot_size - HEADER_SIZE ||
+        table_size != snapshot_size - HEADER_SIZE - entries_size)
+    {
+        throw std::runtime_error(MALFORMATTED_CONFIG_SNAPSHOT);
+    }
+
+    entry_count = count;
+    entries = snapshot_data + HEADER_SIZE;
+    strings = entries + entries_size;
+    strings_size = table_size;
+}
+
+bool edo::ConfigSnapshot::find(const std::string& key, Entry& found) const
+{
+    boost::string_view wanted(key);
+
+    std::size_t low = 0;
+    std::size_t high = entry_count;
+    while(low < high)
+    {
+        std::size_t middle = low + (high - low) / 2;
+        Entry candidate = entry(middle);
+
+        // Compares like std::string, which ordered the map
+        int order = string(candidate.key_offset, candidate.key_length)
+            .compare(wanted);
+        if(order < 0)
+            low = middle + 1;
+        else if(order > 0)
+            high = middle;
+        else
+        {
+            found = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+edo::ConfigSnapshot::Entry edo::ConfigSnapshot::entry(
+    const std::size_t index
+) const
+{
+    // Snapshots in memory need not be aligned
+    Entry result;
+    std::memcpy(&result, entries + index * sizeof(Entry), sizeof(Entry));
+    return result;
+}
+
+boost::string_view edo::ConfigSnapshot::string(
+    const uint32_t offset,
+    const uint32_t length
+) const
+{
+    if(offset > strings_size || length > strings_size - offset)
+        throw std::runtime_error(MALFORMATTED_CONFIG_SNAPSHOT);
+
+    return boost::string_view(
+        reinterpret_cast<const char*>(strings) + offset, length);
+}
@@ -0,0 +1,331 @@
+#include <cerrno>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/config_source.hpp"
+
+namespace
+{
+    /// The reader slot this thread claimed last, likely free again
+    thread_local std::size_t slot_hint = 0;
+
+    /// Returns the value of a key, nullptr if it does not exist
+    std::unique_ptr<std::string> lookup(
+        const edo::ConfigMap& map,
+        const std::string& key
+    )
+    {
+        if(!map.has_key(key))
+            return std::unique_ptr<std::string>();
+
+        return std::unique_ptr<std::string>(new std::string(map.get(key)));
+    }
+}
+
+struct edo::ConfigSource::Snapshot::Version
+{
+    ConfigMap map;
+    uint64_t number;
+};
+
+const std::size_t edo::ConfigSource::MAX_READERS;
+
+edo::ConfigSource::Snapshot::Snapshot(
+    std::atomic<uint64_t>* slot,
+    const Version* pinned
+) : slot(slot), pinned(pinned)
+{
+
+}
+
+edo::ConfigSource::Snapshot::Snapshot(Snapshot&& other) :
+    slot(other.slot), pinned(other.pinned)
+{
+    other.slot = nullptr;
+    other.pinned = nullptr;
+}
+
+edo::ConfigSource::Snapshot::~Snapshot()
+{
+    if(slot != nullptr)
+        slot->store(0, std::memory_order_release);
+}
+
+const edo::ConfigMap& edo::ConfigSource::Snapshot::operator*() const
+{
+    return pinned->map;
+}
+
+const edo::ConfigMap* edo::ConfigSource::Snapshot::operator->() const
+{
+    return &pinned->map;
+}
+
+uint64_t edo::ConfigSource::Snapshot::version() const
+{
+    return pinned->number;
+}
+
+edo::ConfigSource::ConfigSource(const std::string& path) :
+    path(path), global_epoch(1), error_count(0)
+{
+    std::size_t separator = path.rfind('/');
+    directory = separator == std::string::npos ? "."
+        : path.substr(0, separator == 0 ? 1 : separator);
+    name = path.substr(separator == std::string::npos ? 0 : separator + 1);
+
+    for(std::size_t i = 0; i < MAX_READERS; i++)
+        readers[i].epoch.value.store(0, std::memory_order_relaxed);
+
+    std::vector<uint8_t> data = read_file(path);
+    std::unique_ptr<Snapshot::Version> initial(new Snapshot::Version());
+    initial->map.parse(reinterpret_cast<const char*>(data.data()),
+        data.size());
+    initial->number = 1;
+
+    // Editors tend to replace files rather than write them, so watch the
+    // directory for the name showing up again
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(inotify_fd < 0)
+        throw edo::EdoError(CONFIG_WATCH_FAILED);
+
+    if(inotify_add_watch(inotify_fd, directory.c_str(),
+        IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        close(inotify_fd);
+        throw edo::EdoError(CONFIG_WATCH_FAILED);
+    }
+
+    stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(stop_fd < 0)
+    {
+        close(inotify_fd);
+        throw edo::EdoError(CONFIG_WATCH_FAILED);
+    }
+
+    current.store(initial.release());
+    watcher = std::thread(&ConfigSource::watch, this);
+}
+
+edo::ConfigSource::~ConfigSource()
+{
+    uint64_t one = 1;
+    ssize_t written = write(stop_fd, &one, sizeof(one));
+    (void) written;
+    watcher.join();
+
+    close(stop_fd);
+    close(inotify_fd);
+
+    for(Retired& old : retired)
+        delete old.version;
+
+    delete current.load();
+}
+
+edo::ConfigSource::Snapshot edo::ConfigSource::snapshot() const
+{
+    while(true)
+    {
+        for(std::size_t i = 0; i < MAX_READERS; i++)
+        {
+            std::size_t index = (slot_hint + i) % MAX_READERS;
+
+            // Announce the epoch before loading the version, a version
+            // retired in this epoch or later is not freed until the slot
+            // is released
+            uint64_t expected = 0;
+            uint64_t epoch = global_epoch.load();
+            std::atomic<uint64_t>& slot = readers[index].epoch.value;
+            if(slot.compare_exchange_strong(expected, epoch))
+            {
+                slot_hint = index;
+                return Snapshot(&slot, current.load());
+            }
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+uint64_t edo::ConfigSource::version() const
+{
+    return snapshot().version();
+}
+
+bool edo::ConfigSource::reload()
+{
+    std::lock_guard<std::mutex> lock(reload_mutex);
+
+    std::unique_ptr<Snapshot::Version> next(new Snapshot::Version());
+    try
+    {
+        std::vector<uint8_t> data = read_file(path);
+        next->map.parse(reinterpret_cast<const char*>(data.data()),
+            data.size());
+    }
+    catch(const std::exception&)
+    {
+        // Half-written files fail to parse, the next write retries
+        error_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Only reloads replace the current version, which they do under the
+    // lock, so it cannot be freed meanwhile
+    const Snapshot::Version* previous = current.load();
+    next->number = previous->number + 1;
+
+    const Snapshot::Version* published = next.release();
+    publish(published);
+    notify(published->map, previous->map);
+    reclaim();
+
+    return true;
+}
+
+uint64_t edo::ConfigSource::errors() const
+{
+    return error_count.load(std::memory_order_relaxed);
+}
+
+std::size_t edo::ConfigSource::subscribe(
+    const std::string& key,
+    const Callback& callback
+)
+{
+    std::lock_guard<std::mutex> lock(subscription_mutex);
+
+    Subscription subscription;
+    subscription.active = true;
+    subscription.key = key;
+    subscription.callback = callback;
+    subscriptions.push_back(subscription);
+
+    return subscriptions.size() - 1;
+}
+
+void edo::ConfigSource::unsubscribe(const std::size_t id)
+{
+    std::lock_guard<std::mutex> lock(subscription_mutex);
+    if(id >= subscriptions.size() || !subscriptions[id].active)
+        throw std::out_of_range(NONEXISTANT_SUBSCRIPTION);
+
+    subscriptions[id].active = false;
+    subscriptions[id].callback = Callback();
+}
+
+void edo::ConfigSource::watch()
+{
+    pollfd fds[2];
+    fds[0].fd = inotify_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = stop_fd;
+    fds[1].events = POLLIN;
+
+    alignas(inotify_event) char buffer[4096];
+    while(true)
+    {
+        if(poll(fds, 2, -1) < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            return;
+        }
+
+        if(fds[1].revents != 0)
+            return;
+
+        bool changed = false;
+        ssize_t length;
+        while((length = read(inotify_fd, buffer, sizeof(buffer))) > 0)
+        {
+            for(char* p = buffer; p < buffer + length;)
+            {
+                inotify_event* event = reinterpret_cast<inotify_event*>(p);
+                if(event->len > 0 && name == event->name)
+                    changed = true;
+
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+
+        if(changed)
+            reload();
+    }
+}
+
+void edo::ConfigSource::publish(const Snapshot::Version* next)
+{
+    const Snapshot::Version* previous = current.exchange(next);
+
+    // Readers announcing a later epoch load the new version
+    uint64_t epoch = global_epoch.fetch_add(1);
+    retired.push_back(Retired{previous, epoch});
+}
+
+void edo::ConfigSource::notify(const ConfigMap& next, const ConfigMap& previous)
+{
+    // Call copies, so callbacks may subscribe and unsubscribe
+    std::vector<Subscription> targets;
+    {
+        std::lock_guard<std::mutex> lock(subscription_mutex);
+        for(const Subscription& subscription : subscriptions)
+        {
+            if(subscription.active)
+                targets.push_back(subscription);
+        }
+    }
+
+    for(const Subscription& subscription : targets)
+    {
+        std::unique_ptr<std::string> value = lookup(next, subscription.key);
+        std::unique_ptr<std::string> old = lookup(previous, subscription.key);
+
+        bool same = value && old ? *value == *old : !value && !old;
+        if(same)
+            continue;
+
+        // Callbacks run on the watcher thread, where an exception would
+        // terminate the process
+        try
+        {
+            subscription.callback(value.get(), old.get());
+        }
+        catch(...)
+        {
+            error_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void edo::ConfigSource::reclaim()
+{
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    for(std::size_t i = 0; i < MAX_READERS; i++)
+    {
+        uint64_t epoch = readers[i].epoch.value.load();
+        if(epoch != 0 && epoch < oldest)
+            oldest = epoch;
+    }
+
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < retired.size(); i++)
+    {
+        if(retired[i].epoch < oldest)
+            delete retired[i].version;
+        else
+            retired[kept++] = retired[i];
+    }
+
+    retired.resize(kept);
+}
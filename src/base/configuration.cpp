@@ -1,39 +1,105 @@
+#include <tuple>
+#include <cstring>
 #include <sstream>
+#include <utility>
 #include <stdexcept>
 
-#include "edo/base/misc.hpp"
 #include "edo/base/configuration.hpp"
+#include "edo/base/config_snapshot.hpp"
+
+edo::config_detail::Slot::~Slot()
+{
+
+}
 
 edo::ConfigMap::ConfigMap()
 {
     kv_map = std::map<std::string, std::string>();
 }
 
-void edo::ConfigMap::parse(const std::string& config_str)
+edo::ConfigMap::ConfigMap(const ConfigMap& other) : kv_map(other.kv_map)
 {
-    std::stringstream perLine;
-    std::string line;
-    perLine.str(config_str);
 
-    // Iterate each line
-    while(std::getline(perLine, line))
+}
+
+edo::ConfigMap& edo::ConfigMap::operator=(const ConfigMap& other)
+{
+    if(this != &other)
     {
-        if(line == "")
-            continue;
+        kv_map = other.kv_map;
+        refresh_all();
+    }
+
+    return *this;
+}
+
+void edo::ConfigMap::parse(const std::string& config_str)
+{
+    parse(config_str.data(), config_str.size());
+}
 
-        auto split_res = edo::split(line, '=');
+void edo::ConfigMap::parse(const char* config_str, const std::size_t length)
+{
+    const char* line = config_str;
+    const char* end = config_str + length;
 
-        if(split_res.size() == 2 && split_res[0] != "" &&
-            split_res[1] != "")
+    // Iterate each line, the last one may lack a newline
+    while(line < end)
+    {
+        const char* line_end = static_cast<const char*>(
+            std::memchr(line, '\n', end - line));
+        if(line_end == nullptr)
+            line_end = end;
+
+        if(line_end != line)
         {
-            kv_map.emplace(split_res[0], split_res[1]);
+            const char* separator = static_cast<const char*>(
+                std::memchr(line, '=', line_end - line));
+
+            // Exactly one separator with a non-empty key and value
+            if(separator == nullptr || separator == line ||
+                separator + 1 == line_end ||
+                std::memchr(separator + 1, '=', line_end - separator - 1))
+            {
+                throw std::runtime_error(MALFORMATTED_CONFIG_STR);
+            }
+
+            // Generated configs are mostly sorted, which makes the end
+            // the right place to insert
+            std::size_t size = kv_map.size();
+            auto it = kv_map.emplace_hint(kv_map.end(),
+                std::piecewise_construct,
+                std::forward_as_tuple(line, separator),
+                std::forward_as_tuple(separator + 1, line_end));
+
+            if(!slots.empty() && kv_map.size() != size)
+                refresh(it->first, &it->second);
         }
-        else
-            throw std::runtime_error(MALFORMATTED_CONFIG_STR);
+
+        line = line_end + 1;
     }
 }
 
-std::string edo::ConfigMap::serialize()
+void edo::ConfigMap::parse(const ConfigSnapshot& snapshot)
+{
+    // Snapshots are sorted, so every pair goes to the end of a fresh map
+    for(std::size_t i = 0; i < snapshot.size(); i++)
+    {
+        boost::string_view key = snapshot.key(i);
+        boost::string_view value = snapshot.value(i);
+
+        std::size_t size = kv_map.size();
+        auto it = kv_map.emplace_hint(kv_map.end(),
+            std::piecewise_construct,
+            std::forward_as_tuple(key.data(), key.size()),
+            std::forward_as_tuple(value.data(), value.size()));
+
+        if(!slots.empty() && kv_map.size() != size)
+            refresh(it->first, &it->second);
+    }
+}
+
+std::string edo::ConfigMap::serialize() const
 {
     std::stringstream out;
 
@@ -45,7 +111,22 @@ std::string edo::ConfigMap::serialize()
     return out.str();
 }
 
-std::size_t edo::ConfigMap::size()
+edo::Bytebuf edo::ConfigMap::serialize_snapshot() const
+{
+    return ConfigSnapshot::serialize(*this);
+}
+
+edo::ConfigMap::const_iterator edo::ConfigMap::begin() const
+{
+    return kv_map.begin();
+}
+
+edo::ConfigMap::const_iterator edo::ConfigMap::end() const
+{
+    return kv_map.end();
+}
+
+std::size_t edo::ConfigMap::size() const
 {
     return kv_map.size();
 }
@@ -53,34 +134,69 @@ std::size_t edo::ConfigMap::size()
 void edo::ConfigMap::clear()
 {
     kv_map.clear();
+    refresh_all();
 }
 
-bool edo::ConfigMap::has_key(const std::string& key)
+bool edo::ConfigMap::has_key(const std::string& key) const
 {
     auto val = kv_map.find(key);
     return val != kv_map.end();
 }
 
-std::string edo::ConfigMap::get(const std::string& key)
+std::string edo::ConfigMap::get(const std::string& key) const
 {
-    if(!has_key(key))
+    auto it = kv_map.find(key);
+    if(it == kv_map.end())
         throw std::out_of_range(NONEXISTANT_KEY);
 
-    return kv_map[key];
+    return it->second;
 }
 
 void edo::ConfigMap::put(const std::string& key, const std::string& value)
 {
-    if(has_key(key))
-        erase(key);
-
-    kv_map.emplace(key, value);
+    kv_map[key] = value;
+    refresh(key, &value);
 }
 
 void edo::ConfigMap::erase(const std::string& key)
 {
-    if(!has_key(key))
+    if(kv_map.erase(key) == 0)
         throw std::out_of_range(NONEXISTANT_KEY);
 
-    kv_map.erase(key);
+    refresh(key, nullptr);
+}
+
+void edo::ConfigMap::refresh(const std::string& key, const std::string* value)
+{
+    auto it = slots.find(key);
+    if(it == slots.end())
+        return;
+
+    std::vector<std::weak_ptr<config_detail::Slot>>& list = it->second;
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < list.size(); i++)
+    {
+        std::shared_ptr<config_detail::Slot> slot = list[i].lock();
+        if(!slot)
+            continue;
+
+        slot->update(value);
+        list[kept++] = list[i];
+    }
+
+    list.resize(kept);
+    if(kept == 0)
+        slots.erase(it);
+}
+
+void edo::ConfigMap::refresh_all()
+{
+    for(auto it = slots.begin(); it != slots.end();)
+    {
+        // Refreshing may drop the entry the iterator points to
+        auto current = it++;
+        auto value = kv_map.find(current->first);
+        refresh(current->first,
+            value != kv_map.end() ? &value->second : nullptr);
+    }
 }
@@ -0,0 +1,490 @@
+#include <limits>
+#include <exception>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/scheduler.hpp"
+#include "edo/base/coroutine.hpp"
+
+namespace
+{
+    /// Epoll data of the timer, never a valid coroutine id
+    const uint64_t TIMER_ID = std::numeric_limits<uint64_t>::max();
+
+    /// Amount of events taken from epoll per wait
+    const int MAX_EVENTS = 64;
+
+    /// Ids hold the slot of a coroutine in their low half and the
+    /// generation of the slot in their high half
+    const std::size_t SLOT_MASK = 0xFFFFFFFF;
+    const int GENERATION_SHIFT = 32;
+
+    /// Events which resume coroutines waiting to read or write
+    const uint32_t READ_EVENTS = EPOLLIN | EPOLLERR | EPOLLHUP;
+    const uint32_t WRITE_EVENTS = EPOLLOUT | EPOLLERR | EPOLLHUP;
+}
+
+edo::Await edo::Await::done()
+{
+    Await await = Await();
+    await.kind = Kind::done;
+    return await;
+}
+
+edo::Await edo::Await::tick()
+{
+    Await await = Await();
+    await.kind = Kind::tick;
+    return await;
+}
+
+edo::Await edo::Await::delay(const int64_t nanoseconds)
+{
+    Await await = Await();
+    await.kind = Kind::delay;
+    await.time = nanoseconds;
+    return await;
+}
+
+edo::Await edo::Await::readable(const int fd)
+{
+    Await await = Await();
+    await.kind = Kind::readable;
+    await.fd = fd;
+    return await;
+}
+
+edo::Await edo::Await::writable(const int fd)
+{
+    Await await = Await();
+    await.kind = Kind::writable;
+    await.fd = fd;
+    return await;
+}
+
+edo::Await edo::Await::until(const std::function<bool()>& predicate)
+{
+    Await await = Await();
+    await.kind = Kind::until;
+    await.predicate = predicate;
+    return await;
+}
+
+edo::Coroutine::~Coroutine()
+{
+
+}
+
+const std::size_t edo::CoroutineRunner::FramePool::MIN_SHIFT;
+const std::size_t edo::CoroutineRunner::FramePool::CLASSES;
+const std::size_t edo::CoroutineRunner::FramePool::CHUNK_BLOCKS;
+
+edo::CoroutineRunner::FramePool::FramePool()
+{
+    for(std::size_t i = 0; i < CLASSES; i++)
+        free_lists[i] = nullptr;
+}
+
+edo::CoroutineRunner::FramePool::~FramePool()
+{
+    for(void* chunk : chunks)
+        ::operator delete(chunk);
+}
+
+void* edo::CoroutineRunner::FramePool::allocate(const std::size_t size)
+{
+    std::size_t index = size_class(size);
+    if(index == CLASSES)
+        return ::operator new(size);
+
+    // Carve a new chunk into a list of free blocks
+    if(free_lists[index] == nullptr)
+    {
+        std::size_t block = std::size_t(1) << (MIN_SHIFT + index);
+        uint8_t* chunk = static_cast<uint8_t*>(
+            ::operator new(block * CHUNK_BLOCKS));
+        chunks.push_back(chunk);
+
+        for(std::size_t i = 0; i < CHUNK_BLOCKS; i++)
+        {
+            void* next = i + 1 < CHUNK_BLOCKS ? chunk + (i + 1) * block
+                : nullptr;
+            *reinterpret_cast<void**>(chunk + i * block) = next;
+        }
+
+        free_lists[index] = chunk;
+    }
+
+    void* frame = free_lists[index];
+    free_lists[index] = *reinterpret_cast<void**>(frame);
+    return frame;
+}
+
+void edo::CoroutineRunner::FramePool::deallocate(
+    void* frame,
+    const std::size_t size
+)
+{
+    std::size_t index = size_class(size);
+    if(index == CLASSES)
+    {
+        ::operator delete(frame);
+        return;
+    }
+
+    *reinterpret_cast<void**>(frame) = free_lists[index];
+    free_lists[index] = frame;
+}
+
+std::size_t edo::CoroutineRunner::FramePool::size_class(const std::size_t size)
+{
+    std::size_t index = 0;
+    while(index < CLASSES && (std::size_t(1) << (MIN_SHIFT + index)) < size)
+        index++;
+
+    return index;
+}
+
+edo::CoroutineRunner::CoroutineRunner() :
+    active_count(0), tick_count(0), armed(0)
+{
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if(epoll_fd < 0)
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(timer_fd < 0)
+    {
+        close(epoll_fd);
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = TIMER_ID;
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &event) != 0)
+    {
+        close(timer_fd);
+        close(epoll_fd);
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+}
+
+edo::CoroutineRunner::~CoroutineRunner()
+{
+    for(std::size_t slot : running)
+    {
+        if(entries[slot].coroutine != nullptr)
+            destroy(slot);
+    }
+
+    close(timer_fd);
+    close(epoll_fd);
+}
+
+void edo::CoroutineRunner::cancel(const std::size_t id)
+{
+    if(!active(id))
+        throw std::out_of_range(NONEXISTANT_COROUTINE);
+
+    destroy(id & SLOT_MASK);
+}
+
+bool edo::CoroutineRunner::active(const std::size_t id) const
+{
+    std::size_t slot = id & SLOT_MASK;
+    return slot < entries.size() && entries[slot].coroutine != nullptr &&
+        entries[slot].generation == id >> GENERATION_SHIFT;
+}
+
+std::size_t edo::CoroutineRunner::size() const
+{
+    return active_count;
+}
+
+std::size_t edo::CoroutineRunner::step()
+{
+    // Collect the events of the waited for file descriptors
+    epoll_event events[MAX_EVENTS];
+    int count = MAX_EVENTS;
+    while(count == MAX_EVENTS)
+    {
+        count = epoll_wait(epoll_fd, events, MAX_EVENTS, 0);
+        for(int i = 0; i < count; i++)
+        {
+            uint64_t data = events[i].data.u64;
+            if(data == TIMER_ID)
+            {
+                uint64_t expirations;
+                ssize_t result = read(timer_fd, &expirations,
+                    sizeof(expirations));
+                (void) result;
+            }
+            else if(data < watches.size())
+            {
+                if(watches[data].events == 0)
+                    fired.push_back(data);
+
+                watches[data].events |= events[i].events;
+            }
+        }
+    }
+
+    // Decide who runs before running anyone, so coroutines spawned or
+    // woken up by this step wait for the next one
+    int64_t now = TickScheduler::now();
+    resumable.clear();
+    for(std::size_t slot : running)
+    {
+        if(entries[slot].coroutine != nullptr && runnable(entries[slot], now))
+            resumable.push_back(slot);
+    }
+
+    std::size_t resumed = 0;
+    std::exception_ptr error;
+    for(std::size_t slot : resumable)
+    {
+        // An earlier coroutine of this step may have cancelled it
+        if(entries[slot].coroutine == nullptr)
+            continue;
+
+        unwatch(entries[slot]);
+        Coroutine* coroutine = entries[slot].coroutine;
+        try
+        {
+            Await wait = (*coroutine)();
+            resumed++;
+
+            if(wait.kind == Await::Kind::done || coroutine->is_complete())
+                destroy(slot);
+            else
+                suspend(slot, wait, now);
+        }
+        catch(...)
+        {
+            if(entries[slot].coroutine != nullptr)
+                destroy(slot);
+
+            if(!error)
+                error = std::current_exception();
+        }
+    }
+
+    // The one shot registrations of the reported descriptors are spent
+    for(int fd : fired)
+    {
+        watches[fd].events = 0;
+        rearm(fd);
+    }
+
+    fired.clear();
+
+    // Drop the finished coroutines and wake up for the earliest delay
+    int64_t earliest = 0;
+    std::size_t kept = 0;
+    tick_count = 0;
+    for(std::size_t i = 0; i < running.size(); i++)
+    {
+        std::size_t slot = running[i];
+        if(entries[slot].coroutine == nullptr)
+        {
+            free_slots.push_back(slot);
+            continue;
+        }
+
+        const Await& wait = entries[slot].wait;
+        if(wait.kind == Await::Kind::delay
+            && (earliest == 0 || wait.time < earliest))
+            earliest = wait.time;
+
+        if(wait.kind == Await::Kind::tick)
+            tick_count++;
+
+        running[kept++] = slot;
+    }
+
+    running.resize(kept);
+    arm(earliest);
+
+    if(error)
+        std::rethrow_exception(error);
+
+    return resumed;
+}
+
+bool edo::CoroutineRunner::pending() const
+{
+    return tick_count > 0;
+}
+
+int edo::CoroutineRunner::fd() const
+{
+    return epoll_fd;
+}
+
+std::size_t edo::CoroutineRunner::add(
+    Coroutine* coroutine,
+    const std::size_t size
+)
+{
+    // Slots are freed by the step dropping them from the running list, so
+    // a slot is never listed twice
+    std::size_t slot;
+    if(!free_slots.empty())
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    else
+    {
+        slot = entries.size();
+        entries.push_back(Entry());
+    }
+
+    Entry& entry = entries[slot];
+    entry.coroutine = coroutine;
+    entry.size = size;
+    entry.wait = Await::tick();
+
+    running.push_back(slot);
+    active_count++;
+    tick_count++;
+
+    return static_cast<std::size_t>(entry.generation) << GENERATION_SHIFT
+        | slot;
+}
+
+bool edo::CoroutineRunner::runnable(Entry& entry, const int64_t now)
+{
+    switch(entry.wait.kind)
+    {
+        case Await::Kind::delay:
+            return now >= entry.wait.time;
+
+        case Await::Kind::readable:
+            return (watches[entry.wait.fd].events & READ_EVENTS) != 0;
+
+        case Await::Kind::writable:
+            return (watches[entry.wait.fd].events & WRITE_EVENTS) != 0;
+
+        case Await::Kind::until:
+            return entry.wait.predicate();
+
+        default:
+            return true;
+    }
+}
+
+void edo::CoroutineRunner::suspend(
+    const std::size_t slot,
+    Await wait,
+    const int64_t now
+)
+{
+    if(wait.kind == Await::Kind::delay)
+        wait.time += now;
+
+    if(wait.kind == Await::Kind::readable || wait.kind == Await::Kind::writable)
+        watch(wait.fd, wait.kind);
+
+    entries[slot].wait = wait;
+}
+
+void edo::CoroutineRunner::watch(const int fd, const Await::Kind kind)
+{
+    if(fd < 0)
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+
+    if(static_cast<std::size_t>(fd) >= watches.size())
+        watches.resize(fd + 1, Watch());
+
+    std::size_t& waiting = kind == Await::Kind::readable
+        ? watches[fd].readers : watches[fd].writers;
+    waiting++;
+
+    if(!rearm(fd))
+    {
+        waiting--;
+        rearm(fd);
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+}
+
+void edo::CoroutineRunner::unwatch(Entry& entry)
+{
+    if(entry.wait.kind == Await::Kind::readable)
+    {
+        watches[entry.wait.fd].readers--;
+        rearm(entry.wait.fd);
+    }
+    else if(entry.wait.kind == Await::Kind::writable)
+    {
+        watches[entry.wait.fd].writers--;
+        rearm(entry.wait.fd);
+    }
+
+    entry.wait = Await::tick();
+}
+
+bool edo::CoroutineRunner::rearm(const int fd)
+{
+    Watch& watch = watches[fd];
+    if(watch.readers == 0 && watch.writers == 0)
+    {
+        if(watch.registered)
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+        watch.registered = false;
+        return true;
+    }
+
+    // One shot, so a ready descriptor does not wake up the loop again
+    // before its coroutines have run
+    uint32_t events = EPOLLONESHOT;
+    if(watch.readers > 0)
+        events |= EPOLLIN;
+
+    if(watch.writers > 0)
+        events |= EPOLLOUT;
+
+    epoll_event event = {};
+    event.events = events;
+    event.data.u64 = fd;
+
+    if(watch.registered && epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+        return true;
+
+    // Closing a descriptor drops its registration, a new one of the same
+    // number has to be added again
+    watch.registered = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+    return watch.registered;
+}
+
+void edo::CoroutineRunner::destroy(const std::size_t slot)
+{
+    Entry& entry = entries[slot];
+    unwatch(entry);
+
+    entry.coroutine->~Coroutine();
+    frames.deallocate(entry.coroutine, entry.size);
+    entry.coroutine = nullptr;
+    entry.generation++;
+    active_count--;
+}
+
+void edo::CoroutineRunner::arm(const int64_t deadline)
+{
+    if(deadline == armed)
+        return;
+
+    // A deadline of 0 disarms the timer, one in the past fires right away
+    itimerspec spec = {};
+    spec.it_value.tv_sec = deadline / 1000000000;
+    spec.it_value.tv_nsec = deadline % 1000000000;
+    timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    armed = deadline;
+}
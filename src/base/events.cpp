@@ -0,0 +1,325 @@
+#include <cerrno>
+#include <limits>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/events.hpp"
+
+namespace
+{
+    /// Epoll data of the interrupt eventfd, never a valid source id
+    const uint64_t INTERRUPT_ID = std::numeric_limits<uint64_t>::max();
+
+    /// Amount of events taken from epoll per wait
+    const std::size_t MAX_EVENTS = 64;
+
+    /// Ids hold the slot of a source in their low half and the generation
+    /// of the slot in their high half
+    const std::size_t SLOT_MASK = 0xFFFFFFFF;
+    const int GENERATION_SHIFT = 32;
+
+    /// Reads the counter of an eventfd or timerfd, 0 if nothing is pending
+    uint64_t drain(const int fd)
+    {
+        uint64_t count = 0;
+        if(read(fd, &count, sizeof(count)) != sizeof(count))
+            return 0;
+
+        return count;
+    }
+}
+
+edo::EventLoop::EventLoop() : stopping(false), ready(MAX_EVENTS), sources(0)
+{
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if(epoll_fd < 0)
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+
+    interrupt_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(interrupt_fd < 0)
+    {
+        close(epoll_fd);
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = INTERRUPT_ID;
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, interrupt_fd, &event) != 0)
+    {
+        close(interrupt_fd);
+        close(epoll_fd);
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+}
+
+edo::EventLoop::~EventLoop()
+{
+    for(Source& source : source_list)
+    {
+        if(source.active && source.kind != Kind::fd)
+            close(source.fd);
+    }
+
+    close(interrupt_fd);
+    close(epoll_fd);
+}
+
+std::size_t edo::EventLoop::watch(
+    const int fd,
+    const Callback& callback,
+    const uint32_t events
+)
+{
+    Source source = {};
+    source.kind = Kind::fd;
+    source.fd = fd;
+    source.callback = callback;
+
+    return add(source, events);
+}
+
+void edo::EventLoop::modify(const std::size_t id, const uint32_t events)
+{
+    if(!active(id) || source_list[id & SLOT_MASK].kind != Kind::fd)
+        throw std::out_of_range(NONEXISTANT_EVENT_SOURCE);
+
+    epoll_event event = {};
+    event.events = events;
+    event.data.u64 = id;
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, source_list[id & SLOT_MASK].fd,
+        &event) != 0)
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+}
+
+std::size_t edo::EventLoop::timer(
+    const int64_t interval,
+    const TimerCallback& callback,
+    const bool repeat
+)
+{
+    if(interval <= 0)
+        throw std::invalid_argument(INVALID_TIMER);
+
+    Source source = {};
+    source.kind = Kind::timer;
+    source.repeat = repeat;
+    source.timer_callback = callback;
+    source.fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(source.fd < 0)
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+
+    itimerspec spec = {};
+    spec.it_value.tv_sec = interval / 1000000000;
+    spec.it_value.tv_nsec = interval % 1000000000;
+    if(repeat)
+        spec.it_interval = spec.it_value;
+
+    if(timerfd_settime(source.fd, 0, &spec, nullptr) != 0)
+    {
+        close(source.fd);
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+
+    return add(source, EPOLLIN);
+}
+
+std::size_t edo::EventLoop::wakeup(const WakeupCallback& callback)
+{
+    Source source = {};
+    source.kind = Kind::wakeup;
+    source.wakeup_callback = callback;
+    source.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(source.fd < 0)
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+
+    return add(source, EPOLLIN);
+}
+
+void edo::EventLoop::notify(const std::size_t id)
+{
+    // The lock keeps the eventfd from being closed and reused meanwhile
+    std::lock_guard<std::mutex> lock(source_mutex);
+    if(!active(id) || source_list[id & SLOT_MASK].kind != Kind::wakeup)
+        throw std::out_of_range(NONEXISTANT_EVENT_SOURCE);
+
+    uint64_t one = 1;
+    ssize_t written = write(source_list[id & SLOT_MASK].fd, &one,
+        sizeof(one));
+    (void) written;
+}
+
+void edo::EventLoop::remove(const std::size_t id)
+{
+    std::lock_guard<std::mutex> lock(source_mutex);
+    if(!active(id))
+        throw std::out_of_range(NONEXISTANT_EVENT_SOURCE);
+
+    Source& source = source_list[id & SLOT_MASK];
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, source.fd, nullptr);
+    if(source.kind != Kind::fd)
+        close(source.fd);
+
+    source.active = false;
+    source.fd = -1;
+    source.callback = Callback();
+    source.timer_callback = TimerCallback();
+    source.wakeup_callback = WakeupCallback();
+    source.generation++;
+    free_slots.push_back(id & SLOT_MASK);
+    sources--;
+}
+
+bool edo::EventLoop::active(const std::size_t id) const
+{
+    std::size_t slot = id & SLOT_MASK;
+    return slot < source_list.size() && source_list[slot].active &&
+        source_list[slot].generation == id >> GENERATION_SHIFT;
+}
+
+std::size_t edo::EventLoop::size() const
+{
+    return sources;
+}
+
+std::size_t edo::EventLoop::poll(const int timeout)
+{
+    int count = epoll_wait(epoll_fd, ready.data(),
+        static_cast<int>(ready.size()), timeout);
+    if(count < 0)
+    {
+        if(errno == EINTR)
+            return 0;
+
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+
+    std::size_t dispatched = 0;
+    for(int i = 0; i < count; i++)
+    {
+        if(ready[i].data.u64 == INTERRUPT_ID)
+        {
+            drain(interrupt_fd);
+            continue;
+        }
+
+        std::size_t id = static_cast<std::size_t>(ready[i].data.u64);
+
+        // An earlier callback of this batch may have removed the source,
+        // or reused its slot for a new one
+        if(active(id))
+        {
+            if(dispatch(id, ready[i].events))
+                dispatched++;
+        }
+    }
+
+    return dispatched;
+}
+
+void edo::EventLoop::run()
+{
+    while(!stopping.load(std::memory_order_acquire))
+        poll();
+
+    stopping.store(false, std::memory_order_relaxed);
+}
+
+void edo::EventLoop::stop()
+{
+    stopping.store(true, std::memory_order_release);
+    interrupt();
+}
+
+void edo::EventLoop::interrupt()
+{
+    uint64_t one = 1;
+    ssize_t written = write(interrupt_fd, &one, sizeof(one));
+    (void) written;
+}
+
+std::size_t edo::EventLoop::add(Source& source, const uint32_t events)
+{
+    std::size_t slot = free_slots.empty() ? source_list.size()
+        : free_slots.back();
+    source.generation = slot < source_list.size()
+        ? source_list[slot].generation : 0;
+
+    // Events carry the whole id, so ones left over from a removed source
+    // do not reach the source reusing its slot
+    std::size_t id = static_cast<std::size_t>(source.generation)
+        << GENERATION_SHIFT | slot;
+
+    epoll_event event = {};
+    event.events = events;
+    event.data.u64 = id;
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, source.fd, &event) != 0)
+    {
+        if(source.kind != Kind::fd)
+            close(source.fd);
+
+        throw edo::EdoError(EVENT_LOOP_FAILED);
+    }
+
+    source.active = true;
+
+    std::lock_guard<std::mutex> lock(source_mutex);
+    if(slot < source_list.size())
+    {
+        source_list[slot] = source;
+        free_slots.pop_back();
+    }
+    else
+    {
+        source_list.push_back(source);
+    }
+
+    sources++;
+
+    return id;
+}
+
+bool edo::EventLoop::dispatch(const std::size_t id, const uint32_t events)
+{
+    // Copy the callbacks, as they may remove their own source
+    Source& source = source_list[id & SLOT_MASK];
+    switch(source.kind)
+    {
+        case Kind::fd:
+        {
+            Callback callback = source.callback;
+            callback(events);
+            return true;
+        }
+
+        case Kind::timer:
+        {
+            uint64_t expirations = drain(source.fd);
+            if(expirations == 0)
+                return false;
+
+            TimerCallback callback = source.timer_callback;
+            if(!source.repeat)
+                remove(id);
+
+            callback(expirations);
+            return true;
+        }
+
+        case Kind::wakeup:
+        {
+            if(drain(source.fd) == 0)
+                return false;
+
+            WakeupCallback callback = source.wakeup_callback;
+            callback();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -1,23 +1,16 @@
-#include <sstream>
+#include <fstream>
+#include <iterator>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
 #include "edo/base/misc.hpp"
+#include "edo/base/split.hpp"
 
 std::vector<std::string> edo::split(const std::string& str, const char delim)
 {
-    std::stringstream ss;
-    std::string line;
     std::vector<std::string> result;
-    ss.str(str);
-
-    if(str == "")
-    {
-        result.push_back("");
-        return result;
-    }
-
-    while(std::getline(ss, line, delim))
-    {
-        result.push_back(line);
-    }
+    for(boost::string_view token : split_view(str, delim))
+        result.emplace_back(token.data(), token.size());
 
     return result;
 }
@@ -36,3 +29,45 @@ uint8_t* edo::follow(
 
     return result;
 }
+
+std::vector<uint8_t> edo::read_file(const std::string& path)
+{
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if(!in)
+        throw edo::NotFoundError(FILE_NOT_FOUND);
+
+    return std::vector<uint8_t>(
+        (std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>()
+    );
+}
+
+void edo::write_file(
+    const std::string& path,
+    const uint8_t* data,
+    const std::size_t length
+)
+{
+    std::ofstream out(path,
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(data), length);
+
+    if(!out)
+        throw edo::EdoError(FILE_WRITE_FAILED);
+}
+
+uint64_t edo::fnv1a(
+    const uint8_t* data,
+    const std::size_t length,
+    uint64_t seed
+)
+{
+    uint64_t hash = seed;
+    for(std::size_t i = 0; i < length; i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
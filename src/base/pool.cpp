@@ -0,0 +1,295 @@
+#include <stdexcept>
+
+#include "edo/base/strings.hpp"
+#include "edo/base/pool.hpp"
+
+namespace
+{
+    /// The pool and the index of the worker running on this thread
+    thread_local edo::ThreadPool* current_pool = nullptr;
+    thread_local std::size_t current_worker = 0;
+
+    /// A task running on this thread, linked to the one it interrupted
+    struct Running
+    {
+        const edo::ThreadPool* pool;
+        const Running* previous;
+    };
+
+    thread_local const Running* running = nullptr;
+}
+
+edo::Task::Task()
+{
+
+}
+
+edo::Task::Task(const std::shared_ptr<State>& state) : state(state)
+{
+
+}
+
+bool edo::Task::done() const
+{
+    return !state || state->finished.load(std::memory_order_acquire);
+}
+
+void edo::Task::wait() const
+{
+    if(!state)
+        return;
+
+    while(!done())
+    {
+        if(!state->pool->run_one())
+            std::this_thread::yield();
+    }
+
+    if(state->error)
+        std::rethrow_exception(state->error);
+}
+
+edo::ThreadPool::ThreadPool(std::size_t threads) :
+    queued(0), unfinished(0), sleeping(0), next_worker(0), stopping(false)
+{
+    if(threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    if(threads == 0)
+        threads = 1;
+
+    for(std::size_t i = 0; i < threads; i++)
+        workers.emplace_back(new Worker());
+
+    // Start the threads once every queue exists, as they steal right away
+    for(std::size_t i = 0; i < threads; i++)
+        workers[i]->thread = std::thread(&ThreadPool::work, this, i);
+}
+
+edo::ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping.store(true);
+    }
+    sleep_condition.notify_all();
+
+    for(std::unique_ptr<Worker>& worker : workers)
+        worker->thread.join();
+}
+
+edo::Task edo::ThreadPool::spawn(const std::function<void()>& function)
+{
+    return spawn(function, std::vector<Task>());
+}
+
+edo::Task edo::ThreadPool::spawn(
+    const std::function<void()>& function,
+    const std::vector<Task>& dependencies
+)
+{
+    std::shared_ptr<Task::State> state = std::make_shared<Task::State>();
+    state->function = function;
+    state->pool = this;
+    state->finished.store(false, std::memory_order_relaxed);
+
+    // The extra count keeps dependencies finishing meanwhile from
+    // scheduling the task before every one of them is registered
+    state->dependencies.store(dependencies.size() + 1);
+    unfinished.fetch_add(1);
+
+    for(const Task& dependency : dependencies)
+    {
+        if(dependency.state)
+        {
+            std::lock_guard<std::mutex> lock(dependency.state->mutex);
+            if(!dependency.state->finished.load(std::memory_order_relaxed))
+            {
+                dependency.state->continuations.push_back(state);
+                continue;
+            }
+        }
+
+        state->dependencies.fetch_sub(1);
+    }
+
+    if(state->dependencies.fetch_sub(1) == 1)
+        schedule(state);
+
+    return Task(state);
+}
+
+edo::Task edo::ThreadPool::then(
+    const Task& task,
+    const std::function<void()>& function
+)
+{
+    return spawn(function, std::vector<Task>(1, task));
+}
+
+void edo::ThreadPool::wait()
+{
+    // The task would wait for itself to finish
+    for(const Running* task = running; task != nullptr; task = task->previous)
+    {
+        if(task->pool == this)
+            throw std::logic_error(WAIT_IN_TASK);
+    }
+
+    while(unfinished.load() > 0)
+    {
+        if(run_one())
+            continue;
+
+        // Tasks still queued are left to the workers
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_condition.wait(lock, [this]()
+        {
+            return unfinished.load() == 0;
+        });
+    }
+}
+
+bool edo::ThreadPool::run_one()
+{
+    std::size_t index = current_pool == this ? current_worker : workers.size();
+    std::shared_ptr<Task::State> state = take(index);
+    if(!state)
+        return false;
+
+    execute(state);
+    return true;
+}
+
+std::size_t edo::ThreadPool::size() const
+{
+    return workers.size();
+}
+
+std::size_t edo::ThreadPool::pending() const
+{
+    return unfinished.load();
+}
+
+void edo::ThreadPool::work(const std::size_t index)
+{
+    current_pool = this;
+    current_worker = index;
+
+    while(true)
+    {
+        std::shared_ptr<Task::State> state = take(index);
+        if(state)
+        {
+            execute(state);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+
+        // Announce the sleep before checking for work, schedule() checks
+        // for sleepers after queueing, so either side sees the other
+        sleeping.fetch_add(1);
+        sleep_condition.wait(lock, [this]()
+        {
+            return queued.load() > 0 || stopping.load();
+        });
+        sleeping.fetch_sub(1);
+
+        if(stopping.load() && queued.load() == 0)
+            return;
+    }
+}
+
+void edo::ThreadPool::schedule(const std::shared_ptr<Task::State>& state)
+{
+    // Workers keep their own tasks, other threads spread them evenly
+    std::size_t index = current_pool == this ? current_worker
+        : next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->queue.push_back(state);
+    }
+
+    queued.fetch_add(1);
+    if(sleeping.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        sleep_condition.notify_one();
+    }
+}
+
+void edo::ThreadPool::execute(const std::shared_ptr<Task::State>& state)
+{
+    Running task = {this, running};
+    running = &task;
+
+    try
+    {
+        state->function();
+    }
+    catch(...)
+    {
+        state->error = std::current_exception();
+    }
+
+    running = task.previous;
+
+    state->function = std::function<void()>();
+
+    std::vector<std::shared_ptr<Task::State>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished.store(true, std::memory_order_release);
+        continuations.swap(state->continuations);
+    }
+
+    for(std::shared_ptr<Task::State>& continuation : continuations)
+    {
+        if(continuation->dependencies.fetch_sub(1) == 1)
+            schedule(continuation);
+    }
+
+    if(unfinished.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        done_condition.notify_all();
+    }
+}
+
+std::shared_ptr<edo::Task::State> edo::ThreadPool::take(const std::size_t index)
+{
+    std::shared_ptr<Task::State> state;
+
+    // The newest task of the own queue is the most likely to be cached
+    if(index < workers.size())
+    {
+        Worker& worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if(!worker.queue.empty())
+        {
+            state = worker.queue.back();
+            worker.queue.pop_back();
+        }
+    }
+
+    // Steal the oldest task of another worker
+    for(std::size_t i = 1; !state && i <= workers.size(); i++)
+    {
+        Worker& victim = *workers[(index + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.queue.empty())
+        {
+            state = victim.queue.front();
+            victim.queue.pop_front();
+        }
+    }
+
+    if(state)
+        queued.fetch_sub(1);
+
+    return state;
+}
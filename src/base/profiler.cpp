@@ -0,0 +1,418 @@
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/scheduler.hpp"
+#include "edo/base/profiler.hpp"
+
+namespace
+{
+    /// Serial of the next profiler, 0 marks an empty cache
+    std::atomic<uint64_t> next_serial(1);
+
+    /// The slots the calling thread used last and their profiler
+    struct SlotCache
+    {
+        uint64_t serial;
+        void* slots;
+    };
+
+    thread_local SlotCache slot_cache = {0, nullptr};
+
+    /// Returns a string as a JSON string literal
+    std::string quote(const std::string& str)
+    {
+        std::string result = "\"";
+        for(char c : str)
+        {
+            if(c == '"' || c == '\\')
+            {
+                result += '\\';
+                result += c;
+            }
+            else if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                result += escaped;
+            }
+            else
+                result += c;
+        }
+
+        return result + "\"";
+    }
+
+    /// Formats nanoseconds as microseconds, the unit of trace events
+    std::string microseconds(const int64_t nanoseconds)
+    {
+        char formatted[32];
+        std::snprintf(formatted, sizeof(formatted), "%.3f",
+            nanoseconds / 1000.0);
+        return formatted;
+    }
+}
+
+const std::size_t edo::Profiler::MAX_METRICS;
+const std::size_t edo::Profiler::MAX_EVENTS;
+
+edo::Profiler::ThreadSlots::ThreadSlots() :
+    index(0), events(nullptr), event_count(0), dropped_count(0)
+{
+    for(std::size_t i = 0; i < MAX_METRICS; i++)
+    {
+        counters[i].store(0, std::memory_order_relaxed);
+        histograms[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+edo::Profiler::ThreadSlots::~ThreadSlots()
+{
+    for(std::size_t i = 0; i < MAX_METRICS; i++)
+        delete histograms[i].load();
+
+    delete[] events.load();
+}
+
+edo::Profiler::Profiler() :
+    serial(next_serial.fetch_add(1)), origin(TickScheduler::now()),
+    trace_enabled(false)
+{
+
+}
+
+edo::Profiler::~Profiler()
+{
+
+}
+
+edo::Profiler& edo::Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+std::size_t edo::Profiler::metric(const std::string& name, const Kind kind)
+{
+    std::lock_guard<std::mutex> lock(metric_mutex);
+
+    auto it = names.find(name);
+    if(it != names.end())
+    {
+        if(metrics[it->second].kind != kind)
+            throw std::invalid_argument(METRIC_KIND_MISMATCH);
+
+        return it->second;
+    }
+
+    if(metrics.size() == MAX_METRICS)
+        throw std::runtime_error(TOO_MANY_METRICS);
+
+    Metric registered;
+    registered.name = name;
+    registered.kind = kind;
+    metrics.push_back(registered);
+    names[name] = metrics.size() - 1;
+
+    return metrics.size() - 1;
+}
+
+void edo::Profiler::add(const std::size_t id, const uint64_t delta)
+{
+    if(id >= MAX_METRICS)
+        throw std::out_of_range(NONEXISTANT_METRIC);
+
+    // Only this thread writes the slot, so no locked instruction is needed
+    std::atomic<uint64_t>& counter = local().counters[id];
+    counter.store(counter.load(std::memory_order_relaxed) + delta,
+        std::memory_order_relaxed);
+}
+
+void edo::Profiler::record(const std::size_t id, const uint64_t value)
+{
+    if(id >= MAX_METRICS)
+        throw std::out_of_range(NONEXISTANT_METRIC);
+
+    local_histogram(id).record(value);
+}
+
+void edo::Profiler::time(
+    const std::size_t id,
+    const int64_t begin,
+    const int64_t end
+)
+{
+    if(id >= MAX_METRICS)
+        throw std::out_of_range(NONEXISTANT_METRIC);
+
+    int64_t duration = end > begin ? end - begin : 0;
+    local_histogram(id).record(duration);
+
+    if(!trace_enabled.load(std::memory_order_relaxed))
+        return;
+
+    ThreadSlots& slots = local();
+    Event* events = slots.events.load(std::memory_order_relaxed);
+    if(events == nullptr)
+    {
+        events = new Event[MAX_EVENTS];
+        slots.events.store(events, std::memory_order_release);
+    }
+
+    std::size_t n = slots.event_count.load(std::memory_order_relaxed);
+    if(n == MAX_EVENTS)
+    {
+        slots.dropped_count.store(
+            slots.dropped_count.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+        return;
+    }
+
+    // Readers take the events below the count, so publish it last
+    events[n].id = id;
+    events[n].begin = begin;
+    events[n].duration = duration;
+    slots.event_count.store(n + 1, std::memory_order_release);
+}
+
+void edo::Profiler::set_tracing(const bool enabled)
+{
+    trace_enabled.store(enabled);
+}
+
+bool edo::Profiler::tracing() const
+{
+    return trace_enabled.load();
+}
+
+uint64_t edo::Profiler::count(const std::size_t id) const
+{
+    kind(id);
+
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    uint64_t sum = 0;
+    for(const std::unique_ptr<ThreadSlots>& slots : threads)
+        sum += slots->counters[id].load(std::memory_order_relaxed);
+
+    return sum;
+}
+
+void edo::Profiler::merge(const std::size_t id, Histogram& histogram) const
+{
+    kind(id);
+
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    for(const std::unique_ptr<ThreadSlots>& slots : threads)
+    {
+        const Histogram* local = slots->histograms[id].load(
+            std::memory_order_acquire);
+        if(local != nullptr)
+            histogram.merge(*local);
+    }
+}
+
+uint64_t edo::Profiler::dropped() const
+{
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    uint64_t sum = 0;
+    for(const std::unique_ptr<ThreadSlots>& slots : threads)
+        sum += slots->dropped_count.load(std::memory_order_relaxed);
+
+    return sum;
+}
+
+void edo::Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    for(std::unique_ptr<ThreadSlots>& slots : threads)
+    {
+        for(std::size_t i = 0; i < MAX_METRICS; i++)
+        {
+            slots->counters[i].store(0, std::memory_order_relaxed);
+
+            Histogram* local = slots->histograms[i].load(
+                std::memory_order_acquire);
+            if(local != nullptr)
+                local->reset();
+        }
+
+        slots->event_count.store(0);
+        slots->dropped_count.store(0);
+    }
+}
+
+std::string edo::Profiler::json() const
+{
+    std::vector<Metric> registered;
+    {
+        std::lock_guard<std::mutex> lock(metric_mutex);
+        registered = metrics;
+    }
+
+    const Kind kinds[] = {Kind::counter, Kind::histogram, Kind::timer};
+    const char* sections[] = {"counters", "histograms", "timers"};
+
+    std::ostringstream out;
+    out << "{";
+    for(std::size_t k = 0; k < 3; k++)
+    {
+        out << (k == 0 ? "\n" : ",\n") << "  " << quote(sections[k]) << ": {";
+
+        bool first = true;
+        for(std::size_t id = 0; id < registered.size(); id++)
+        {
+            if(registered[id].kind != kinds[k])
+                continue;
+
+            out << (first ? "\n" : ",\n") << "    "
+                << quote(registered[id].name) << ": ";
+            first = false;
+
+            if(kinds[k] == Kind::counter)
+            {
+                out << count(id);
+                continue;
+            }
+
+            Histogram merged;
+            merge(id, merged);
+            out << "{\"count\": " << merged.count()
+                << ", \"sum\": " << merged.sum()
+                << ", \"mean\": " << static_cast<uint64_t>(merged.mean())
+                << ", \"p50\": " << merged.percentile(0.5)
+                << ", \"p90\": " << merged.percentile(0.9)
+                << ", \"p99\": " << merged.percentile(0.99)
+                << ", \"max\": " << merged.max() << "}";
+        }
+
+        out << (first ? "}" : "\n  }");
+    }
+
+    out << "\n}\n";
+    return out.str();
+}
+
+std::string edo::Profiler::trace() const
+{
+    std::vector<Metric> registered;
+    {
+        std::lock_guard<std::mutex> lock(metric_mutex);
+        registered = metrics;
+    }
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+    bool first = true;
+    pid_t pid = getpid();
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    for(const std::unique_ptr<ThreadSlots>& slots : threads)
+    {
+        std::size_t n = slots->event_count.load(std::memory_order_acquire);
+        const Event* events = slots->events.load(std::memory_order_acquire);
+
+        for(std::size_t i = 0; i < n && events != nullptr; i++)
+        {
+            const Event& event = events[i];
+            if(event.id >= registered.size())
+                continue;
+
+            out << (first ? "\n" : ",\n")
+                << "  {\"name\": " << quote(registered[event.id].name)
+                << ", \"cat\": \"edo\", \"ph\": \"X\", \"pid\": " << pid
+                << ", \"tid\": " << slots->index
+                << ", \"ts\": " << microseconds(event.begin - origin)
+                << ", \"dur\": " << microseconds(event.duration) << "}";
+            first = false;
+        }
+    }
+
+    out << "\n]}\n";
+    return out.str();
+}
+
+void edo::Profiler::save_json(const std::string& path) const
+{
+    std::string data = json();
+    edo::write_file(path, reinterpret_cast<const uint8_t*>(data.data()),
+        data.size());
+}
+
+void edo::Profiler::save_trace(const std::string& path) const
+{
+    std::string data = trace();
+    edo::write_file(path, reinterpret_cast<const uint8_t*>(data.data()),
+        data.size());
+}
+
+edo::Profiler::ThreadSlots& edo::Profiler::local()
+{
+    if(slot_cache.serial == serial)
+        return *static_cast<ThreadSlots*>(slot_cache.slots);
+
+    return attach();
+}
+
+edo::Profiler::ThreadSlots& edo::Profiler::attach()
+{
+    std::lock_guard<std::mutex> lock(thread_mutex);
+
+    // A thread switching between profilers finds its slots again
+    std::thread::id thread = std::this_thread::get_id();
+    ThreadSlots* found = nullptr;
+    for(std::unique_ptr<ThreadSlots>& slots : threads)
+    {
+        if(slots->thread == thread)
+            found = slots.get();
+    }
+
+    if(found == nullptr)
+    {
+        threads.emplace_back(new ThreadSlots());
+        found = threads.back().get();
+        found->thread = thread;
+        found->index = threads.size();
+    }
+
+    slot_cache.serial = serial;
+    slot_cache.slots = found;
+    return *found;
+}
+
+edo::Histogram& edo::Profiler::local_histogram(const std::size_t id)
+{
+    ThreadSlots& slots = local();
+    Histogram* histogram = slots.histograms[id].load(
+        std::memory_order_relaxed);
+
+    if(histogram == nullptr)
+    {
+        histogram = new Histogram();
+        slots.histograms[id].store(histogram, std::memory_order_release);
+    }
+
+    return *histogram;
+}
+
+edo::Profiler::Kind edo::Profiler::kind(const std::size_t id) const
+{
+    std::lock_guard<std::mutex> lock(metric_mutex);
+    if(id >= metrics.size())
+        throw std::out_of_range(NONEXISTANT_METRIC);
+
+    return metrics[id].kind;
+}
+
+edo::ScopedTimer::ScopedTimer(Profiler& profiler, const std::size_t id) :
+    profiler(profiler), id(id), begin(TickScheduler::now())
+{
+
+}
+
+edo::ScopedTimer::~ScopedTimer()
+{
+    profiler.time(id, begin, TickScheduler::now());
+}
@@ -0,0 +1,86 @@
+#include "edo/base/queue.hpp"
+
+edo::BufferQueue::BufferQueue(
+    const std::size_t capacity,
+    const std::size_t buffer_size
+) :
+    pool(capacity),
+    reserved(buffer_size),
+    free(capacity),
+    ready(capacity),
+    drop_count(0)
+{
+    // Both queues can hold every buffer, so moving a buffer between them
+    // never fails
+    for(std::size_t i = 0; i < pool.size(); i++)
+    {
+        pool[i].reserve(buffer_size);
+        free.push(static_cast<uint32_t>(i));
+    }
+}
+
+edo::Bytebuf* edo::BufferQueue::acquire()
+{
+    uint32_t index;
+    if(!free.pop(index))
+    {
+        drop_count.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return &pool[index];
+}
+
+void edo::BufferQueue::publish(Bytebuf* buffer)
+{
+    ready.push(static_cast<uint32_t>(buffer - pool.data()));
+}
+
+void edo::BufferQueue::release(Bytebuf* buffer)
+{
+    recycle(static_cast<uint32_t>(buffer - pool.data()));
+}
+
+bool edo::BufferQueue::push(const uint8_t* data, const std::size_t length)
+{
+    if(length > reserved)
+    {
+        drop_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Bytebuf* buffer = acquire();
+    if(buffer == nullptr)
+        return false;
+
+    buffer->put(data, length);
+    publish(buffer);
+
+    return true;
+}
+
+uint64_t edo::BufferQueue::dropped() const
+{
+    return drop_count.load(std::memory_order_relaxed);
+}
+
+std::size_t edo::BufferQueue::size() const
+{
+    return ready.size();
+}
+
+std::size_t edo::BufferQueue::capacity() const
+{
+    return pool.size();
+}
+
+std::size_t edo::BufferQueue::buffer_size() const
+{
+    return reserved;
+}
+
+void edo::BufferQueue::recycle(const uint32_t index)
+{
+    pool[index].clear();
+    free.push(index);
+}
@@ -0,0 +1,153 @@
+#include <ctime>
+#include <cerrno>
+#include <stdexcept>
+
+#include "edo/base/strings.hpp"
+#include "edo/base/scheduler.hpp"
+
+edo::TickScheduler::TickScheduler(const double rate)
+{
+    policy = OverrunPolicy::catch_up;
+    spin_window = 0;
+    tick_count = 0;
+    overrun_count = 0;
+    skip_count = 0;
+    origin = now();
+    next = 0;
+
+    set_rate(rate);
+}
+
+void edo::TickScheduler::set_rate(const double rate)
+{
+    if(!(rate > 0))
+        throw std::invalid_argument(INVALID_TICK_RATE);
+
+    // Restart the schedule at the next deadline of the old rate
+    if(next != 0)
+    {
+        origin = deadline(next);
+        next = 0;
+    }
+
+    tick_rate = rate;
+    period = 1e9 / rate;
+}
+
+double edo::TickScheduler::rate() const
+{
+    return tick_rate;
+}
+
+void edo::TickScheduler::set_overrun_policy(const OverrunPolicy policy)
+{
+    this->policy = policy;
+}
+
+edo::OverrunPolicy edo::TickScheduler::overrun_policy() const
+{
+    return policy;
+}
+
+void edo::TickScheduler::set_spin_window(const int64_t nanoseconds)
+{
+    spin_window = nanoseconds > 0 ? nanoseconds : 0;
+}
+
+void edo::TickScheduler::start()
+{
+    origin = now();
+    next = 0;
+    tick_count = 0;
+    overrun_count = 0;
+    skip_count = 0;
+}
+
+uint64_t edo::TickScheduler::wait()
+{
+    uint64_t skipped = 0;
+    int64_t target = deadline(next);
+    int64_t current = now();
+
+    // The first tick is due on start and cannot be late
+    if(next > 0 && current >= target)
+    {
+        overrun_count++;
+
+        // Skip every deadline which has already passed
+        if(policy == OverrunPolicy::skip)
+        {
+            uint64_t due = static_cast<uint64_t>((current - origin) / period) + 1;
+            if(due <= next)
+                due = next + 1;
+
+            skipped = due - next - 1;
+            skip_count += skipped;
+            next = due - 1;
+            target = deadline(next);
+        }
+    }
+
+    // Sleep until the spin window, then spin to the deadline
+    if(current < target)
+    {
+        int64_t wake = target - spin_window;
+        timespec ts;
+        ts.tv_sec = wake / 1000000000;
+        ts.tv_nsec = wake % 1000000000;
+
+        if(wake > current)
+        {
+            while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts,
+                nullptr) == EINTR)
+            {
+
+            }
+        }
+
+        while(spin_window > 0 && now() < target)
+        {
+            #if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+            #endif
+        }
+    }
+
+    next++;
+    tick_count++;
+
+    return skipped;
+}
+
+int64_t edo::TickScheduler::deadline() const
+{
+    return deadline(next);
+}
+
+uint64_t edo::TickScheduler::ticks() const
+{
+    return tick_count;
+}
+
+uint64_t edo::TickScheduler::overruns() const
+{
+    return overrun_count;
+}
+
+uint64_t edo::TickScheduler::skipped() const
+{
+    return skip_count;
+}
+
+int64_t edo::TickScheduler::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int64_t edo::TickScheduler::deadline(const uint64_t n) const
+{
+    // Fractional periods do not accumulate rounding errors, e.g. at 60 Hz
+    return origin + static_cast<int64_t>(n * period);
+}
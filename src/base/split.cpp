@@ -0,0 +1,146 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "edo/base/strings.hpp"
+#include "edo/base/split.hpp"
+
+edo::Splitter::iterator::iterator() : splitter(nullptr), next(nullptr)
+{
+
+}
+
+edo::Splitter::iterator::iterator(const Splitter* splitter) :
+    splitter(splitter), next(nullptr)
+{
+    take(splitter->str.data());
+}
+
+edo::Splitter::iterator::reference edo::Splitter::iterator::operator*() const
+{
+    return token;
+}
+
+edo::Splitter::iterator::pointer edo::Splitter::iterator::operator->() const
+{
+    return &token;
+}
+
+edo::Splitter::iterator& edo::Splitter::iterator::operator++()
+{
+    if(next == nullptr)
+    {
+        splitter = nullptr;
+        token = boost::string_view();
+    }
+    else
+        take(next);
+
+    return *this;
+}
+
+edo::Splitter::iterator edo::Splitter::iterator::operator++(int)
+{
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+bool edo::Splitter::iterator::operator==(const iterator& other) const
+{
+    return splitter == other.splitter && token.data() == other.token.data();
+}
+
+bool edo::Splitter::iterator::operator!=(const iterator& other) const
+{
+    return !(*this == other);
+}
+
+void edo::Splitter::iterator::take(const char* position)
+{
+    const char* end = splitter->str.data() + splitter->str.size();
+    const char* found = splitter->find(position);
+    if(found == nullptr)
+    {
+        token = boost::string_view(position, end - position);
+        next = nullptr;
+        return;
+    }
+
+    token = boost::string_view(position, found - position);
+    next = found + (splitter->delim.empty() ? 1 : splitter->delim.size());
+
+    // A trailing delimiter ends the last token rather than starting one
+    if(next == end)
+        next = nullptr;
+}
+
+edo::Splitter::Splitter(boost::string_view str, const char delim) :
+    str(str), delim(), single(delim)
+{
+
+}
+
+edo::Splitter::Splitter(boost::string_view str, boost::string_view delim) :
+    str(str), delim(delim), single(0)
+{
+    if(delim.empty())
+        throw std::invalid_argument(EMPTY_DELIMITER);
+
+    // Single characters take the plain memchr path
+    if(delim.size() == 1)
+    {
+        single = delim[0];
+        this->delim = boost::string_view();
+    }
+}
+
+edo::Splitter::iterator edo::Splitter::begin() const
+{
+    return iterator(this);
+}
+
+edo::Splitter::iterator edo::Splitter::end() const
+{
+    return iterator();
+}
+
+const char* edo::Splitter::find(const char* position) const
+{
+    const char* end = str.data() + str.size();
+    if(position == end)
+        return nullptr;
+
+    if(delim.empty())
+    {
+        return static_cast<const char*>(
+            std::memchr(position, single, end - position));
+    }
+
+    // Search for the first character with memchr and verify the rest in
+    // place, like the scanner does with its anchor byte
+    const char* last = end - delim.size();
+    while(position <= last)
+    {
+        const char* found = static_cast<const char*>(
+            std::memchr(position, delim[0], last - position + 1));
+        if(found == nullptr)
+            return nullptr;
+
+        if(std::memcmp(found + 1, delim.data() + 1, delim.size() - 1) == 0)
+            return found;
+
+        position = found + 1;
+    }
+
+    return nullptr;
+}
+
+edo::Splitter edo::split_view(boost::string_view str, const char delim)
+{
+    return Splitter(str, delim);
+}
+
+edo::Splitter edo::split_view(boost::string_view str, boost::string_view delim)
+{
+    return Splitter(str, delim);
+}
@@ -0,0 +1,251 @@
+#include <cmath>
+#include <sstream>
+
+#include "edo/base/stats.hpp"
+
+namespace
+{
+    /// Raises an atomic maximum to a given value
+    void raise(std::atomic<uint64_t>& maximum, const uint64_t value)
+    {
+        uint64_t current = maximum.load(std::memory_order_relaxed);
+        while(value > current && !maximum.compare_exchange_weak(current, value,
+            std::memory_order_relaxed))
+        {
+
+        }
+    }
+}
+
+const unsigned edo::Histogram::SUB_BITS;
+const std::size_t edo::Histogram::BUCKETS;
+
+edo::Histogram::Histogram()
+{
+    reset();
+}
+
+void edo::Histogram::record(const uint64_t value)
+{
+    buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    value_sum.fetch_add(value, std::memory_order_relaxed);
+    raise(value_max, value);
+}
+
+void edo::Histogram::reset()
+{
+    for(std::size_t i = 0; i < BUCKETS; i++)
+        buckets[i].store(0, std::memory_order_relaxed);
+
+    total.store(0, std::memory_order_relaxed);
+    value_sum.store(0, std::memory_order_relaxed);
+    value_max.store(0, std::memory_order_relaxed);
+}
+
+void edo::Histogram::merge(const Histogram& other)
+{
+    for(std::size_t i = 0; i < BUCKETS; i++)
+    {
+        uint64_t n = other.bucket_count(i);
+        if(n != 0)
+            buckets[i].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    total.fetch_add(other.count(), std::memory_order_relaxed);
+    value_sum.fetch_add(other.sum(), std::memory_order_relaxed);
+    raise(value_max, other.max());
+}
+
+uint64_t edo::Histogram::count() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+uint64_t edo::Histogram::sum() const
+{
+    return value_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t edo::Histogram::max() const
+{
+    return value_max.load(std::memory_order_relaxed);
+}
+
+double edo::Histogram::mean() const
+{
+    uint64_t n = count();
+    return n == 0 ? 0 : static_cast<double>(sum()) / n;
+}
+
+uint64_t edo::Histogram::percentile(const double fraction) const
+{
+    // Sum the buckets rather than trusting count(), which a concurrent
+    // record may have updated separately
+    uint64_t n = 0;
+    for(std::size_t i = 0; i < BUCKETS; i++)
+        n += bucket_count(i);
+
+    if(n == 0)
+        return 0;
+
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * n));
+    if(rank < 1)
+        rank = 1;
+
+    uint64_t seen = 0;
+    for(std::size_t i = 0; i < BUCKETS; i++)
+    {
+        seen += bucket_count(i);
+        if(seen >= rank)
+        {
+            // The largest value is exact, the bucket bound is not
+            uint64_t upper = bucket_upper(i);
+            uint64_t largest = max();
+            return largest != 0 && largest < upper ? largest : upper;
+        }
+    }
+
+    return max();
+}
+
+uint64_t edo::Histogram::bucket_count(const std::size_t index) const
+{
+    return buckets[index].load(std::memory_order_relaxed);
+}
+
+std::size_t edo::Histogram::bucket(const uint64_t value)
+{
+    // Values below the first power of two split get a bucket each
+    if(value < (1ull << SUB_BITS))
+        return static_cast<std::size_t>(value);
+
+    unsigned magnitude = 63 - __builtin_clzll(value);
+    unsigned shift = magnitude - SUB_BITS;
+
+    return (static_cast<std::size_t>(shift + 1) << SUB_BITS)
+        + static_cast<std::size_t>((value >> shift) & ((1u << SUB_BITS) - 1));
+}
+
+uint64_t edo::Histogram::bucket_lower(const std::size_t index)
+{
+    if(index < (1u << SUB_BITS))
+        return index;
+
+    unsigned shift = static_cast<unsigned>(index >> SUB_BITS) - 1;
+    uint64_t sub = index & ((1u << SUB_BITS) - 1);
+
+    return ((1ull << SUB_BITS) + sub) << shift;
+}
+
+uint64_t edo::Histogram::bucket_upper(const std::size_t index)
+{
+    if(index < (1u << SUB_BITS))
+        return index;
+
+    unsigned shift = static_cast<unsigned>(index >> SUB_BITS) - 1;
+    return bucket_lower(index) + ((1ull << shift) - 1);
+}
+
+edo::TickStats::TickStats() : threshold(1000000)
+{
+    reset();
+}
+
+void edo::TickStats::record(
+    const int64_t duration,
+    const int64_t lateness,
+    const bool overrun
+)
+{
+    duration_histogram.record(duration > 0 ? duration : 0);
+
+    // The lateness of an overrun is the backlog, not the wakeup
+    if(overrun)
+        overrun_count.fetch_add(1, std::memory_order_relaxed);
+    else if(lateness > 0)
+    {
+        raise(lateness_max, lateness);
+        if(lateness > threshold.load(std::memory_order_relaxed))
+            late_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void edo::TickStats::set_late_threshold(const int64_t nanoseconds)
+{
+    threshold.store(nanoseconds, std::memory_order_relaxed);
+}
+
+int64_t edo::TickStats::late_threshold() const
+{
+    return threshold.load(std::memory_order_relaxed);
+}
+
+void edo::TickStats::reset()
+{
+    duration_histogram.reset();
+    overrun_count.store(0, std::memory_order_relaxed);
+    late_count.store(0, std::memory_order_relaxed);
+    lateness_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t edo::TickStats::ticks() const
+{
+    return duration_histogram.count();
+}
+
+uint64_t edo::TickStats::overruns() const
+{
+    return overrun_count.load(std::memory_order_relaxed);
+}
+
+uint64_t edo::TickStats::late_wakeups() const
+{
+    return late_count.load(std::memory_order_relaxed);
+}
+
+uint64_t edo::TickStats::max_lateness() const
+{
+    return lateness_max.load(std::memory_order_relaxed);
+}
+
+uint64_t edo::TickStats::max() const
+{
+    return duration_histogram.max();
+}
+
+uint64_t edo::TickStats::p99() const
+{
+    return duration_histogram.percentile(0.99);
+}
+
+const edo::Histogram& edo::TickStats::durations() const
+{
+    return duration_histogram;
+}
+
+std::string edo::TickStats::str() const
+{
+    std::ostringstream out;
+    out << "ticks " << ticks() << ", overruns " << overruns()
+        << ", late wakeups " << late_wakeups()
+        << ", max lateness " << max_lateness() << " ns\n";
+    out << "duration ns: mean " << static_cast<uint64_t>(durations().mean())
+        << ", p50 " << durations().percentile(0.5)
+        << ", p90 " << durations().percentile(0.9)
+        << ", p99 " << p99()
+        << ", p99.9 " << durations().percentile(0.999)
+        << ", max " << max() << "\n";
+
+    for(std::size_t i = 0; i < Histogram::BUCKETS; i++)
+    {
+        uint64_t n = durations().bucket_count(i);
+        if(n == 0)
+            continue;
+
+        out << "  " << Histogram::bucket_lower(i) << " - "
+            << Histogram::bucket_upper(i) << ": " << n << "\n";
+    }
+
+    return out.str();
+}
@@ -0,0 +1,494 @@
+#include <map>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/base/profiler.hpp"
+#include "edo/mem/region.hpp"
+#include "edo/scan/x86.hpp"
+#include "edo/hook/hook.hpp"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+namespace
+{
+    /// The size of a jmp rel32
+    const std::size_t JMP_SIZE = 5;
+
+    /// The size of a jmp [rip+0] followed by its 8 byte target
+    const std::size_t ABS_JMP_SIZE = 14;
+
+    /// The size of the longest form a branch is relocated to
+    const std::size_t MAX_BRANCH_SIZE = 16;
+
+    /// The offset of the trampoline within a slot, the slot starts with
+    /// an absolute jump to the detour
+    const std::size_t TRAMPOLINE_OFFSET = 16;
+
+    /// The lowest and highest address a chunk may be mapped at
+    const uintptr_t MIN_ADDRESS = 0x10000;
+    const uintptr_t MAX_ADDRESS = 0x7FFFFFFF0000ULL;
+
+    /// The reach of a rel32 operand, minus a chunk so that any byte of a
+    /// chunk is in reach of any byte near the requested address
+    const uintptr_t REACH = 0x80000000ULL - 2 * EDO_ARENA_CHUNK_SIZE;
+
+    bool reachable(uintptr_t from, uintptr_t to)
+    {
+        int64_t distance = static_cast<int64_t>(to - from);
+        return distance >= INT32_MIN && distance <= INT32_MAX;
+    }
+
+    uint8_t* put_rel32(uint8_t* out, uint8_t opcode, uintptr_t target)
+    {
+        int32_t rel = static_cast<int32_t>(
+            target - (reinterpret_cast<uintptr_t>(out) + JMP_SIZE));
+
+        out[0] = opcode;
+        std::memcpy(out + 1, &rel, sizeof(rel));
+        return out + JMP_SIZE;
+    }
+
+    uint8_t* put_abs_jmp(uint8_t* out, uintptr_t target)
+    {
+        const uint8_t jmp[] = {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+        std::memcpy(out, jmp, sizeof(jmp));
+        std::memcpy(out + sizeof(jmp), &target, sizeof(target));
+        return out + ABS_JMP_SIZE;
+    }
+
+    int protection(const edo::Region& region)
+    {
+        return (region.readable ? PROT_READ : 0) |
+            (region.writable ? PROT_WRITE : 0) |
+            (region.executable ? PROT_EXEC : 0);
+    }
+}
+
+edo::TrampolineArena::TrampolineArena()
+{
+
+}
+
+edo::TrampolineArena::~TrampolineArena()
+{
+    for(Chunk& chunk : chunk_list)
+        munmap(chunk.begin, EDO_ARENA_CHUNK_SIZE);
+}
+
+uint8_t* edo::TrampolineArena::allocate(const uintptr_t near)
+{
+    for(Chunk& chunk : chunk_list)
+    {
+        uintptr_t begin = reinterpret_cast<uintptr_t>(chunk.begin);
+        if(!chunk.free.empty() && reachable(near, begin) &&
+            reachable(near, begin + EDO_ARENA_CHUNK_SIZE))
+        {
+            uint8_t* slot = chunk.free.back();
+            chunk.free.pop_back();
+            return slot;
+        }
+    }
+
+    Chunk& chunk = map_chunk(near);
+    uint8_t* slot = chunk.free.back();
+    chunk.free.pop_back();
+
+    return slot;
+}
+
+void edo::TrampolineArena::release(uint8_t* slot)
+{
+    for(Chunk& chunk : chunk_list)
+    {
+        if(slot >= chunk.begin && slot < chunk.begin + EDO_ARENA_CHUNK_SIZE)
+        {
+            std::memset(slot, 0xCC, EDO_TRAMPOLINE_SIZE);
+            chunk.free.push_back(slot);
+            return;
+        }
+    }
+}
+
+std::size_t edo::TrampolineArena::chunks() const
+{
+    return chunk_list.size();
+}
+
+edo::TrampolineArena::Chunk& edo::TrampolineArena::map_chunk(
+    const uintptr_t near
+)
+{
+    uintptr_t low = near > MIN_ADDRESS + REACH ? near - REACH : MIN_ADDRESS;
+    uintptr_t high = near < MAX_ADDRESS - REACH ? near + REACH : MAX_ADDRESS;
+    uintptr_t mask = ~static_cast<uintptr_t>(EDO_ARENA_CHUNK_SIZE - 1);
+
+    // Collect the chunk aligned address closest to the target in every
+    // unmapped gap within reach
+    RegionTable regions = RegionTable::load();
+    std::vector<std::pair<uintptr_t, uintptr_t>> candidates;
+    uintptr_t gap_begin = MIN_ADDRESS;
+
+    for(std::size_t i = 0; i <= regions.size(); i++)
+    {
+        uintptr_t gap_end = i < regions.size() ?
+            regions.regions()[i].begin : MAX_ADDRESS;
+
+        uintptr_t first = std::max(gap_begin, low);
+        first = (first + EDO_ARENA_CHUNK_SIZE - 1) & mask;
+        uintptr_t last = std::min(gap_end, high);
+
+        if(first < last && last - first >= EDO_ARENA_CHUNK_SIZE)
+        {
+            last = (last - EDO_ARENA_CHUNK_SIZE) & mask;
+            uintptr_t best = near < first ? first :
+                near > last ? last : (near & mask);
+            uintptr_t distance = best > near ? best - near : near - best;
+            candidates.push_back(std::make_pair(distance, best));
+        }
+
+        if(i < regions.size())
+            gap_begin = std::max(gap_begin, regions.regions()[i].end);
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for(const auto& candidate : candidates)
+    {
+        void* hint = reinterpret_cast<void*>(candidate.second);
+        void* mapped = mmap(hint, EDO_ARENA_CHUNK_SIZE,
+            PROT_READ | PROT_WRITE | PROT_EXEC,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+        if(mapped == MAP_FAILED)
+            continue;
+
+        // Kernels without MAP_FIXED_NOREPLACE treat the address as a hint
+        if(mapped != hint)
+        {
+            munmap(mapped, EDO_ARENA_CHUNK_SIZE);
+            continue;
+        }
+
+        Chunk chunk;
+        chunk.begin = static_cast<uint8_t*>(mapped);
+        std::memset(chunk.begin, 0xCC, EDO_ARENA_CHUNK_SIZE);
+
+        for(std::size_t i = EDO_ARENA_CHUNK_SIZE; i > 0; i -= EDO_TRAMPOLINE_SIZE)
+            chunk.free.push_back(chunk.begin + i - EDO_TRAMPOLINE_SIZE);
+
+        chunk_list.push_back(chunk);
+        return chunk_list.back();
+    }
+
+    throw edo::EdoError(ARENA_EXHAUSTED);
+}
+
+edo::HookEngine::HookEngine()
+{
+
+}
+
+edo::HookEngine::~HookEngine()
+{
+    for(Hook& hook : hooks)
+        hook.enabled = false;
+
+    try
+    {
+        commit();
+    }
+    catch(const std::exception&)
+    {
+
+    }
+}
+
+std::size_t edo::HookEngine::hook(void* target, void* detour)
+{
+    for(const Hook& hook : hooks)
+    {
+        if(hook.target == target && (!hook.removed || hook.applied))
+            throw std::runtime_error(ALREADY_HOOKED);
+    }
+
+    Hook hook;
+    hook.target = static_cast<uint8_t*>(target);
+    hook.detour = static_cast<uint8_t*>(detour);
+    hook.slot = arena.allocate(reinterpret_cast<uintptr_t>(target));
+    hook.enabled = true;
+    hook.applied = false;
+    hook.removed = false;
+
+    try
+    {
+        relocate(hook);
+    }
+    catch(...)
+    {
+        arena.release(hook.slot);
+        throw;
+    }
+
+    hooks.push_back(hook);
+    return hooks.size() - 1;
+}
+
+void edo::HookEngine::unhook(const std::size_t id)
+{
+    if(id >= hooks.size() || hooks[id].removed)
+        throw std::out_of_range(NONEXISTANT_HOOK);
+
+    hooks[id].enabled = false;
+    hooks[id].removed = true;
+}
+
+void edo::HookEngine::commit()
+{
+    EDO_PROFILE_SCOPE("hook.commit");
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t page_mask = ~static_cast<uintptr_t>(page_size - 1);
+
+    std::vector<Hook*> pending;
+    for(Hook& hook : hooks)
+    {
+        if(hook.enabled != hook.applied)
+            pending.push_back(&hook);
+    }
+
+    if(pending.empty())
+        return;
+
+    // Gather the protection of every page to patch, then make runs of
+    // pages with equal protection writable with one call each
+    RegionTable regions = RegionTable::load();
+    std::map<uintptr_t, int> pages;
+    for(Hook* hook : pending)
+    {
+        uintptr_t begin = reinterpret_cast<uintptr_t>(hook->target);
+        for(uintptr_t page = begin & page_mask;
+            page < begin + hook->length; page += page_size)
+        {
+            const Region* region = regions.find(page);
+            if(region == nullptr)
+                throw edo::EdoError(MEMOP_FAILED);
+
+            pages[page] = protection(*region);
+        }
+    }
+
+    std::vector<std::pair<uintptr_t, std::pair<std::size_t, int>>> runs;
+    for(const auto& page : pages)
+    {
+        if(!runs.empty() && runs.back().second.second == page.second &&
+            runs.back().first + runs.back().second.first == page.first)
+        {
+            runs.back().second.first += page_size;
+        }
+        else
+            runs.push_back(std::make_pair(page.first,
+                std::make_pair(static_cast<std::size_t>(page_size), page.second)));
+    }
+
+    std::size_t unlocked = 0;
+    for(; unlocked < runs.size(); unlocked++)
+    {
+        const auto& run = runs[unlocked];
+        if(mprotect(reinterpret_cast<void*>(run.first), run.second.first,
+            run.second.second | PROT_WRITE) != 0)
+        {
+            break;
+        }
+    }
+
+    if(unlocked == runs.size())
+    {
+        for(Hook* hook : pending)
+        {
+            uint8_t patch[sizeof(hook->original)];
+            if(hook->enabled)
+            {
+                // Jump straight to the detour if it is in reach
+                uintptr_t end = reinterpret_cast<uintptr_t>(hook->target) + JMP_SIZE;
+                uintptr_t detour = reinterpret_cast<uintptr_t>(hook->detour);
+                if(!reachable(end, detour))
+                    detour = reinterpret_cast<uintptr_t>(hook->slot);
+
+                int32_t rel = static_cast<int32_t>(detour - end);
+                patch[0] = 0xE9;
+                std::memcpy(patch + 1, &rel, sizeof(rel));
+                std::memset(patch + JMP_SIZE, 0x90, hook->length - JMP_SIZE);
+            }
+            else
+                std::memcpy(patch, hook->original, hook->length);
+
+            std::memcpy(hook->target, patch, hook->length);
+            hook->applied = hook->enabled;
+        }
+    }
+
+    for(std::size_t i = 0; i < unlocked; i++)
+    {
+        mprotect(reinterpret_cast<void*>(runs[i].first), runs[i].second.first,
+            runs[i].second.second);
+    }
+
+    if(unlocked != runs.size())
+        throw edo::EdoError(MEMOP_FAILED);
+}
+
+void* edo::HookEngine::original(const std::size_t id) const
+{
+    if(id >= hooks.size() || hooks[id].removed)
+        throw std::out_of_range(NONEXISTANT_HOOK);
+
+    return hooks[id].slot + TRAMPOLINE_OFFSET;
+}
+
+bool edo::HookEngine::active(const std::size_t id) const
+{
+    if(id >= hooks.size() || hooks[id].removed)
+        throw std::out_of_range(NONEXISTANT_HOOK);
+
+    return hooks[id].applied;
+}
+
+std::size_t edo::HookEngine::size() const
+{
+    std::size_t count = 0;
+    for(const Hook& hook : hooks)
+    {
+        if(!hook.removed)
+            count++;
+    }
+
+    return count;
+}
+
+void edo::HookEngine::relocate(Hook& hook)
+{
+    put_abs_jmp(hook.slot, reinterpret_cast<uintptr_t>(hook.detour));
+
+    uint8_t* begin = hook.slot + TRAMPOLINE_OFFSET;
+    uint8_t* end = hook.slot + EDO_TRAMPOLINE_SIZE;
+    uint8_t* out = begin;
+    uintptr_t source = reinterpret_cast<uintptr_t>(hook.target);
+    std::size_t length = 0;
+
+    // Whole instructions are relocated until the jump to the detour fits,
+    // find out how many before relocating any
+    while(length < JMP_SIZE)
+    {
+        Instruction instruction = edo::decode(hook.target + length);
+        if(instruction.length == 0)
+            throw edo::EdoError(HOOK_FAILED);
+
+        // Code after a return or jump may belong to another function
+        bool last = (instruction.map == 0 && !instruction.vex &&
+            (instruction.opcode == 0xC3 || instruction.opcode == 0xC2 ||
+            instruction.opcode == 0xE9 || instruction.opcode == 0xEB ||
+            instruction.opcode == 0xCC || (instruction.opcode == 0xFF &&
+            ((instruction.modrm >> 3) & 0x07) == 4)));
+        if(last && length + instruction.length < JMP_SIZE)
+            throw edo::EdoError(HOOK_FAILED);
+
+        length += instruction.length;
+    }
+
+    for(std::size_t offset = 0; offset < length;)
+    {
+        const uint8_t* code = hook.target + offset;
+        Instruction instruction = edo::decode(code);
+
+        uintptr_t address = source + offset;
+        uintptr_t target = instruction.target(address);
+
+        if(!instruction.has_target())
+        {
+            if(out + instruction.length > end)
+                throw edo::EdoError(HOOK_FAILED);
+
+            std::memcpy(out, code, instruction.length);
+            out += instruction.length;
+        }
+        else if(!instruction.branch())
+        {
+            // Rebase the RIP-relative memory operand
+            uintptr_t moved = reinterpret_cast<uintptr_t>(out);
+            if(out + instruction.length > end ||
+                !reachable(moved + instruction.length, target))
+            {
+                throw edo::EdoError(HOOK_FAILED);
+            }
+
+            int32_t rel = static_cast<int32_t>(target - (moved + instruction.length));
+            std::memcpy(out, code, instruction.length);
+            std::memcpy(out + instruction.relative_offset, &rel, sizeof(rel));
+            out += instruction.length;
+        }
+        else
+        {
+            // Branches into the overwritten bytes cannot be relocated,
+            // which are all relocated bytes as the rest is filled with nops
+            if(target >= source && target < source + length)
+                throw edo::EdoError(HOOK_FAILED);
+
+            bool call = instruction.map == 0 && instruction.opcode == 0xE8;
+            bool jmp = instruction.map == 0 &&
+                (instruction.opcode == 0xE9 || instruction.opcode == 0xEB);
+            bool jcc = (instruction.map == 0 && instruction.opcode >= 0x70 &&
+                instruction.opcode <= 0x7F) || instruction.map == 1;
+
+            // loop, jrcxz and xbegin have no long form
+            if((!call && !jmp && !jcc) || out + MAX_BRANCH_SIZE > end)
+                throw edo::EdoError(HOOK_FAILED);
+
+            uint8_t condition = instruction.opcode & 0x0F;
+            uintptr_t moved = reinterpret_cast<uintptr_t>(out);
+
+            if(call && reachable(moved + JMP_SIZE, target))
+                out = put_rel32(out, 0xE8, target);
+            else if(call)
+            {
+                // call [rip+2], jmp over the target
+                const uint8_t abs_call[] = {0xFF, 0x15, 0x02, 0x00, 0x00,
+                    0x00, 0xEB, 0x08};
+                std::memcpy(out, abs_call, sizeof(abs_call));
+                std::memcpy(out + sizeof(abs_call), &target, sizeof(target));
+                out += sizeof(abs_call) + sizeof(target);
+            }
+            else if(jmp && reachable(moved + JMP_SIZE, target))
+                out = put_rel32(out, 0xE9, target);
+            else if(jmp)
+                out = put_abs_jmp(out, target);
+            else if(reachable(moved + JMP_SIZE + 1, target))
+            {
+                out[0] = 0x0F;
+                out = put_rel32(out + 1, 0x80 | condition, target);
+            }
+            else
+            {
+                // Skip the absolute jump if the inverted condition holds
+                out[0] = 0x70 | (condition ^ 1);
+                out[1] = ABS_JMP_SIZE;
+                out = put_abs_jmp(out + 2, target);
+            }
+        }
+
+        offset += instruction.length;
+    }
+
+    if(out + JMP_SIZE > end)
+        throw edo::EdoError(HOOK_FAILED);
+
+    put_rel32(out, 0xE9, source + length);
+
+    hook.length = length;
+    std::memcpy(hook.original, hook.target, length);
+}
@@ -0,0 +1,432 @@
+#include <atomic>
+#include <ctime>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/ipc/channel.hpp"
+
+namespace
+{
+    const uint32_t CHANNEL_MAGIC = 0x43484445; // "EDHC"
+    const uint32_t CHANNEL_VERSION = 1;
+
+    /// Records start with their length and flags and are 8 byte aligned
+    const std::size_t RECORD_HEADER = 8;
+    const uint32_t RECORD_PADDING = 1;
+
+    /// The ring starts one page into the mapping
+    const std::size_t RING_OFFSET = 4096;
+
+    /// Checks before a side goes to sleep, spinning only helps if the
+    /// other side runs on another CPU meanwhile
+    const int SPIN_COUNT = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? 2000 : 0;
+
+    struct RecordHeader
+    {
+        uint32_t length;
+        uint32_t flags;
+    };
+
+    std::size_t record_size(std::size_t length)
+    {
+        return (RECORD_HEADER + length + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    void pause()
+    {
+        #if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+        #endif
+    }
+
+    long futex(std::atomic<uint32_t>* word, int op, uint32_t value,
+        const timespec* timeout)
+    {
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op,
+            value, timeout, nullptr, 0);
+    }
+
+    int64_t now_ns()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    /// Spins, then sleeps on a futex word until ready() holds
+    template<typename F>
+    bool block(std::atomic<uint32_t>& waiting, int timeout_ms, F ready)
+    {
+        for(int i = 0; i < SPIN_COUNT; i++)
+        {
+            if(ready())
+                return true;
+
+            pause();
+        }
+
+        if(timeout_ms == 0)
+            return ready();
+
+        int64_t deadline = now_ns() + static_cast<int64_t>(timeout_ms) * 1000000;
+        while(true)
+        {
+            // Announce the sleep before the last check, the other side
+            // checks the flag after publishing
+            waiting.store(1, std::memory_order_seq_cst);
+            if(ready())
+            {
+                waiting.store(0, std::memory_order_relaxed);
+                return true;
+            }
+
+            timespec remaining;
+            timespec* timeout = nullptr;
+            if(timeout_ms >= 0)
+            {
+                int64_t left = deadline - now_ns();
+                if(left <= 0)
+                {
+                    waiting.store(0, std::memory_order_relaxed);
+                    return ready();
+                }
+
+                remaining.tv_sec = left / 1000000000;
+                remaining.tv_nsec = left % 1000000000;
+                timeout = &remaining;
+            }
+
+            futex(&waiting, FUTEX_WAIT, 1, timeout);
+            waiting.store(0, std::memory_order_relaxed);
+
+            if(ready())
+                return true;
+        }
+    }
+
+    /// Wakes the other side if it announced a sleep
+    void wake(std::atomic<uint32_t>& waiting)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiting.load(std::memory_order_relaxed) != 0)
+        {
+            waiting.store(0, std::memory_order_relaxed);
+            futex(&waiting, FUTEX_WAKE, INT_MAX, nullptr);
+        }
+    }
+}
+
+/// The control block at the start of the shared mapping
+struct edo::Channel::Shared
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+
+    /// Written by the producer only
+    alignas(64) std::atomic<uint64_t> head;
+
+    /// Written by the consumer only
+    alignas(64) std::atomic<uint64_t> tail;
+
+    /// Futex words set by a side before it sleeps
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+    alignas(64) std::atomic<uint32_t> producer_waiting;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+    "Channels need lock-free 64-bit atomics to work across processes");
+
+edo::Channel::Channel()
+{
+    memfd = -1;
+    shared = nullptr;
+    ring = nullptr;
+    mask = 0;
+    mapped_size = 0;
+    cached_head = 0;
+    cached_tail = 0;
+    reserved_head = 0;
+}
+
+edo::Channel::Channel(const std::size_t capacity) : Channel()
+{
+    std::size_t size = 4096;
+    while(size < capacity)
+        size *= 2;
+
+    memfd = memfd_create("edo-channel", MFD_CLOEXEC);
+    if(memfd < 0)
+        throw edo::EdoError(SHM_FAILED);
+
+    void* mapped = MAP_FAILED;
+    if(ftruncate(memfd, RING_OFFSET + size) == 0)
+    {
+        mapped = mmap(nullptr, RING_OFFSET + size, PROT_READ | PROT_WRITE,
+            MAP_SHARED, memfd, 0);
+    }
+
+    if(mapped == MAP_FAILED)
+    {
+        close(memfd);
+        throw edo::EdoError(SHM_FAILED);
+    }
+
+    // The memfd starts zeroed, so the atomics start at 0
+    shared = static_cast<Shared*>(mapped);
+    mapped_size = RING_OFFSET + size;
+    shared->magic = CHANNEL_MAGIC;
+    shared->version = CHANNEL_VERSION;
+    shared->capacity = size;
+    ring = static_cast<uint8_t*>(mapped) + RING_OFFSET;
+    mask = size - 1;
+}
+
+edo::Channel edo::Channel::open(const int fd)
+{
+    Channel channel;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(RING_OFFSET * 2))
+        throw std::runtime_error(MALFORMATTED_CHANNEL);
+
+    channel.memfd = dup(fd);
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED, channel.memfd, 0);
+    if(mapped == MAP_FAILED)
+        throw std::runtime_error(MALFORMATTED_CHANNEL);
+
+    // Owned by the channel from here, so throwing unmaps it
+    channel.shared = static_cast<Shared*>(mapped);
+    channel.mapped_size = st.st_size;
+    channel.ring = static_cast<uint8_t*>(mapped) + RING_OFFSET;
+
+    uint64_t size = channel.shared->capacity;
+    if(channel.shared->magic != CHANNEL_MAGIC ||
+        channel.shared->version != CHANNEL_VERSION ||
+        size + RING_OFFSET != static_cast<uint64_t>(st.st_size) ||
+        (size & (size - 1)) != 0)
+    {
+        throw std::runtime_error(MALFORMATTED_CHANNEL);
+    }
+
+    channel.mask = size - 1;
+    channel.cached_head = channel.shared->head.load(std::memory_order_acquire);
+    channel.cached_tail = channel.shared->tail.load(std::memory_order_acquire);
+
+    return channel;
+}
+
+edo::Channel::Channel(Channel&& other)
+{
+    memfd = other.memfd;
+    shared = other.shared;
+    ring = other.ring;
+    mask = other.mask;
+    mapped_size = other.mapped_size;
+    cached_head = other.cached_head;
+    cached_tail = other.cached_tail;
+    reserved_head = other.reserved_head;
+
+    other.memfd = -1;
+    other.shared = nullptr;
+}
+
+edo::Channel::~Channel()
+{
+    if(shared != nullptr)
+        munmap(shared, mapped_size);
+
+    if(memfd >= 0)
+        close(memfd);
+}
+
+int edo::Channel::fd() const
+{
+    return memfd;
+}
+
+std::size_t edo::Channel::capacity() const
+{
+    return mask + 1;
+}
+
+std::size_t edo::Channel::max_record() const
+{
+    // A record may need padding up to its own size at the end of the ring
+    return capacity() / 2 - RECORD_HEADER;
+}
+
+uint8_t* edo::Channel::reserve(const std::size_t length)
+{
+    if(length > max_record())
+        throw std::out_of_range(OPERATION_EXCEEDS_CAPACITY);
+
+    uint64_t head = shared->head.load(std::memory_order_relaxed);
+    std::size_t need = record_size(length);
+    std::size_t pos = head & mask;
+    std::size_t to_end = capacity() - pos;
+    std::size_t total = required(length);
+
+    if(head + total - cached_tail > capacity())
+    {
+        cached_tail = shared->tail.load(std::memory_order_acquire);
+        if(head + total - cached_tail > capacity())
+            return nullptr;
+    }
+
+    // Records never wrap, the rest of the ring is skipped instead
+    RecordHeader header;
+    if(need > to_end)
+    {
+        header.length = to_end - RECORD_HEADER;
+        header.flags = RECORD_PADDING;
+        std::memcpy(ring + pos, &header, sizeof(header));
+        pos = 0;
+    }
+
+    header.length = length;
+    header.flags = 0;
+    std::memcpy(ring + pos, &header, sizeof(header));
+    reserved_head = head + total;
+
+    return ring + pos + RECORD_HEADER;
+}
+
+void edo::Channel::commit()
+{
+    shared->head.store(reserved_head, std::memory_order_release);
+    wake(shared->consumer_waiting);
+}
+
+bool edo::Channel::try_send(const uint8_t* data, const std::size_t length)
+{
+    uint8_t* out = reserve(length);
+    if(out == nullptr)
+        return false;
+
+    std::memcpy(out, data, length);
+    commit();
+
+    return true;
+}
+
+bool edo::Channel::send(
+    const uint8_t* data,
+    const std::size_t length,
+    const int timeout_ms
+)
+{
+    if(try_send(data, length))
+        return true;
+
+    std::size_t need = required(length);
+    bool ready = block(shared->producer_waiting, timeout_ms, [&]()
+    {
+        uint64_t head = shared->head.load(std::memory_order_relaxed);
+        cached_tail = shared->tail.load(std::memory_order_seq_cst);
+        return capacity() - (head - cached_tail) >= need;
+    });
+
+    return ready && try_send(data, length);
+}
+
+bool edo::Channel::send(Bytebuf& buf, const int timeout_ms)
+{
+    return send(buf.data(), buf.size(), timeout_ms);
+}
+
+bool edo::Channel::wait(const int timeout_ms)
+{
+    return block(shared->consumer_waiting, timeout_ms, [&]()
+    {
+        return shared->head.load(std::memory_order_seq_cst) !=
+            shared->tail.load(std::memory_order_relaxed);
+    });
+}
+
+bool edo::Channel::receive(Bytebuf& out, const int timeout_ms)
+{
+    if(!wait(timeout_ms))
+        return false;
+
+    out.clear();
+    return drain([&](const uint8_t* data, std::size_t length)
+    {
+        out.put(data, length);
+        out.rewind();
+    }, 1) == 1;
+}
+
+bool edo::Channel::peek(const uint8_t*& data, std::size_t& length)
+{
+    uint64_t tail = shared->tail.load(std::memory_order_relaxed);
+
+    while(true)
+    {
+        if(tail == cached_head)
+        {
+            cached_head = shared->head.load(std::memory_order_acquire);
+            if(tail == cached_head)
+                return false;
+        }
+
+        // The other side can write anything into the ring, so a record
+        // has to fit the limits reserve() keeps to and end within the ring
+        RecordHeader header;
+        std::size_t pos = tail & mask;
+        std::memcpy(&header, ring + pos, sizeof(header));
+        if(header.length > max_record() ||
+            RECORD_HEADER + header.length > capacity() - pos)
+            throw std::runtime_error(MALFORMATTED_CHANNEL);
+
+        if(!(header.flags & RECORD_PADDING))
+        {
+            if(record_size(header.length) > capacity() - pos)
+                throw std::runtime_error(MALFORMATTED_CHANNEL);
+
+            data = ring + pos + RECORD_HEADER;
+            length = header.length;
+            return true;
+        }
+
+        // Padding always fills the rest of the ring
+        if(RECORD_HEADER + header.length != capacity() - pos)
+            throw std::runtime_error(MALFORMATTED_CHANNEL);
+
+        tail += RECORD_HEADER + header.length;
+        shared->tail.store(tail, std::memory_order_release);
+    }
+}
+
+void edo::Channel::pop()
+{
+    uint64_t tail = shared->tail.load(std::memory_order_relaxed);
+
+    RecordHeader header;
+    std::memcpy(&header, ring + (tail & mask), sizeof(header));
+    shared->tail.store(tail + record_size(header.length),
+        std::memory_order_release);
+}
+
+void edo::Channel::notify()
+{
+    wake(shared->producer_waiting);
+}
+
+std::size_t edo::Channel::required(const std::size_t length)
+{
+    uint64_t head = shared->head.load(std::memory_order_relaxed);
+    std::size_t need = record_size(length);
+    std::size_t to_end = capacity() - (head & mask);
+
+    return need > to_end ? to_end + need : need;
+}
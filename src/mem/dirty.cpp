@@ -0,0 +1,128 @@
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "edo/mem/dirty.hpp"
+
+namespace
+{
+    const uint64_t PAGEMAP_SOFT_DIRTY = 1ULL << 55;
+
+    bool write_clear_refs(const pid_t pid)
+    {
+        std::string path = "/proc/" + std::to_string(pid) + "/clear_refs";
+        int fd = open(path.c_str(), O_WRONLY);
+        if(fd < 0)
+            return false;
+
+        // 4 clears the soft-dirty bits
+        bool res = write(fd, "4", 1) == 1;
+        close(fd);
+
+        return res;
+    }
+
+    bool read_pagemap(
+        const pid_t pid,
+        const uintptr_t begin,
+        const std::size_t pages,
+        std::vector<uint64_t>& entries
+    )
+    {
+        std::string path = "/proc/" + std::to_string(pid) + "/pagemap";
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        entries.resize(pages);
+        std::size_t length = pages * sizeof(uint64_t);
+        off_t offset = begin / edo::DirtyTracker::page_size() * sizeof(uint64_t);
+        ssize_t res = pread(fd, entries.data(), length, offset);
+        close(fd);
+
+        return res == static_cast<ssize_t>(length);
+    }
+
+    // Checks whether a newly written page is reported as soft-dirty and
+    // whether the bits could be cleared, without clearing them, as that
+    // would reset the bits of the whole process
+    bool probe()
+    {
+        std::string path = "/proc/" + std::to_string(getpid()) + "/clear_refs";
+        int fd = open(path.c_str(), O_WRONLY);
+        if(fd < 0)
+            return false;
+
+        close(fd);
+
+        std::size_t size = edo::DirtyTracker::page_size();
+        void* page = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(page == MAP_FAILED)
+            return false;
+
+        // Kernels without soft-dirty support never set the bit
+        std::vector<uint64_t> entries;
+        *static_cast<volatile uint8_t*>(page) = 1;
+        bool res = read_pagemap(getpid(), reinterpret_cast<uintptr_t>(page),
+            1, entries) && (entries[0] & PAGEMAP_SOFT_DIRTY);
+
+        munmap(page, size);
+        return res;
+    }
+}
+
+edo::DirtyTracker::DirtyTracker()
+{
+    process_id = getpid();
+}
+
+edo::DirtyTracker::DirtyTracker(const pid_t pid)
+{
+    process_id = pid;
+}
+
+edo::DirtyTracker::~DirtyTracker()
+{
+
+}
+
+bool edo::DirtyTracker::supported()
+{
+    static const bool res = probe();
+    return res;
+}
+
+std::size_t edo::DirtyTracker::page_size()
+{
+    static const std::size_t size = sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+pid_t edo::DirtyTracker::pid() const
+{
+    return process_id;
+}
+
+bool edo::DirtyTracker::clear()
+{
+    return supported() && write_clear_refs(process_id);
+}
+
+bool edo::DirtyTracker::dirty(
+    const uintptr_t begin,
+    const std::size_t pages,
+    std::vector<uint8_t>& out
+)
+{
+    std::vector<uint64_t> entries;
+    if(!read_pagemap(process_id, begin, pages, entries))
+        return false;
+
+    out.resize(pages);
+    for(std::size_t i = 0; i < pages; i++)
+        out[i] = (entries[i] & PAGEMAP_SOFT_DIRTY) ? 1 : 0;
+
+    return true;
+}
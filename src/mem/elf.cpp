@@ -0,0 +1,240 @@
+#include <cstring>
+#include <stdexcept>
+#include <link.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/mem/elf.hpp"
+#include "edo/mem/module.hpp"
+
+namespace
+{
+    /// The ELF class and byte order of the current process
+    #if __SIZEOF_POINTER__ == 8
+    const uint8_t NATIVE_CLASS = ELFCLASS64;
+    #else
+    const uint8_t NATIVE_CLASS = ELFCLASS32;
+    #endif
+
+    #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint8_t NATIVE_DATA = ELFDATA2LSB;
+    #else
+    const uint8_t NATIVE_DATA = ELFDATA2MSB;
+    #endif
+
+    /// Returns whether [offset, offset + length) lies within a file
+    bool in_file(uint64_t offset, uint64_t length, std::size_t size)
+    {
+        return offset <= size && length <= size - offset;
+    }
+}
+
+edo::ElfFile::ElfFile(const std::string& path)
+{
+    file_path = path;
+    file_data = nullptr;
+    file_size = 0;
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        throw edo::NotFoundError(FILE_NOT_FOUND);
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(ElfW(Ehdr))))
+    {
+        close(fd);
+        throw std::runtime_error(MALFORMATTED_ELF);
+    }
+
+    file_size = st.st_size;
+    void* mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(mapped == MAP_FAILED)
+        throw edo::NotFoundError(FILE_NOT_FOUND);
+
+    // Sections are scanned front to back, so read ahead aggressively
+    file_data = static_cast<uint8_t*>(mapped);
+    madvise(file_data, file_size, MADV_SEQUENTIAL);
+
+    try
+    {
+        parse();
+    }
+    catch(...)
+    {
+        munmap(file_data, file_size);
+        throw;
+    }
+}
+
+edo::ElfFile::~ElfFile()
+{
+    munmap(file_data, file_size);
+}
+
+void edo::ElfFile::parse()
+{
+    ElfW(Ehdr) header;
+    std::memcpy(&header, file_data, sizeof(header));
+
+    if(std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 ||
+        header.e_ident[EI_CLASS] != NATIVE_CLASS ||
+        header.e_ident[EI_DATA] != NATIVE_DATA)
+    {
+        throw std::runtime_error(MALFORMATTED_ELF);
+    }
+
+    // Program headers
+    if(header.e_phnum != 0 && (header.e_phentsize != sizeof(ElfW(Phdr)) ||
+        !in_file(header.e_phoff,
+            static_cast<uint64_t>(header.e_phnum) * sizeof(ElfW(Phdr)),
+            file_size)))
+    {
+        throw std::runtime_error(MALFORMATTED_ELF);
+    }
+
+    for(std::size_t i = 0; i < header.e_phnum; i++)
+    {
+        ElfW(Phdr) phdr;
+        std::memcpy(&phdr, file_data + header.e_phoff + i * sizeof(phdr),
+            sizeof(phdr));
+
+        ElfSegment segment;
+        segment.type = phdr.p_type;
+        segment.flags = phdr.p_flags;
+        segment.address = phdr.p_vaddr;
+        segment.offset = phdr.p_offset;
+        segment.file_size = phdr.p_filesz;
+        segment.memory_size = phdr.p_memsz;
+        file_segments.push_back(segment);
+
+        if(phdr.p_type == PT_NOTE && file_build_id.empty() &&
+            in_file(phdr.p_offset, phdr.p_filesz, file_size))
+        {
+            file_build_id = edo::read_build_id(file_data + phdr.p_offset,
+                phdr.p_filesz, phdr.p_align == 8 ? 8 : 4);
+        }
+    }
+
+    // Section headers are optional, e.g. in stripped binaries
+    if(header.e_shnum == 0)
+        return;
+
+    if(header.e_shentsize != sizeof(ElfW(Shdr)) ||
+        header.e_shstrndx >= header.e_shnum ||
+        !in_file(header.e_shoff,
+            static_cast<uint64_t>(header.e_shnum) * sizeof(ElfW(Shdr)),
+            file_size))
+    {
+        throw std::runtime_error(MALFORMATTED_ELF);
+    }
+
+    std::vector<ElfW(Shdr)> shdrs(header.e_shnum);
+    std::memcpy(shdrs.data(), file_data + header.e_shoff,
+        shdrs.size() * sizeof(ElfW(Shdr)));
+
+    const ElfW(Shdr)& strtab = shdrs[header.e_shstrndx];
+    if(!in_file(strtab.sh_offset, strtab.sh_size, file_size))
+        throw std::runtime_error(MALFORMATTED_ELF);
+
+    const char* names = reinterpret_cast<const char*>(file_data + strtab.sh_offset);
+    for(const ElfW(Shdr)& shdr : shdrs)
+    {
+        if(shdr.sh_name >= strtab.sh_size || (shdr.sh_type != SHT_NOBITS &&
+            !in_file(shdr.sh_offset, shdr.sh_size, file_size)))
+        {
+            throw std::runtime_error(MALFORMATTED_ELF);
+        }
+
+        ElfSection section;
+        section.name.assign(names + shdr.sh_name,
+            strnlen(names + shdr.sh_name, strtab.sh_size - shdr.sh_name));
+        section.type = shdr.sh_type;
+        section.flags = shdr.sh_flags;
+        section.address = shdr.sh_addr;
+        section.offset = shdr.sh_offset;
+        section.size = shdr.sh_size;
+        file_sections.push_back(section);
+    }
+}
+
+const std::string& edo::ElfFile::path() const
+{
+    return file_path;
+}
+
+const uint8_t* edo::ElfFile::data() const
+{
+    return file_data;
+}
+
+std::size_t edo::ElfFile::size() const
+{
+    return file_size;
+}
+
+const std::vector<edo::ElfSection>& edo::ElfFile::sections() const
+{
+    return file_sections;
+}
+
+const std::vector<edo::ElfSegment>& edo::ElfFile::segments() const
+{
+    return file_segments;
+}
+
+const edo::ElfSection* edo::ElfFile::section(const std::string& name) const
+{
+    for(const ElfSection& section : file_sections)
+    {
+        if(section.name == name)
+            return &section;
+    }
+
+    return nullptr;
+}
+
+const std::vector<uint8_t>& edo::ElfFile::build_id() const
+{
+    return file_build_id;
+}
+
+std::string edo::ElfFile::id() const
+{
+    return edo::module_id(file_build_id, file_data, file_size);
+}
+
+uint64_t edo::ElfFile::address(const uint64_t offset) const
+{
+    for(const ElfSegment& segment : file_segments)
+    {
+        if(segment.type == PT_LOAD && offset >= segment.offset &&
+            offset - segment.offset < segment.file_size)
+        {
+            return segment.address + (offset - segment.offset);
+        }
+    }
+
+    throw std::out_of_range(UNMAPPED_ELF_ADDR);
+}
+
+uint64_t edo::ElfFile::offset(const uint64_t address) const
+{
+    // Only the first file_size bytes of a segment are backed by the file,
+    // the rest is zero filled memory like .bss
+    for(const ElfSegment& segment : file_segments)
+    {
+        if(segment.type == PT_LOAD && address >= segment.address &&
+            address - segment.address < segment.file_size)
+        {
+            return segment.offset + (address - segment.address);
+        }
+    }
+
+    throw std::out_of_range(UNMAPPED_ELF_ADDR);
+}
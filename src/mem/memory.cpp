@@ -0,0 +1,121 @@
+#include <climits>
+#include <algorithm>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "edo/mem/memory.hpp"
+
+namespace
+{
+    // Upper bound of iovec elements accepted per system call
+    const std::size_t BATCH_SIZE = IOV_MAX;
+}
+
+edo::Memory::Memory()
+{
+    process_id = getpid();
+}
+
+edo::Memory::Memory(const pid_t pid)
+{
+    process_id = pid;
+}
+
+pid_t edo::Memory::pid() const
+{
+    return process_id;
+}
+
+bool edo::Memory::read(
+    const uintptr_t address,
+    void* out,
+    const std::size_t length
+) const
+{
+    if(length == 0)
+        return true;
+
+    iovec local = {out, length};
+    iovec remote = {reinterpret_cast<void*>(address), length};
+    ssize_t res = process_vm_readv(process_id, &local, 1, &remote, 1, 0);
+
+    return res == static_cast<ssize_t>(length);
+}
+
+std::size_t edo::Memory::read_batch(std::vector<ReadOp>& ops) const
+{
+    std::vector<iovec> local;
+    std::vector<iovec> remote;
+    std::vector<std::size_t> indices;
+    local.reserve(std::min(ops.size(), BATCH_SIZE));
+    remote.reserve(std::min(ops.size(), BATCH_SIZE));
+    indices.reserve(std::min(ops.size(), BATCH_SIZE));
+
+    std::size_t succeeded = 0;
+    std::size_t next = 0;
+
+    while(next < ops.size())
+    {
+        local.clear();
+        remote.clear();
+        indices.clear();
+
+        for(; next < ops.size() && indices.size() < BATCH_SIZE; next++)
+        {
+            ReadOp& op = ops[next];
+            op.ok = op.length == 0;
+            if(op.ok)
+            {
+                succeeded++;
+                continue;
+            }
+
+            iovec l = {op.out, op.length};
+            iovec r = {reinterpret_cast<void*>(op.address), op.length};
+            local.push_back(l);
+            remote.push_back(r);
+            indices.push_back(next);
+        }
+
+        // A transfer stops at the first element that cannot be read, so
+        // skip past it and continue with the remaining elements
+        std::size_t first = 0;
+        while(first < indices.size())
+        {
+            std::size_t count = indices.size() - first;
+            ssize_t res = process_vm_readv(process_id, &local[first], count,
+                &remote[first], count, 0);
+
+            std::size_t transferred = res > 0 ? res : 0;
+            while(first < indices.size() &&
+                transferred >= local[first].iov_len)
+            {
+                transferred -= local[first].iov_len;
+                ops[indices[first]].ok = true;
+                succeeded++;
+                first++;
+            }
+
+            // The element the transfer stopped at failed
+            first++;
+        }
+    }
+
+    return succeeded;
+}
+
+bool edo::Memory::write(
+    const uintptr_t address,
+    const void* data,
+    const std::size_t length
+) const
+{
+    if(length == 0)
+        return true;
+
+    iovec local = {const_cast<void*>(data), length};
+    iovec remote = {reinterpret_cast<void*>(address), length};
+    ssize_t res = process_vm_writev(process_id, &local, 1, &remote, 1, 0);
+
+    return res == static_cast<ssize_t>(length);
+}
@@ -0,0 +1,257 @@
+#include <map>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <link.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/mem/module.hpp"
+
+namespace
+{
+    /// The hash of a module file without a build-id, valid while the file
+    /// keeps its modification time and size
+    struct FileId
+    {
+        timespec mtime;
+        off_t size;
+        std::string id;
+    };
+
+    std::mutex file_id_mutex;
+    std::map<std::string, FileId> file_ids;
+}
+
+namespace edo
+{
+    /// Builds Module objects from dl_iterate_phdr entries
+    struct ModuleBuilder
+    {
+        static Module build(const dl_phdr_info* info)
+        {
+            Module module;
+            module.module_base = info->dlpi_addr;
+
+            if(info->dlpi_name != nullptr && info->dlpi_name[0] != '\0')
+                module.module_path = info->dlpi_name;
+            else
+            {
+                // The main executable is reported without a name
+                char buffer[PATH_MAX];
+                ssize_t length = readlink("/proc/self/exe", buffer,
+                    sizeof(buffer) - 1);
+                if(length > 0)
+                    module.module_path.assign(buffer, length);
+            }
+
+            for(int i = 0; i < info->dlpi_phnum; i++)
+            {
+                const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+                if(phdr.p_type == PT_LOAD)
+                {
+                    Segment segment;
+                    segment.begin = info->dlpi_addr + phdr.p_vaddr;
+                    segment.end = segment.begin + phdr.p_memsz;
+                    segment.flags = phdr.p_flags;
+                    module.module_segments.push_back(segment);
+                }
+                else if(phdr.p_type == PT_NOTE && module.module_build_id.empty())
+                {
+                    module.module_build_id = edo::read_build_id(
+                        reinterpret_cast<const uint8_t*>(
+                            info->dlpi_addr + phdr.p_vaddr),
+                        phdr.p_memsz,
+                        phdr.p_align == 8 ? 8 : 4
+                    );
+                }
+            }
+
+            return module;
+        }
+    };
+}
+
+namespace
+{
+    int collect_module(dl_phdr_info* info, std::size_t, void* data)
+    {
+        auto modules = static_cast<std::vector<edo::Module>*>(data);
+        modules->push_back(edo::ModuleBuilder::build(info));
+
+        return 0;
+    }
+
+    std::string file_name(const std::string& path)
+    {
+        std::size_t slash = path.rfind('/');
+        if(slash == std::string::npos)
+            return path;
+
+        return path.substr(slash + 1);
+    }
+}
+
+edo::Module::Module()
+{
+    module_base = 0;
+}
+
+edo::Module edo::Module::find(const std::string& name)
+{
+    std::vector<Module> modules = list();
+
+    // The main executable is always reported first
+    if(name == "" && !modules.empty())
+        return modules.front();
+
+    for(const Module& module : modules)
+    {
+        if(module.path() == name || file_name(module.path()) == name)
+            return module;
+    }
+
+    throw edo::NotFoundError(MODULE_NOT_FOUND);
+}
+
+std::vector<edo::Module> edo::Module::list()
+{
+    std::vector<Module> modules;
+    dl_iterate_phdr(collect_module, &modules);
+
+    return modules;
+}
+
+const std::string& edo::Module::path() const
+{
+    return module_path;
+}
+
+uintptr_t edo::Module::base() const
+{
+    return module_base;
+}
+
+const std::vector<edo::Segment>& edo::Module::segments() const
+{
+    return module_segments;
+}
+
+const std::vector<uint8_t>& edo::Module::build_id() const
+{
+    return module_build_id;
+}
+
+std::string edo::Module::id() const
+{
+    if(!module_build_id.empty())
+        return edo::module_id(module_build_id, nullptr, 0);
+
+    // Fall back to hashing the module file, once per version of it
+    struct stat info;
+    bool known = stat(module_path.c_str(), &info) == 0;
+    if(known)
+    {
+        std::lock_guard<std::mutex> lock(file_id_mutex);
+        std::map<std::string, FileId>::const_iterator found =
+            file_ids.find(module_path);
+        if(found != file_ids.end() &&
+            found->second.mtime.tv_sec == info.st_mtim.tv_sec &&
+            found->second.mtime.tv_nsec == info.st_mtim.tv_nsec &&
+            found->second.size == info.st_size)
+        {
+            return found->second.id;
+        }
+    }
+
+    std::vector<uint8_t> contents = edo::read_file(module_path);
+    std::string id = edo::module_id(module_build_id, contents.data(),
+        contents.size());
+
+    if(known)
+    {
+        std::lock_guard<std::mutex> lock(file_id_mutex);
+        file_ids[module_path] = FileId{info.st_mtim, info.st_size, id};
+    }
+
+    return id;
+}
+
+bool edo::Module::contains(
+    const uintptr_t address,
+    const std::size_t length
+) const
+{
+    for(const Segment& segment : module_segments)
+    {
+        if((segment.flags & PF_R) && address >= segment.begin &&
+            address <= segment.end && length <= segment.end - address)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<uint8_t> edo::read_build_id(
+    const uint8_t* notes,
+    const std::size_t length,
+    const std::size_t align
+)
+{
+    std::size_t pos = 0;
+    while(pos + sizeof(ElfW(Nhdr)) <= length)
+    {
+        ElfW(Nhdr) note;
+        std::memcpy(&note, notes + pos, sizeof(note));
+        pos += sizeof(note);
+
+        std::size_t name_size = (note.n_namesz + align - 1) & ~(align - 1);
+        std::size_t desc_size = (note.n_descsz + align - 1) & ~(align - 1);
+        if(pos + name_size + note.n_descsz > length)
+            break;
+
+        if(note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4 &&
+            std::memcmp(notes + pos, "GNU", 4) == 0)
+        {
+            const uint8_t* desc = notes + pos + name_size;
+            return std::vector<uint8_t>(desc, desc + note.n_descsz);
+        }
+
+        pos += name_size + desc_size;
+    }
+
+    return std::vector<uint8_t>();
+}
+
+std::string edo::module_id(
+    const std::vector<uint8_t>& build_id,
+    const uint8_t* data,
+    const std::size_t length
+)
+{
+    char hex[3];
+    std::string res;
+
+    if(!build_id.empty())
+    {
+        for(uint8_t byte : build_id)
+        {
+            std::snprintf(hex, sizeof(hex), "%02x", byte);
+            res += hex;
+        }
+
+        return res;
+    }
+
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx",
+        static_cast<unsigned long long>(edo::fnv1a(data, length)));
+
+    return std::string("fnv1a:") + hash;
+}
@@ -0,0 +1,279 @@
+#include "edo/mem/pointer.hpp"
+
+edo::PointerPath::PointerPath()
+{
+    path_base = 0;
+}
+
+edo::PointerPath::PointerPath(
+    const uintptr_t base,
+    const std::vector<intptr_t>& offsets
+)
+{
+    path_base = base;
+    path_offsets = offsets;
+}
+
+uintptr_t edo::PointerPath::base() const
+{
+    return path_base;
+}
+
+const std::vector<intptr_t>& edo::PointerPath::offsets() const
+{
+    return path_offsets;
+}
+
+std::size_t edo::PointerPath::depth() const
+{
+    return path_offsets.size();
+}
+
+bool edo::PointerPath::resolve(const Memory& memory, uintptr_t& result) const
+{
+    uintptr_t address = path_base;
+    for(intptr_t offset : path_offsets)
+    {
+        if(!memory.read(address + offset, address))
+            return false;
+    }
+
+    result = address;
+    return true;
+}
+
+edo::PointerResolver::PointerResolver()
+{
+    region_table = nullptr;
+    refresh_interval = 64;
+    resolves = 0;
+}
+
+edo::PointerResolver::PointerResolver(const Memory& memory) : memory(memory)
+{
+    region_table = nullptr;
+    refresh_interval = 64;
+    resolves = 0;
+}
+
+std::size_t edo::PointerResolver::add(const PointerPath& path)
+{
+    Entry entry;
+    entry.path = path;
+    entry.chain.resize(path.depth(), 0);
+    entry.memoized = false;
+    entry.valid = false;
+    entry.reread.resize(path.depth(), 0);
+    entries.push_back(entry);
+
+    return entries.size() - 1;
+}
+
+const edo::PointerPath& edo::PointerResolver::path(
+    const std::size_t index
+) const
+{
+    return entries.at(index).path;
+}
+
+std::size_t edo::PointerResolver::size() const
+{
+    return entries.size();
+}
+
+void edo::PointerResolver::clear()
+{
+    entries.clear();
+}
+
+void edo::PointerResolver::set_refresh_interval(const std::size_t interval)
+{
+    refresh_interval = interval;
+}
+
+void edo::PointerResolver::set_regions(const RegionTable* regions)
+{
+    region_table = regions;
+}
+
+void edo::PointerResolver::invalidate()
+{
+    for(Entry& entry : entries)
+        entry.memoized = false;
+}
+
+std::size_t edo::PointerResolver::resolve()
+{
+    resolves++;
+    if(refresh_interval == 0 || resolves >= refresh_interval)
+    {
+        invalidate();
+        resolves = 0;
+    }
+
+    std::vector<std::size_t> stale;
+    std::size_t count = resolve_memoized(stale);
+    resolve_full(stale);
+
+    for(std::size_t index : stale)
+    {
+        if(entries[index].valid)
+            count++;
+    }
+
+    return count;
+}
+
+bool edo::PointerResolver::valid(const std::size_t index) const
+{
+    return entries.at(index).valid;
+}
+
+uintptr_t edo::PointerResolver::address(const std::size_t index) const
+{
+    const Entry& entry = entries.at(index);
+    if(entry.chain.empty())
+        return entry.path.base();
+
+    return entry.chain.back();
+}
+
+bool edo::PointerResolver::readable(const uintptr_t address) const
+{
+    return region_table == nullptr ||
+        region_table->readable(address, sizeof(uintptr_t));
+}
+
+std::size_t edo::PointerResolver::resolve_memoized(
+    std::vector<std::size_t>& stale
+)
+{
+    std::size_t count = 0;
+    ops.clear();
+
+    for(std::size_t i = 0; i < entries.size(); i++)
+    {
+        Entry& entry = entries[i];
+        std::size_t depth = entry.path.depth();
+
+        if(depth == 0)
+        {
+            entry.valid = true;
+            count++;
+            continue;
+        }
+
+        if(!entry.memoized)
+        {
+            stale.push_back(i);
+            continue;
+        }
+
+        // Reread every hop from its memoized parent
+        for(std::size_t level = 0; level < depth; level++)
+        {
+            uintptr_t parent = level == 0 ?
+                entry.path.base() : entry.chain[level - 1];
+
+            ReadOp op;
+            op.address = parent + entry.path.offsets()[level];
+            op.out = &entry.reread[level];
+            op.length = sizeof(uintptr_t);
+            ops.push_back(op);
+        }
+    }
+
+    if(ops.empty())
+        return count;
+
+    memory.read_batch(ops);
+
+    std::size_t op_index = 0;
+    for(std::size_t i = 0; i < entries.size(); i++)
+    {
+        Entry& entry = entries[i];
+        std::size_t depth = entry.path.depth();
+        if(depth == 0 || !entry.memoized)
+            continue;
+
+        // Every parent has to be unchanged, the last hop may move freely
+        bool unchanged = true;
+        for(std::size_t level = 0; level < depth; level++)
+        {
+            if(!ops[op_index++].ok)
+                unchanged = false;
+            else if(level + 1 < depth &&
+                entry.reread[level] != entry.chain[level])
+                unchanged = false;
+        }
+
+        if(unchanged)
+        {
+            entry.chain[depth - 1] = entry.reread[depth - 1];
+            entry.valid = true;
+            count++;
+        }
+        else
+        {
+            entry.memoized = false;
+            stale.push_back(i);
+        }
+    }
+
+    return count;
+}
+
+void edo::PointerResolver::resolve_full(std::vector<std::size_t>& stale)
+{
+    std::vector<std::size_t> active;
+    std::vector<std::size_t> next;
+
+    for(std::size_t index : stale)
+    {
+        entries[index].valid = false;
+        active.push_back(index);
+    }
+
+    // Resolve one depth level at a time with a single batched read
+    for(std::size_t level = 0; !active.empty(); level++)
+    {
+        ops.clear();
+        next.clear();
+
+        for(std::size_t index : active)
+        {
+            Entry& entry = entries[index];
+            uintptr_t parent = level == 0 ?
+                entry.path.base() : entry.chain[level - 1];
+            uintptr_t address = parent + entry.path.offsets()[level];
+
+            if(!readable(address))
+                continue;
+
+            ReadOp op;
+            op.address = address;
+            op.out = &entry.chain[level];
+            op.length = sizeof(uintptr_t);
+            ops.push_back(op);
+            next.push_back(index);
+        }
+
+        memory.read_batch(ops);
+        active.clear();
+
+        for(std::size_t i = 0; i < next.size(); i++)
+        {
+            if(!ops[i].ok)
+                continue;
+
+            Entry& entry = entries[next[i]];
+            if(level + 1 < entry.path.depth())
+                active.push_back(next[i]);
+            else
+            {
+                entry.valid = true;
+                entry.memoized = true;
+            }
+        }
+    }
+}
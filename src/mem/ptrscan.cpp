@@ -0,0 +1,565 @@
+#include <set>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/mem/ptrscan.hpp"
+
+namespace
+{
+    const uint32_t CHAINS_MAGIC = 0x53504445; // "EDPS"
+    const uint32_t CHAINS_VERSION = 2;
+
+    // Size of the chunks regions are read in while building the map
+    const std::size_t CHUNK_SIZE = 1 << 20;
+
+    std::string file_name(const std::string& path)
+    {
+        std::size_t slash = path.rfind('/');
+        if(slash == std::string::npos)
+            return path;
+
+        return path.substr(slash + 1);
+    }
+
+    bool is_file_backed(const edo::Region& region)
+    {
+        return !region.path.empty() && region.path[0] != '[';
+    }
+
+    /// Returns the path of the file every region belongs to, empty for
+    /// regions of no file
+    /// The part of .bss past the last page of a file is mapped anonymously
+    /// right after the writable mapping of the file, so an anonymous
+    /// writable region directly following one belongs to that file too
+    std::vector<std::string> owners(const edo::RegionTable& regions)
+    {
+        const std::vector<edo::Region>& list = regions.regions();
+        std::vector<std::string> result(list.size());
+
+        for(std::size_t i = 0; i < list.size(); i++)
+        {
+            if(is_file_backed(list[i]))
+                result[i] = list[i].path;
+            else if(i > 0 && list[i].path.empty() && list[i].writable &&
+                list[i - 1].writable && list[i - 1].end == list[i].begin &&
+                is_file_backed(list[i - 1]))
+            {
+                result[i] = list[i - 1].path;
+            }
+        }
+
+        return result;
+    }
+
+    bool entry_less(const edo::PointerEntry& a, const edo::PointerEntry& b)
+    {
+        return a.value < b.value ||
+            (a.value == b.value && a.address < b.address);
+    }
+
+    bool chain_less(const edo::PointerChain& a, const edo::PointerChain& b)
+    {
+        if(a.offsets.size() != b.offsets.size())
+            return a.offsets.size() < b.offsets.size();
+        if(a.module != b.module)
+            return a.module < b.module;
+
+        return a.offsets < b.offsets;
+    }
+
+    // Returns whether a value lies within any of a sorted list of ranges
+    bool in_ranges(
+        const std::vector<std::pair<uintptr_t, uintptr_t>>& ranges,
+        const uintptr_t value
+    )
+    {
+        auto it = std::upper_bound(ranges.begin(), ranges.end(), value,
+            [](const uintptr_t v, const std::pair<uintptr_t, uintptr_t>& r)
+            {
+                return v < r.second;
+            });
+
+        return it != ranges.end() && value >= it->first;
+    }
+}
+
+/// The state of a single search thread
+struct edo::PointerScanner::Search
+{
+    const PointerScanner* scanner;
+    std::atomic<std::size_t>* result_count;
+    std::vector<PointerChain> results;
+    std::vector<intptr_t> offsets;
+
+    bool full()
+    {
+        return scanner->max_results != 0 &&
+            result_count->load(std::memory_order_relaxed) >=
+                scanner->max_results;
+    }
+
+    void emit(const Region& region, const uintptr_t address)
+    {
+        if(result_count->fetch_add(1, std::memory_order_relaxed) >=
+            scanner->max_results && scanner->max_results != 0)
+        {
+            return;
+        }
+
+        PointerChain chain;
+        chain.module = file_name(region.path);
+        chain.offsets.push_back(
+            address - scanner->module_bases.at(chain.module));
+        chain.offsets.insert(chain.offsets.end(),
+            offsets.rbegin(), offsets.rend());
+        results.push_back(chain);
+    }
+
+    /// Visits a pointer stored at the current end of the chain
+    void visit(const PointerEntry& entry, const uintptr_t target,
+        const std::size_t depth)
+    {
+        offsets.push_back(target - entry.value);
+
+        const Region* region = find_static(entry.address);
+        if(region != nullptr)
+            emit(*region, entry.address);
+        else if(depth < scanner->max_depth)
+            search(entry.address, depth + 1);
+
+        offsets.pop_back();
+    }
+
+    /// Searches for pointers leading to target at given depth
+    void search(const uintptr_t target, const std::size_t depth)
+    {
+        const std::vector<PointerEntry>& map = scanner->pointer_map;
+        uintptr_t low = target > scanner->max_offset ?
+            target - scanner->max_offset : 0;
+
+        PointerEntry key = {low, 0};
+        auto it = std::lower_bound(map.begin(), map.end(), key, entry_less);
+        for(; it != map.end() && it->value <= target && !full(); it++)
+            visit(*it, target, depth);
+    }
+
+    const Region* find_static(const uintptr_t address)
+    {
+        const std::vector<Region>& regions = scanner->static_regions;
+        auto it = std::upper_bound(regions.begin(), regions.end(), address,
+            [](const uintptr_t addr, const Region& r) { return addr < r.end; });
+
+        if(it == regions.end() || address < it->begin)
+            return nullptr;
+
+        return &*it;
+    }
+};
+
+edo::PointerPath edo::PointerChain::path(const uintptr_t module_base) const
+{
+    if(offsets.empty())
+        return PointerPath(module_base, offsets);
+
+    return PointerPath(module_base,
+        std::vector<intptr_t>(offsets.begin(), offsets.end() - 1));
+}
+
+intptr_t edo::PointerChain::last_offset() const
+{
+    return offsets.empty() ? 0 : offsets.back();
+}
+
+edo::PointerScanner::PointerScanner()
+{
+    max_depth = 4;
+    max_offset = 0x1000;
+    alignment = sizeof(uintptr_t);
+    threads = 0;
+    max_results = 0;
+}
+
+edo::PointerScanner::PointerScanner(const Memory& memory) : memory(memory)
+{
+    max_depth = 4;
+    max_offset = 0x1000;
+    alignment = sizeof(uintptr_t);
+    threads = 0;
+    max_results = 0;
+}
+
+void edo::PointerScanner::set_max_depth(const std::size_t depth)
+{
+    max_depth = depth;
+}
+
+void edo::PointerScanner::set_max_offset(const std::size_t offset)
+{
+    max_offset = offset;
+}
+
+void edo::PointerScanner::set_alignment(const std::size_t alignment)
+{
+    this->alignment = alignment == 0 ? 1 : alignment;
+}
+
+void edo::PointerScanner::set_threads(const unsigned threads)
+{
+    this->threads = threads;
+}
+
+void edo::PointerScanner::set_max_results(const std::size_t results)
+{
+    max_results = results;
+}
+
+void edo::PointerScanner::build(const RegionTable& regions)
+{
+    std::vector<const Region*> sources;
+    std::vector<std::pair<uintptr_t, uintptr_t>> targets;
+
+    static_regions.clear();
+    module_bases = edo::module_bases(regions);
+    std::vector<std::string> paths = owners(regions);
+
+    // Pointers are looked for in writable memory and may point into any
+    // writable memory, chains end in writable memory of mapped files
+    for(std::size_t i = 0; i < regions.size(); i++)
+    {
+        const Region& region = regions.regions()[i];
+        if(!region.readable || !region.writable)
+            continue;
+
+        sources.push_back(&region);
+
+        // Chains cannot start in files whose name other files share
+        if(!paths[i].empty() && module_bases.count(file_name(paths[i])))
+        {
+            static_regions.push_back(region);
+            static_regions.back().path = paths[i];
+        }
+
+        if(!targets.empty() && targets.back().second == region.begin)
+            targets.back().second = region.end;
+        else
+            targets.push_back(std::make_pair(region.begin, region.end));
+    }
+
+    // Regions are handed out to threads one at a time
+    unsigned count = thread_count();
+    std::atomic<std::size_t> next_region(0);
+    std::vector<std::vector<PointerEntry>> partial(count);
+    std::vector<std::thread> workers;
+
+    auto work = [&](unsigned id)
+    {
+        std::vector<uint8_t> chunk(CHUNK_SIZE);
+        std::vector<PointerEntry>& found = partial[id];
+
+        std::size_t index;
+        while((index = next_region.fetch_add(1)) < sources.size())
+        {
+            const Region& region = *sources[index];
+            for(uintptr_t pos = region.begin; pos < region.end; pos += CHUNK_SIZE)
+            {
+                std::size_t length = std::min<std::size_t>(CHUNK_SIZE,
+                    region.end - pos);
+                if(!memory.read(pos, chunk.data(), length))
+                    continue;
+
+                for(std::size_t i = 0; i + sizeof(uintptr_t) <= length;
+                    i += alignment)
+                {
+                    uintptr_t value;
+                    std::memcpy(&value, &chunk[i], sizeof(value));
+
+                    if(value >= targets.front().first &&
+                        value < targets.back().second &&
+                        in_ranges(targets, value))
+                    {
+                        PointerEntry entry = {value, pos + i};
+                        found.push_back(entry);
+                    }
+                }
+            }
+        }
+
+        std::sort(found.begin(), found.end(), entry_less);
+    };
+
+    pointer_map.clear();
+    if(targets.empty())
+        return;
+
+    for(unsigned i = 1; i < count; i++)
+        workers.push_back(std::thread(work, i));
+    work(0);
+    for(std::thread& worker : workers)
+        worker.join();
+
+    // Merge the sorted partial maps
+    for(std::vector<PointerEntry>& part : partial)
+    {
+        std::size_t middle = pointer_map.size();
+        pointer_map.insert(pointer_map.end(), part.begin(), part.end());
+        std::inplace_merge(pointer_map.begin(), pointer_map.begin() + middle,
+            pointer_map.end(), entry_less);
+        std::vector<PointerEntry>().swap(part);
+    }
+}
+
+const std::vector<edo::PointerEntry>& edo::PointerScanner::entries() const
+{
+    return pointer_map;
+}
+
+std::vector<edo::PointerChain> edo::PointerScanner::scan(
+    const uintptr_t target
+) const
+{
+    std::vector<PointerChain> res;
+    if(max_depth == 0)
+        return res;
+
+    // The first level of the search is split between threads, which
+    // each search the full depth below the pointers they are given
+    uintptr_t low = target > max_offset ? target - max_offset : 0;
+    PointerEntry key = {low, 0};
+    auto first = std::lower_bound(pointer_map.begin(), pointer_map.end(),
+        key, entry_less);
+    auto last = first;
+    while(last != pointer_map.end() && last->value <= target)
+        last++;
+
+    unsigned count = thread_count();
+    std::atomic<std::size_t> next_entry(0);
+    std::atomic<std::size_t> result_count(0);
+    std::vector<Search> searches(count);
+    std::vector<std::thread> workers;
+
+    auto work = [&](unsigned id)
+    {
+        Search& search = searches[id];
+        search.scanner = this;
+        search.result_count = &result_count;
+
+        std::size_t index;
+        while((index = next_entry.fetch_add(1)) <
+            static_cast<std::size_t>(last - first) && !search.full())
+        {
+            search.visit(*(first + index), target, 1);
+        }
+    };
+
+    for(unsigned i = 1; i < count; i++)
+        workers.push_back(std::thread(work, i));
+    work(0);
+    for(std::thread& worker : workers)
+        worker.join();
+
+    for(Search& search : searches)
+        res.insert(res.end(), search.results.begin(), search.results.end());
+
+    std::sort(res.begin(), res.end(), chain_less);
+    if(max_results != 0 && res.size() > max_results)
+        res.resize(max_results);
+
+    return res;
+}
+
+unsigned edo::PointerScanner::thread_count() const
+{
+    if(threads != 0)
+        return threads;
+
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores == 0 ? 1 : cores;
+}
+
+edo::PointerChainSet::PointerChainSet()
+{
+
+}
+
+edo::PointerChainSet::PointerChainSet(const std::vector<PointerChain>& chains)
+{
+    chain_list = chains;
+}
+
+const std::vector<edo::PointerChain>& edo::PointerChainSet::chains() const
+{
+    return chain_list;
+}
+
+std::size_t edo::PointerChainSet::size() const
+{
+    return chain_list.size();
+}
+
+edo::Bytebuf edo::PointerChainSet::serialize() const
+{
+    // Module names are stored once and referred to by index
+    std::map<std::string, uint32_t> modules;
+    for(const PointerChain& chain : chain_list)
+        modules.emplace(chain.module, 0);
+
+    if(chain_list.size() > UINT32_MAX)
+        throw std::length_error(TOO_MANY_CHAINS);
+
+    Bytebuf buf;
+    buf.put(CHAINS_MAGIC);
+    buf.put(CHAINS_VERSION);
+    buf.put(static_cast<uint32_t>(modules.size()));
+
+    uint32_t index = 0;
+    for(auto it = modules.begin(); it != modules.end(); it++)
+    {
+        it->second = index++;
+        buf.put(it->first);
+    }
+
+    buf.put(static_cast<uint32_t>(chain_list.size()));
+    for(const PointerChain& chain : chain_list)
+    {
+        if(chain.offsets.size() > UINT32_MAX)
+            throw std::length_error(TOO_MANY_CHAINS);
+
+        buf.put(modules[chain.module]);
+        buf.put(static_cast<uint32_t>(chain.offsets.size()));
+
+        for(intptr_t offset : chain.offsets)
+            buf.put(static_cast<int64_t>(offset));
+    }
+
+    return buf;
+}
+
+void edo::PointerChainSet::parse(Bytebuf& buf)
+{
+    if(buf.get<uint32_t>() != CHAINS_MAGIC)
+        throw std::runtime_error(MALFORMATTED_CHAINS);
+
+    if(buf.get<uint32_t>() != CHAINS_VERSION)
+        throw std::runtime_error(MALFORMATTED_CHAINS);
+
+    // Counts are checked against the bytes left before allocating for
+    // them, so a corrupt count cannot ask for more than the buffer holds
+    auto check = [&buf](const std::size_t count, const std::size_t size)
+    {
+        if(count > (buf.size() - buf.get_pos()) / size)
+            throw std::out_of_range(OPERATION_EXCEEDS_SIZE);
+    };
+
+    uint32_t module_count = buf.get<uint32_t>();
+    check(module_count, sizeof(uint32_t));
+
+    std::vector<std::string> modules(module_count);
+    for(std::string& module : modules)
+        module = buf.get_string();
+
+    uint32_t chain_count = buf.get<uint32_t>();
+    check(chain_count, 2 * sizeof(uint32_t));
+
+    std::vector<PointerChain> parsed(chain_count);
+    for(PointerChain& chain : parsed)
+    {
+        uint32_t module = buf.get<uint32_t>();
+        if(module >= modules.size())
+            throw std::runtime_error(MALFORMATTED_CHAINS);
+
+        uint32_t offset_count = buf.get<uint32_t>();
+        check(offset_count, sizeof(int64_t));
+
+        chain.module = modules[module];
+        chain.offsets.resize(offset_count);
+        for(intptr_t& offset : chain.offsets)
+            offset = buf.get<int64_t>();
+    }
+
+    chain_list.swap(parsed);
+}
+
+void edo::PointerChainSet::save(const std::string& path) const
+{
+    Bytebuf buf = serialize();
+    edo::write_file(path, buf.data(), buf.size());
+}
+
+void edo::PointerChainSet::load(const std::string& path)
+{
+    Bytebuf buf;
+    buf.put(edo::read_file(path));
+    buf.rewind();
+    parse(buf);
+}
+
+std::size_t edo::PointerChainSet::filter(
+    const Memory& memory,
+    const RegionTable& regions,
+    const uintptr_t target
+)
+{
+    std::map<std::string, uintptr_t> bases = edo::module_bases(regions);
+    std::vector<PointerChain> kept;
+    std::vector<const PointerChain*> resolving;
+
+    PointerResolver resolver(memory);
+    resolver.set_refresh_interval(0);
+    resolver.set_regions(&regions);
+
+    for(const PointerChain& chain : chain_list)
+    {
+        auto base = bases.find(chain.module);
+        if(base == bases.end())
+            continue;
+
+        resolver.add(chain.path(base->second));
+        resolving.push_back(&chain);
+    }
+
+    resolver.resolve();
+    for(std::size_t i = 0; i < resolving.size(); i++)
+    {
+        if(resolver.valid(i) &&
+            resolver.address(i) + resolving[i]->last_offset() == target)
+        {
+            kept.push_back(*resolving[i]);
+        }
+    }
+
+    chain_list.swap(kept);
+    return chain_list.size();
+}
+
+std::map<std::string, uintptr_t> edo::module_bases(const RegionTable& regions)
+{
+    std::map<std::string, uintptr_t> bases;
+    std::map<std::string, std::string> owner_paths;
+    std::set<std::string> ambiguous;
+    std::vector<std::string> paths = owners(regions);
+
+    // Regions are sorted, so the first mapping of a file is seen first
+    for(std::size_t i = 0; i < paths.size(); i++)
+    {
+        if(paths[i].empty())
+            continue;
+
+        std::string name = file_name(paths[i]);
+        auto owner = owner_paths.emplace(name, paths[i]);
+        if(owner.second)
+            bases.emplace(name, regions.regions()[i].begin);
+        else if(owner.first->second != paths[i])
+            ambiguous.insert(name);
+    }
+
+    // It cannot be told which of several files of a name a chain means
+    for(const std::string& name : ambiguous)
+        bases.erase(name);
+
+    return bases;
+}
@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/split.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/mem/region.hpp"
+
+std::size_t edo::Region::size() const
+{
+    return end - begin;
+}
+
+edo::RegionTable::RegionTable()
+{
+
+}
+
+edo::RegionTable edo::RegionTable::load()
+{
+    return load(getpid());
+}
+
+edo::RegionTable edo::RegionTable::load(const pid_t pid)
+{
+    std::string path = "/proc/" + std::to_string(pid) + "/maps";
+    std::vector<uint8_t> contents = edo::read_file(path);
+
+    RegionTable table;
+    table.parse(std::string(contents.begin(), contents.end()));
+
+    return table;
+}
+
+void edo::RegionTable::parse(const std::string& maps_str)
+{
+    std::vector<Region> parsed;
+
+    // sscanf needs terminated lines, one buffer is reused for all of them
+    std::string line;
+    for(boost::string_view view : split_view(maps_str, '\n'))
+    {
+        if(view.empty())
+            continue;
+
+        line.assign(view.data(), view.size());
+
+        // {begin}-{end} {perms} {offset} {dev} {inode} {path}
+        unsigned long long begin, end, offset;
+        char perms[5];
+        int path_pos = 0;
+        if(std::sscanf(line.c_str(), "%llx-%llx %4s %llx %*s %*s %n",
+            &begin, &end, perms, &offset, &path_pos) < 4 || path_pos == 0)
+        {
+            throw std::runtime_error(MALFORMATTED_MAPS_STR);
+        }
+
+        Region region;
+        region.begin = begin;
+        region.end = end;
+        region.readable = perms[0] == 'r';
+        region.writable = perms[1] == 'w';
+        region.executable = perms[2] == 'x';
+        region.shared = perms[3] == 's';
+        region.offset = offset;
+        region.path = line.substr(path_pos);
+        parsed.push_back(region);
+    }
+
+    std::sort(parsed.begin(), parsed.end(),
+        [](const Region& a, const Region& b) { return a.begin < b.begin; });
+    region_list.swap(parsed);
+}
+
+const std::vector<edo::Region>& edo::RegionTable::regions() const
+{
+    return region_list;
+}
+
+std::size_t edo::RegionTable::size() const
+{
+    return region_list.size();
+}
+
+const edo::Region* edo::RegionTable::find(const uintptr_t address) const
+{
+    // First region ending after the address
+    auto it = std::upper_bound(region_list.begin(), region_list.end(), address,
+        [](const uintptr_t addr, const Region& r) { return addr < r.end; });
+
+    if(it == region_list.end() || address < it->begin)
+        return nullptr;
+
+    return &*it;
+}
+
+bool edo::RegionTable::readable(
+    const uintptr_t address,
+    const std::size_t length
+) const
+{
+    uintptr_t pos = address;
+    uintptr_t end = address + length;
+    if(end < address)
+        return false;
+
+    do
+    {
+        const Region* region = find(pos);
+        if(region == nullptr || !region->readable)
+            return false;
+
+        pos = region->end;
+    }
+    while(pos < end);
+
+    return true;
+}
@@ -0,0 +1,692 @@
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "edo/base/strings.hpp"
+#include "edo/mem/valscan.hpp"
+
+namespace
+{
+    const std::size_t BLOCK_SIZE = 4096;
+
+    // Amount of blocks read with a single read during scans
+    const std::size_t BATCH_BLOCKS = 256;
+
+    // Room for the tail of a block in read buffers
+    const std::size_t MAX_TAIL = 8;
+
+    // Dirty pages closer than this are read with a single pagemap read
+    const std::size_t MAX_PAGE_GAP = 64;
+
+    enum Encoding : uint8_t
+    {
+        ENCODING_ALL,
+        ENCODING_BITMAP,
+        ENCODING_LIST,
+    };
+
+    const uint8_t ZERO_PAGE[BLOCK_SIZE + MAX_TAIL] = {};
+
+    template<std::size_t N> struct Bits;
+    template<> struct Bits<1> { typedef uint8_t type; };
+    template<> struct Bits<2> { typedef uint16_t type; };
+    template<> struct Bits<4> { typedef uint32_t type; };
+    template<> struct Bits<8> { typedef uint64_t type; };
+
+    template<typename T>
+    int type_id()
+    {
+        return static_cast<int>(sizeof(T)) * 4 +
+            (std::is_floating_point<T>::value ? 2 : 0) +
+            (std::is_signed<T>::value ? 1 : 0);
+    }
+
+    template<typename T>
+    T load(const uint8_t* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    bool compare(const edo::ScanOp op, const T cur, const T prev,
+        const T a, const T b)
+    {
+        typedef typename Bits<sizeof(T)>::type U;
+
+        switch(op)
+        {
+            case edo::ScanOp::exact:
+                return cur == a;
+            case edo::ScanOp::range:
+                return cur >= a && cur <= b;
+            case edo::ScanOp::unknown:
+                return true;
+            case edo::ScanOp::changed:
+                return load<U>(reinterpret_cast<const uint8_t*>(&cur)) !=
+                    load<U>(reinterpret_cast<const uint8_t*>(&prev));
+            case edo::ScanOp::unchanged:
+                return load<U>(reinterpret_cast<const uint8_t*>(&cur)) ==
+                    load<U>(reinterpret_cast<const uint8_t*>(&prev));
+            case edo::ScanOp::increased:
+                return cur > prev;
+            case edo::ScanOp::decreased:
+                return cur < prev;
+        }
+
+        return false;
+    }
+
+    // Compares count values stored contiguously at cur, and prev, 16 bytes
+    // at a time and returns whether any of them match
+    template<typename T>
+    bool any_match(const edo::ScanOp op, const uint8_t* cur,
+        const uint8_t* prev, const std::size_t count, const T a, const T b)
+    {
+        typedef T V __attribute__((vector_size(16)));
+        const std::size_t lanes = 16 / sizeof(T);
+
+        V va = V() + a;
+        V vb = V() + b;
+        decltype(va == vb) acc;
+        std::memset(&acc, 0, sizeof(acc));
+
+        std::size_t i = 0;
+        for(; i + lanes <= count; i += lanes)
+        {
+            V vc;
+            V vp;
+            std::memcpy(&vc, cur + i * sizeof(T), sizeof(V));
+            if(prev != nullptr)
+                std::memcpy(&vp, prev + i * sizeof(T), sizeof(V));
+
+            switch(op)
+            {
+                case edo::ScanOp::exact:
+                    acc |= vc == va;
+                    break;
+                case edo::ScanOp::range:
+                    acc |= (vc >= va) & (vc <= vb);
+                    break;
+                case edo::ScanOp::changed:
+                    acc |= vc != vp;
+                    break;
+                case edo::ScanOp::unchanged:
+                    acc |= vc == vp;
+                    break;
+                case edo::ScanOp::increased:
+                    acc |= vc > vp;
+                    break;
+                case edo::ScanOp::decreased:
+                    acc |= vc < vp;
+                    break;
+                default:
+                    return true;
+            }
+        }
+
+        uint64_t words[2];
+        std::memcpy(words, &acc, sizeof(words));
+        if(words[0] != 0 || words[1] != 0)
+            return true;
+
+        for(; i < count; i++)
+        {
+            T p = prev != nullptr ? load<T>(prev + i * sizeof(T)) : T();
+            if(compare(op, load<T>(cur + i * sizeof(T)), p, a, b))
+                return true;
+        }
+
+        return false;
+    }
+
+    std::size_t gcd(std::size_t a, std::size_t b)
+    {
+        while(b != 0)
+        {
+            std::size_t r = a % b;
+            a = b;
+            b = r;
+        }
+
+        return a;
+    }
+
+    // Returns whether any value at the given stride in a page may match,
+    // comparing unaligned values as one contiguous array per phase
+    template<typename T>
+    bool any_match_page(const edo::ScanOp op, const uint8_t* cur,
+        const uint8_t* prev, const std::size_t length, const std::size_t avail,
+        const std::size_t stride, const T a, const T b)
+    {
+        typedef typename Bits<sizeof(T)>::type U;
+
+        // Offsets at the stride fall on every multiple of the gcd modulo
+        // the size, not only on the multiples of the stride below it
+        std::size_t step = gcd(stride, sizeof(T));
+        for(std::size_t phase = 0; phase < sizeof(T) && phase < length;
+            phase += step)
+        {
+            std::size_t count = (avail - phase) / sizeof(T);
+            const uint8_t* p = prev != nullptr ? prev + phase : nullptr;
+            bool any;
+
+            // Bitwise comparisons treat NaNs as equal to themselves
+            if(op == edo::ScanOp::changed || op == edo::ScanOp::unchanged)
+                any = any_match<U>(op, cur + phase, p, count, U(), U());
+            else
+                any = any_match<T>(op, cur + phase, p, count, a, b);
+
+            if(any)
+                return true;
+        }
+
+        return false;
+    }
+
+    std::size_t varint_size(const std::size_t value)
+    {
+        return value < 0x80 ? 1 : 2;
+    }
+}
+
+edo::ValueScanner::ValueScanner()
+{
+    tracker = nullptr;
+    tracking = false;
+    alignment = 0;
+    stride = 1;
+    type_size = 1;
+    type_id = 0;
+}
+
+edo::ValueScanner::ValueScanner(const Memory& memory) : memory(memory)
+{
+    tracker = nullptr;
+    tracking = false;
+    alignment = 0;
+    stride = 1;
+    type_size = 1;
+    type_id = 0;
+}
+
+void edo::ValueScanner::set_alignment(const std::size_t alignment)
+{
+    this->alignment = alignment;
+}
+
+void edo::ValueScanner::set_dirty_tracker(DirtyTracker* tracker)
+{
+    this->tracker = tracker;
+    tracking = false;
+}
+
+template<typename T>
+std::size_t edo::ValueScanner::first_scan(
+    const RegionTable& regions,
+    const ScanOp op,
+    const T a,
+    const T b
+)
+{
+    if(op != ScanOp::exact && op != ScanOp::range && op != ScanOp::unknown)
+        throw std::invalid_argument(INVALID_SCAN_OP);
+
+    reset();
+    type_id = ::type_id<T>();
+    type_size = sizeof(T);
+    stride = alignment == 0 ? sizeof(T) : alignment;
+
+    // Writes are tracked from before the pages are first read
+    tracking = tracker != nullptr && tracker->clear();
+    std::vector<uint8_t> data(BATCH_BLOCKS * BLOCK_SIZE + MAX_TAIL);
+
+    for(const Region& region : regions.regions())
+    {
+        if(!region.readable || !region.writable)
+            continue;
+
+        for(uintptr_t pos = region.begin; pos < region.end;
+            pos += BATCH_BLOCKS * BLOCK_SIZE)
+        {
+            std::size_t length = std::min<std::size_t>(
+                BATCH_BLOCKS * BLOCK_SIZE, region.end - pos);
+            std::size_t tail = std::min<std::size_t>(
+                sizeof(T) - 1, region.end - pos - length);
+
+            // Fall back to reading every page on its own if a page of the
+            // batch could not be read
+            bool batch_ok = memory.read(pos, data.data(), length + tail);
+
+            for(std::size_t offset = 0; offset < length; offset += BLOCK_SIZE)
+            {
+                Block block;
+                block.address = pos + offset;
+                block.length = static_cast<uint16_t>(
+                    std::min(BLOCK_SIZE, length - offset));
+                block.tail = static_cast<uint8_t>(
+                    std::min<std::size_t>(sizeof(T) - 1,
+                        region.end - block.address - block.length));
+                block.encoding = ENCODING_ALL;
+                block.count = 0;
+
+                if(!batch_ok && !memory.read(block.address, &data[offset],
+                    block.length + block.tail))
+                {
+                    continue;
+                }
+
+                scan_block<T>(block, &data[offset], op, a, b);
+                if(block.count > 0)
+                    blocks.push_back(std::move(block));
+            }
+        }
+    }
+
+    return count();
+}
+
+template<typename T>
+std::size_t edo::ValueScanner::next_scan(const ScanOp op, const T a, const T b)
+{
+    if(op == ScanOp::unknown || type_id != ::type_id<T>())
+        throw std::invalid_argument(INVALID_SCAN_OP);
+
+    const std::size_t block_stride = BLOCK_SIZE + MAX_TAIL;
+    std::vector<uint8_t> data(BATCH_BLOCKS * block_stride);
+    std::vector<ReadOp> ops;
+    std::vector<Block> kept;
+
+    // Find the pages written to since the last scan, and start tracking
+    // writes for the next one
+    std::vector<uint8_t> dirty(blocks.size(), 1);
+    if(tracking)
+        find_dirty(dirty);
+    tracking = tracker != nullptr && tracker->clear();
+
+    for(std::size_t first = 0; first < blocks.size(); first += BATCH_BLOCKS)
+    {
+        std::size_t last = std::min(blocks.size(), first + BATCH_BLOCKS);
+
+        // Reread the current contents of every dirty block in one batch
+        ops.clear();
+        for(std::size_t i = first; i < last; i++)
+        {
+            if(!dirty[i])
+                continue;
+
+            ReadOp op;
+            op.address = blocks[i].address;
+            op.out = &data[(i - first) * block_stride];
+            op.length = blocks[i].length + blocks[i].tail;
+            ops.push_back(op);
+        }
+
+        memory.read_batch(ops);
+
+        std::size_t read = 0;
+        for(std::size_t i = first; i < last; i++)
+        {
+            uint8_t* block_data = &data[(i - first) * block_stride];
+
+            if(!dirty[i])
+                scan_clean_block<T>(blocks[i], block_data, op, a, b);
+            else if(ops[read++].ok)
+                scan_block<T>(blocks[i], block_data, op, a, b);
+            else
+                continue;
+
+            if(blocks[i].count > 0)
+                kept.push_back(std::move(blocks[i]));
+        }
+    }
+
+    blocks.swap(kept);
+    return count();
+}
+
+template<typename T>
+void edo::ValueScanner::scan_block(
+    Block& block,
+    const uint8_t* data,
+    const ScanOp op,
+    const T a,
+    const T b
+)
+{
+    // Blocks of a first scan have no candidates yet
+    std::size_t avail = block.length + block.tail;
+    bool first = block.count == 0;
+    scratch.clear();
+
+    if(first && op == ScanOp::unknown)
+    {
+        std::vector<uint16_t> none;
+        block.count = static_cast<uint32_t>(slots(block));
+        encode(block, none, data);
+        return;
+    }
+
+    if(first || block.encoding == ENCODING_ALL)
+    {
+        // Every offset is compared, so the page is checked with SIMD first
+        const uint8_t* prev = nullptr;
+        if(!first)
+            prev = block.values.empty() ? ZERO_PAGE : block.values.data();
+
+        if(any_match_page<T>(op, data, prev, block.length, avail, stride, a, b))
+        {
+            for(std::size_t offset = 0; offset < block.length &&
+                offset + sizeof(T) <= avail; offset += stride)
+            {
+                T p = prev != nullptr ? load<T>(prev + offset) : T();
+                if(compare(op, load<T>(data + offset), p, a, b))
+                    scratch.push_back(static_cast<uint16_t>(offset));
+            }
+        }
+    }
+    else
+    {
+        std::vector<uint16_t> offsets;
+        decode(block, offsets);
+
+        for(std::size_t i = 0; i < offsets.size(); i++)
+        {
+            T cur = load<T>(data + offsets[i]);
+            T prev = load<T>(&block.values[i * sizeof(T)]);
+            if(compare(op, cur, prev, a, b))
+                scratch.push_back(offsets[i]);
+        }
+    }
+
+    block.count = static_cast<uint32_t>(scratch.size());
+    if(block.count > 0)
+        encode(block, scratch, data);
+}
+
+template<typename T>
+void edo::ValueScanner::scan_clean_block(
+    Block& block,
+    uint8_t* page,
+    const ScanOp op,
+    const T a,
+    const T b
+)
+{
+    switch(op)
+    {
+        case ScanOp::changed:
+        case ScanOp::increased:
+        case ScanOp::decreased:
+            block.count = 0;
+            return;
+        case ScanOp::unchanged:
+            return;
+        default:
+            break;
+    }
+
+    // Rebuild the page from the stored values and compare it to itself
+    std::size_t avail = block.length + block.tail;
+    std::memset(page, 0, avail);
+
+    if(block.encoding == ENCODING_ALL)
+        std::memcpy(page, block.values.data(), block.values.size());
+    else
+    {
+        std::vector<uint16_t> offsets;
+        decode(block, offsets);
+
+        for(std::size_t i = 0; i < offsets.size(); i++)
+        {
+            std::memcpy(page + offsets[i], &block.values[i * sizeof(T)],
+                sizeof(T));
+        }
+    }
+
+    scan_block<T>(block, page, op, a, b);
+}
+
+std::size_t edo::ValueScanner::count() const
+{
+    std::size_t res = 0;
+    for(const Block& block : blocks)
+        res += block.count;
+
+    return res;
+}
+
+std::vector<uintptr_t> edo::ValueScanner::addresses(const std::size_t max) const
+{
+    std::vector<uintptr_t> res;
+    std::vector<uint16_t> offsets;
+
+    for(const Block& block : blocks)
+    {
+        decode(block, offsets);
+        for(uint16_t offset : offsets)
+        {
+            if(max != 0 && res.size() >= max)
+                return res;
+
+            res.push_back(block.address + offset);
+        }
+    }
+
+    return res;
+}
+
+std::size_t edo::ValueScanner::memory_usage() const
+{
+    std::size_t res = blocks.capacity() * sizeof(Block);
+    for(const Block& block : blocks)
+        res += block.candidates.capacity() + block.values.capacity();
+
+    return res;
+}
+
+void edo::ValueScanner::reset()
+{
+    std::vector<Block>().swap(blocks);
+}
+
+void edo::ValueScanner::find_dirty(std::vector<uint8_t>& dirty)
+{
+    std::size_t page = DirtyTracker::page_size();
+    std::vector<uint8_t> bits;
+    dirty.assign(blocks.size(), 1);
+
+    std::size_t first = 0;
+    while(first < blocks.size())
+    {
+        // Pages of nearby blocks are read together
+        uintptr_t begin = blocks[first].address / page * page;
+        uintptr_t end = 0;
+        std::size_t last = first;
+
+        while(true)
+        {
+            const Block& block = blocks[last];
+            end = (block.address + block.length + block.tail + page - 1) /
+                page * page;
+
+            if(last + 1 >= blocks.size() ||
+                blocks[last + 1].address >= end + MAX_PAGE_GAP * page)
+            {
+                break;
+            }
+
+            last++;
+        }
+
+        // Blocks are considered dirty if the bits cannot be read
+        if(tracker->dirty(begin, (end - begin) / page, bits))
+        {
+            for(std::size_t i = first; i <= last; i++)
+            {
+                const Block& block = blocks[i];
+                std::size_t head = (block.address - begin) / page;
+                std::size_t tail = (block.address + block.length +
+                    block.tail - 1 - begin) / page;
+
+                dirty[i] = bits[head] | bits[tail];
+            }
+        }
+
+        first = last + 1;
+    }
+}
+
+std::size_t edo::ValueScanner::slots(const Block& block) const
+{
+    std::size_t avail = block.length + block.tail;
+    if(avail < type_size)
+        return 0;
+
+    std::size_t last = std::min<std::size_t>(block.length - 1,
+        avail - type_size);
+    return last / stride + 1;
+}
+
+void edo::ValueScanner::encode(
+    Block& block,
+    const std::vector<uint16_t>& offsets,
+    const uint8_t* data
+) const
+{
+    std::size_t total = slots(block);
+    block.candidates.clear();
+
+    if(block.count == total)
+    {
+        // Every offset is a candidate, keep a copy of the page
+        std::size_t avail = block.length + block.tail;
+        block.encoding = ENCODING_ALL;
+
+        if(std::memcmp(data, ZERO_PAGE, avail) == 0)
+            block.values.clear();
+        else
+            block.values.assign(data, data + avail);
+
+        block.values.shrink_to_fit();
+        block.candidates.shrink_to_fit();
+        return;
+    }
+
+    // Offsets are stored in units of the stride
+    std::size_t bitmap_size = (total + 7) / 8;
+    std::size_t list_size = 0;
+    std::size_t prev = 0;
+    for(uint16_t offset : offsets)
+    {
+        list_size += varint_size(offset / stride - prev);
+        prev = offset / stride;
+    }
+
+    if(bitmap_size <= list_size)
+    {
+        block.encoding = ENCODING_BITMAP;
+        block.candidates.assign(bitmap_size, 0);
+        for(uint16_t offset : offsets)
+        {
+            std::size_t bit = offset / stride;
+            block.candidates[bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+        }
+    }
+    else
+    {
+        block.encoding = ENCODING_LIST;
+        block.candidates.reserve(list_size);
+        prev = 0;
+        for(uint16_t offset : offsets)
+        {
+            std::size_t delta = offset / stride - prev;
+            prev = offset / stride;
+
+            if(delta < 0x80)
+                block.candidates.push_back(static_cast<uint8_t>(delta));
+            else
+            {
+                block.candidates.push_back(
+                    static_cast<uint8_t>(0x80 | (delta >> 8)));
+                block.candidates.push_back(static_cast<uint8_t>(delta & 0xFF));
+            }
+        }
+    }
+
+    block.values.resize(offsets.size() * type_size);
+    for(std::size_t i = 0; i < offsets.size(); i++)
+        std::memcpy(&block.values[i * type_size], data + offsets[i], type_size);
+
+    block.values.shrink_to_fit();
+    block.candidates.shrink_to_fit();
+}
+
+void edo::ValueScanner::decode(
+    const Block& block,
+    std::vector<uint16_t>& offsets
+) const
+{
+    offsets.clear();
+
+    if(block.encoding == ENCODING_ALL)
+    {
+        std::size_t total = slots(block);
+        for(std::size_t i = 0; i < total; i++)
+            offsets.push_back(static_cast<uint16_t>(i * stride));
+    }
+    else if(block.encoding == ENCODING_BITMAP)
+    {
+        for(std::size_t i = 0; i < block.candidates.size(); i++)
+        {
+            uint8_t byte = block.candidates[i];
+            for(std::size_t bit = 0; byte != 0; bit++, byte >>= 1)
+            {
+                if(byte & 1)
+                    offsets.push_back(static_cast<uint16_t>((i * 8 + bit) * stride));
+            }
+        }
+    }
+    else
+    {
+        std::size_t pos = 0;
+        for(std::size_t i = 0; i < block.candidates.size(); i++)
+        {
+            std::size_t delta = block.candidates[i];
+            if(delta & 0x80)
+                delta = (delta & 0x7F) << 8 | block.candidates[++i];
+
+            pos += delta;
+            offsets.push_back(static_cast<uint16_t>(pos * stride));
+        }
+    }
+}
+
+// Instantiates the scans for every supported type
+#define SCAN(type)\
+template std::size_t edo::ValueScanner::first_scan<type>(\
+    const RegionTable&, const ScanOp, const type, const type);\
+template std::size_t edo::ValueScanner::next_scan<type>(\
+    const ScanOp, const type, const type);\
+
+SCAN(int8_t)
+
+SCAN(int16_t)
+
+SCAN(int32_t)
+
+SCAN(int64_t)
+
+SCAN(uint8_t)
+
+SCAN(uint16_t)
+
+SCAN(uint32_t)
+
+SCAN(uint64_t)
+
+SCAN(float)
+
+SCAN(double)
@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "edo/base/strings.hpp"
+#include "edo/mem/watch.hpp"
+
+namespace
+{
+    const std::size_t NO_PATH = static_cast<std::size_t>(-1);
+
+    /// Ids hold the slot of a watch in their low half and the generation
+    /// of the slot in their high half
+    const std::size_t SLOT_MASK = 0xFFFFFFFF;
+    const int GENERATION_SHIFT = 32;
+}
+
+edo::WatchList::WatchList()
+{
+    max_gap = 64;
+    active = 0;
+    dirty_layout = false;
+    dirty_paths = false;
+}
+
+edo::WatchList::WatchList(const Memory& memory) :
+    memory(memory), resolver(memory)
+{
+    max_gap = 64;
+    active = 0;
+    dirty_layout = false;
+    dirty_paths = false;
+}
+
+std::size_t edo::WatchList::watch(
+    const uintptr_t address,
+    const std::size_t length,
+    const Callback& callback
+)
+{
+    Watch watch;
+    watch.path = NO_PATH;
+    watch.offset = 0;
+    watch.address = address;
+    watch.length = length;
+    watch.callback = callback;
+
+    return add(watch);
+}
+
+std::size_t edo::WatchList::watch(
+    const PointerPath& path,
+    const intptr_t offset,
+    const std::size_t length,
+    const Callback& callback
+)
+{
+    Watch watch;
+    watch.path = resolver.add(path);
+    watch.offset = offset;
+    watch.address = 0;
+    watch.length = length;
+    watch.callback = callback;
+
+    return add(watch);
+}
+
+void edo::WatchList::unwatch(const std::size_t id)
+{
+    Watch& watch = watch_list[slot(id)];
+    watch.active = false;
+    watch.valid = false;
+    watch.callback = Callback();
+    watch.generation++;
+    if(watch.path != NO_PATH)
+        dirty_paths = true;
+
+    free_slots.push_back(id & SLOT_MASK);
+    free_values.push_back(Range{watch.value_offset, watch.length});
+    active--;
+    dirty_layout = true;
+}
+
+void edo::WatchList::set_max_gap(const std::size_t gap)
+{
+    max_gap = gap;
+    dirty_layout = true;
+}
+
+std::size_t edo::WatchList::poll()
+{
+    if(dirty_paths)
+        compact_paths();
+
+    // Watches on pointer paths move when their path resolves elsewhere
+    if(resolver.size() > 0)
+    {
+        resolver.resolve();
+
+        for(Watch& watch : watch_list)
+        {
+            if(!watch.active || watch.path == NO_PATH)
+                continue;
+
+            uintptr_t address = resolver.valid(watch.path) ?
+                resolver.address(watch.path) + watch.offset : 0;
+            if(address != watch.address)
+            {
+                watch.address = address;
+                dirty_layout = true;
+            }
+        }
+    }
+
+    if(dirty_layout)
+        layout();
+
+    // Read every span in one batch
+    ops.resize(span_list.size());
+    for(std::size_t i = 0; i < span_list.size(); i++)
+    {
+        ops[i].address = span_list[i].address;
+        ops[i].out = &buffer[span_list[i].buffer_offset];
+        ops[i].length = span_list[i].length;
+    }
+
+    memory.read_batch(ops);
+
+    // A span may cover unreadable memory between its watches, so the
+    // watches of failed spans are read on their own
+    std::vector<ReadOp> retries;
+    std::vector<std::size_t> retried;
+    std::vector<uint8_t> ok(watch_list.size(), 0);
+
+    for(std::size_t i = 0; i < span_list.size(); i++)
+    {
+        for(std::size_t index : span_list[i].watches)
+        {
+            if(ops[i].ok)
+            {
+                ok[index] = 1;
+                continue;
+            }
+
+            const Watch& watch = watch_list[index];
+            ReadOp op;
+            op.address = watch.address;
+            op.out = &buffer[watch.span_offset];
+            op.length = watch.length;
+            retries.push_back(op);
+            retried.push_back(index);
+        }
+    }
+
+    if(!retries.empty())
+    {
+        memory.read_batch(retries);
+        for(std::size_t i = 0; i < retries.size(); i++)
+            ok[retried[i]] = retries[i].ok ? 1 : 0;
+    }
+
+    // Find the changed watches and remember their previous values, as
+    // callbacks may add watches and move the stored values
+    std::vector<std::size_t> changed;
+    std::vector<uint8_t> previous;
+    std::vector<std::size_t> previous_offsets;
+
+    for(std::size_t index = 0; index < watch_list.size(); index++)
+    {
+        Watch& watch = watch_list[index];
+        if(!watch.active)
+            continue;
+
+        if(!ok[index])
+        {
+            watch.valid = false;
+            continue;
+        }
+
+        const uint8_t* cur = &buffer[watch.span_offset];
+        uint8_t* stored = &values[watch.value_offset];
+        if(watch.valid && std::memcmp(cur, stored, watch.length) == 0)
+            continue;
+
+        previous_offsets.push_back(previous.size());
+        if(watch.valid)
+            previous.insert(previous.end(), stored, stored + watch.length);
+        else
+            previous.insert(previous.end(), cur, cur + watch.length);
+
+        std::memcpy(stored, cur, watch.length);
+        watch.valid = true;
+        changed.push_back(id_of(index));
+    }
+
+    for(std::size_t i = 0; i < changed.size(); i++)
+    {
+        // An earlier callback may have removed the watch, and a new one may
+        // hold its slot already
+        Watch& watch = watch_list[changed[i] & SLOT_MASK];
+        if(!watch.active || id_of(changed[i] & SLOT_MASK) != changed[i])
+            continue;
+
+        // Copy the callback, as it may unwatch itself
+        Callback callback = watch.callback;
+        if(callback)
+        {
+            callback(&buffer[watch.span_offset],
+                &previous[previous_offsets[i]]);
+        }
+    }
+
+    return changed.size();
+}
+
+const uint8_t* edo::WatchList::get(const std::size_t id) const
+{
+    const Watch& watch = watch_list[slot(id)];
+    if(!watch.valid)
+        return nullptr;
+
+    return &values[watch.value_offset];
+}
+
+std::size_t edo::WatchList::size() const
+{
+    return active;
+}
+
+std::size_t edo::WatchList::spans() const
+{
+    return span_list.size();
+}
+
+std::size_t edo::WatchList::add(Watch& watch)
+{
+    watch.active = true;
+    watch.valid = false;
+    watch.value_offset = allocate(watch.length);
+    watch.span_offset = 0;
+    watch.generation = 0;
+
+    std::size_t index = watch_list.size();
+    if(!free_slots.empty())
+    {
+        index = free_slots.back();
+        free_slots.pop_back();
+        watch.generation = watch_list[index].generation;
+        watch_list[index] = watch;
+    }
+    else
+    {
+        watch_list.push_back(watch);
+    }
+
+    active++;
+    dirty_layout = true;
+
+    return id_of(index);
+}
+
+std::size_t edo::WatchList::slot(const std::size_t id) const
+{
+    std::size_t index = id & SLOT_MASK;
+    if(index >= watch_list.size() || !watch_list[index].active ||
+        watch_list[index].generation != id >> GENERATION_SHIFT)
+        throw std::out_of_range(NONEXISTANT_WATCH);
+
+    return index;
+}
+
+std::size_t edo::WatchList::id_of(const std::size_t index) const
+{
+    return static_cast<std::size_t>(watch_list[index].generation)
+        << GENERATION_SHIFT | index;
+}
+
+std::size_t edo::WatchList::allocate(const std::size_t length)
+{
+    // First fit, the rest of a larger range stays free
+    for(std::size_t i = 0; i < free_values.size(); i++)
+    {
+        Range& range = free_values[i];
+        if(range.length < length)
+            continue;
+
+        std::size_t offset = range.offset;
+        range.offset += length;
+        range.length -= length;
+        if(range.length == 0)
+        {
+            range = free_values.back();
+            free_values.pop_back();
+        }
+
+        return offset;
+    }
+
+    std::size_t offset = values.size();
+    values.resize(values.size() + length, 0);
+    return offset;
+}
+
+void edo::WatchList::compact_paths()
+{
+    // The resolver has no removal, as its indices have to stay stable, so
+    // the remaining paths are added again and lose their memoized chains
+    std::vector<PointerPath> paths;
+    for(Watch& watch : watch_list)
+    {
+        if(!watch.active || watch.path == NO_PATH)
+        {
+            watch.path = NO_PATH;
+            continue;
+        }
+
+        paths.push_back(resolver.path(watch.path));
+        watch.path = paths.size() - 1;
+    }
+
+    resolver.clear();
+    for(const PointerPath& path : paths)
+        resolver.add(path);
+
+    dirty_paths = false;
+}
+
+void edo::WatchList::layout()
+{
+    std::vector<std::size_t> order;
+    for(std::size_t i = 0; i < watch_list.size(); i++)
+    {
+        if(watch_list[i].active && watch_list[i].address != 0)
+            order.push_back(i);
+    }
+
+    std::sort(order.begin(), order.end(),
+        [this](const std::size_t a, const std::size_t b)
+        {
+            return watch_list[a].address < watch_list[b].address;
+        });
+
+    // Coalesce watches closer than the maximum gap into spans
+    span_list.clear();
+    std::size_t total = 0;
+    for(std::size_t index : order)
+    {
+        Watch& watch = watch_list[index];
+        Span* span = span_list.empty() ? nullptr : &span_list.back();
+
+        if(span == nullptr ||
+            watch.address > span->address + span->length + max_gap)
+        {
+            if(span != nullptr)
+                total += span->length;
+
+            Span next;
+            next.address = watch.address;
+            next.length = 0;
+            next.buffer_offset = total;
+            span_list.push_back(next);
+            span = &span_list.back();
+        }
+
+        span->length = std::max(span->length,
+            watch.address + watch.length - span->address);
+        span->watches.push_back(index);
+        watch.span_offset = span->buffer_offset + watch.address - span->address;
+    }
+
+    if(!span_list.empty())
+        total += span_list.back().length;
+
+    buffer.assign(total, 0);
+    dirty_layout = false;
+}
@@ -0,0 +1,171 @@
+#include <cstdio>
+#include <cctype>
+#include <stdexcept>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/scan/pattern.hpp"
+
+namespace
+{
+    int hex_value(const char c)
+    {
+        if(c >= '0' && c <= '9')
+            return c - '0';
+        if(c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if(c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+
+        return -1;
+    }
+}
+
+edo::Pattern::Pattern()
+{
+    anchor_index = 0;
+}
+
+edo::Pattern::Pattern(const std::string& pattern_str)
+{
+    std::size_t i = 0;
+    while(i < pattern_str.size())
+    {
+        if(std::isspace(static_cast<unsigned char>(pattern_str[i])))
+        {
+            i++;
+            continue;
+        }
+
+        // Find the end of the token
+        std::size_t end = i;
+        while(end < pattern_str.size() &&
+            !std::isspace(static_cast<unsigned char>(pattern_str[end])))
+        {
+            end++;
+        }
+
+        std::string token = pattern_str.substr(i, end - i);
+        if(token == "?" || token == "??")
+        {
+            pattern_bytes.push_back(0);
+            pattern_mask.push_back(0);
+        }
+        else if(token.size() == 2 && hex_value(token[0]) >= 0 &&
+            hex_value(token[1]) >= 0)
+        {
+            pattern_bytes.push_back(
+                static_cast<uint8_t>(hex_value(token[0]) << 4 |
+                    hex_value(token[1]))
+            );
+            pattern_mask.push_back(0xFF);
+        }
+        else
+            throw std::runtime_error(MALFORMATTED_PATTERN);
+
+        i = end;
+    }
+
+    choose_anchor();
+}
+
+edo::Pattern::Pattern(
+    const std::vector<uint8_t>& bytes,
+    const std::vector<uint8_t>& mask
+)
+{
+    if(bytes.size() != mask.size())
+        throw std::runtime_error(MALFORMATTED_PATTERN);
+
+    pattern_bytes = bytes;
+    pattern_mask = mask;
+    for(std::size_t i = 0; i < pattern_bytes.size(); i++)
+    {
+        pattern_mask[i] = pattern_mask[i] == 0 ? 0 : 0xFF;
+        pattern_bytes[i] &= pattern_mask[i];
+    }
+
+    choose_anchor();
+}
+
+void edo::Pattern::choose_anchor()
+{
+    // Choose the rarest fixed byte as anchor, a pattern without any fixed
+    // bytes cannot be scanned for
+    bool has_anchor = false;
+    anchor_index = 0;
+    for(std::size_t j = 0; j < pattern_bytes.size(); j++)
+    {
+        if(pattern_mask[j] == 0)
+            continue;
+
+        if(!has_anchor || byte_frequency(pattern_bytes[j]) <
+            byte_frequency(pattern_bytes[anchor_index]))
+        {
+            anchor_index = j;
+            has_anchor = true;
+        }
+    }
+
+    if(!has_anchor)
+        throw std::runtime_error(MALFORMATTED_PATTERN);
+}
+
+std::size_t edo::Pattern::size() const
+{
+    return pattern_bytes.size();
+}
+
+const std::vector<uint8_t>& edo::Pattern::bytes() const
+{
+    return pattern_bytes;
+}
+
+const std::vector<uint8_t>& edo::Pattern::mask() const
+{
+    return pattern_mask;
+}
+
+std::size_t edo::Pattern::anchor() const
+{
+    return anchor_index;
+}
+
+bool edo::Pattern::matches(const uint8_t* data) const
+{
+    for(std::size_t i = 0; i < pattern_bytes.size(); i++)
+    {
+        if((data[i] & pattern_mask[i]) != pattern_bytes[i])
+            return false;
+    }
+
+    return true;
+}
+
+uint64_t edo::Pattern::hash() const
+{
+    uint64_t res = edo::fnv1a(pattern_bytes.data(), pattern_bytes.size());
+    return edo::fnv1a(pattern_mask.data(), pattern_mask.size(), res);
+}
+
+std::string edo::Pattern::str() const
+{
+    std::string res;
+    char hex[4];
+
+    for(std::size_t i = 0; i < pattern_bytes.size(); i++)
+    {
+        if(i != 0)
+            res += ' ';
+
+        if(pattern_mask[i] == 0)
+            res += "??";
+        else
+        {
+            std::snprintf(hex, sizeof(hex), "%02X", pattern_bytes[i]);
+            res += hex;
+        }
+    }
+
+    return res;
+}
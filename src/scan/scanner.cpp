@@ -0,0 +1,208 @@
+#include <cstring>
+#include <stdexcept>
+#include <link.h>
+
+#include "edo/base/strings.hpp"
+#include "edo/base/profiler.hpp"
+#include "edo/scan/scanner.hpp"
+
+const uint8_t* edo::find(
+    const Pattern& pattern,
+    const uint8_t* begin,
+    const uint8_t* end
+)
+{
+    std::size_t size = pattern.size();
+    if(size == 0 || static_cast<std::size_t>(end - begin) < size)
+        return nullptr;
+
+    // Search for the anchor byte with memchr and verify the rest in place
+    std::size_t anchor = pattern.anchor();
+    uint8_t anchor_byte = pattern.bytes()[anchor];
+    const uint8_t* pos = begin + anchor;
+    const uint8_t* last = end - size + anchor;
+
+    while(pos <= last)
+    {
+        const void* found = std::memchr(pos, anchor_byte, last - pos + 1);
+        if(found == nullptr)
+            return nullptr;
+
+        const uint8_t* candidate = static_cast<const uint8_t*>(found);
+        if(pattern.matches(candidate - anchor))
+            return candidate - anchor;
+
+        pos = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+std::vector<const uint8_t*> edo::find_all(
+    const Pattern& pattern,
+    const uint8_t* begin,
+    const uint8_t* end
+)
+{
+    std::vector<const uint8_t*> res;
+    const uint8_t* pos = begin;
+
+    while(true)
+    {
+        const uint8_t* hit = edo::find(pattern, pos, end);
+        if(hit == nullptr)
+            break;
+
+        res.push_back(hit);
+        pos = hit + 1;
+    }
+
+    return res;
+}
+
+edo::Scanner::Scanner()
+{
+
+}
+
+std::size_t edo::Scanner::add(const Pattern& pattern)
+{
+    // Default constructed patterns have no anchor to look up
+    if(pattern.size() == 0 || pattern.mask()[pattern.anchor()] == 0)
+        throw std::invalid_argument(EMPTY_PATTERN);
+
+    std::size_t index = patterns.size();
+    patterns.push_back(pattern);
+
+    Candidate candidate;
+    candidate.index = index;
+    candidate.anchor = pattern.anchor();
+    anchors[pattern.bytes()[pattern.anchor()]].push_back(candidate);
+
+    return index;
+}
+
+std::size_t edo::Scanner::size() const
+{
+    return patterns.size();
+}
+
+void edo::Scanner::clear()
+{
+    patterns.clear();
+    for(auto& bucket : anchors)
+        bucket.clear();
+}
+
+std::vector<const uint8_t*> edo::Scanner::scan(
+    const uint8_t* begin,
+    const uint8_t* end
+) const
+{
+    std::vector<const uint8_t*> hits(patterns.size(), nullptr);
+    scan(begin, end, hits);
+
+    return hits;
+}
+
+std::size_t edo::Scanner::scan(
+    const uint8_t* begin,
+    const uint8_t* end,
+    std::vector<const uint8_t*>& hits
+) const
+{
+    EDO_PROFILE_SCOPE("scan.scan");
+    EDO_PROFILE_COUNT("scan.bytes", end - begin);
+
+    hits.resize(patterns.size(), nullptr);
+
+    std::size_t pending = 0;
+    for(auto hit : hits)
+    {
+        if(hit == nullptr)
+            pending++;
+    }
+
+    // A single pattern is found faster through memchr
+    if(pending == 1)
+    {
+        for(std::size_t i = 0; i < hits.size(); i++)
+        {
+            if(hits[i] == nullptr)
+            {
+                hits[i] = edo::find(patterns[i], begin, end);
+                return hits[i] == nullptr ? 1 : 0;
+            }
+        }
+    }
+
+    for(const uint8_t* pos = begin; pos < end && pending > 0; pos++)
+    {
+        const std::vector<Candidate>& bucket = anchors[*pos];
+        if(bucket.empty())
+            continue;
+
+        for(const Candidate& candidate : bucket)
+        {
+            if(hits[candidate.index] != nullptr)
+                continue;
+
+            const Pattern& pattern = patterns[candidate.index];
+            if(static_cast<std::size_t>(pos - begin) < candidate.anchor)
+                continue;
+
+            const uint8_t* start = pos - candidate.anchor;
+            if(static_cast<std::size_t>(end - start) < pattern.size())
+                continue;
+
+            if(pattern.matches(start))
+            {
+                hits[candidate.index] = start;
+                pending--;
+            }
+        }
+    }
+
+    return pending;
+}
+
+std::vector<const uint8_t*> edo::Scanner::scan(
+    const ElfFile& file,
+    const std::vector<std::string>& sections
+) const
+{
+    std::vector<const uint8_t*> hits(patterns.size(), nullptr);
+    if(patterns.empty())
+        return hits;
+
+    if(file.sections().empty())
+    {
+        for(const ElfSegment& segment : file.segments())
+        {
+            if(segment.type != PT_LOAD || !(segment.flags & PF_R) ||
+                (segment.flags & PF_W))
+            {
+                continue;
+            }
+
+            const uint8_t* begin = file.data() + segment.offset;
+            if(scan(begin, begin + segment.file_size, hits) == 0)
+                break;
+        }
+
+        return hits;
+    }
+
+    for(const std::string& name : sections)
+    {
+        const ElfSection* section = file.section(name);
+        if(section == nullptr || section->type == SHT_NOBITS)
+            continue;
+
+        const uint8_t* begin = file.data() + section->offset;
+        if(scan(begin, begin + section->size, hits) == 0)
+            break;
+    }
+
+    return hits;
+}
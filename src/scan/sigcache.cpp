@@ -0,0 +1,241 @@
+#include <vector>
+#include <stdexcept>
+#include <link.h>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/strings.hpp"
+#include "edo/scan/scanner.hpp"
+#include "edo/scan/sigcache.hpp"
+
+namespace
+{
+    const uint32_t CACHE_MAGIC = 0x43534445; // "EDSC"
+    const uint32_t CACHE_VERSION = 1;
+}
+
+edo::SignatureCache::SignatureCache()
+{
+    scan_count = 0;
+}
+
+bool edo::SignatureCache::load(const std::string& path)
+{
+    clear();
+
+    try
+    {
+        Bytebuf buf;
+        buf.put(edo::read_file(path));
+        buf.rewind();
+        parse(buf);
+    }
+    catch(const std::exception&)
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+void edo::SignatureCache::save(const std::string& path)
+{
+    Bytebuf buf = serialize();
+    edo::write_file(path, buf.data(), buf.size());
+}
+
+edo::Bytebuf edo::SignatureCache::serialize()
+{
+    Bytebuf buf;
+    buf.put(CACHE_MAGIC);
+    buf.put(CACHE_VERSION);
+    buf.put(module_key);
+    buf.put(static_cast<uint32_t>(entries.size()));
+
+    for(auto it = entries.begin(); it != entries.end(); it++)
+    {
+        buf.put(it->first);
+        buf.put(it->second.pattern_hash);
+        buf.put(it->second.offset);
+    }
+
+    return buf;
+}
+
+void edo::SignatureCache::parse(Bytebuf& buf)
+{
+    clear();
+
+    if(buf.get<uint32_t>() != CACHE_MAGIC ||
+        buf.get<uint32_t>() != CACHE_VERSION)
+    {
+        throw std::runtime_error(MALFORMATTED_CACHE);
+    }
+
+    std::string key = buf.get_string();
+    uint32_t count = buf.get<uint32_t>();
+
+    std::map<std::string, Entry> parsed;
+    for(uint32_t i = 0; i < count; i++)
+    {
+        std::string name = buf.get_string();
+
+        Entry entry;
+        entry.pattern_hash = buf.get<uint64_t>();
+        entry.offset = buf.get<uint64_t>();
+        parsed[name] = entry;
+    }
+
+    module_key = key;
+    entries.swap(parsed);
+}
+
+const std::string& edo::SignatureCache::key()
+{
+    return module_key;
+}
+
+std::size_t edo::SignatureCache::size()
+{
+    return entries.size();
+}
+
+void edo::SignatureCache::clear()
+{
+    module_key.clear();
+    entries.clear();
+}
+
+bool edo::SignatureCache::has_key(const std::string& name)
+{
+    return entries.find(name) != entries.end();
+}
+
+void edo::SignatureCache::put(
+    const std::string& name,
+    const Pattern& pattern,
+    const uintptr_t offset
+)
+{
+    Entry entry;
+    entry.pattern_hash = pattern.hash();
+    entry.offset = offset;
+    entries[name] = entry;
+}
+
+std::map<std::string, uintptr_t> edo::SignatureCache::resolve(
+    const Module& module,
+    const std::map<std::string, Pattern>& signatures
+)
+{
+    std::map<std::string, uintptr_t> res;
+    scan_count = 0;
+
+    std::string id = module.id();
+    if(id != module_key)
+    {
+        entries.clear();
+        module_key = id;
+    }
+
+    // Validate cached hits in place and collect the stale ones
+    Scanner scanner;
+    std::vector<std::string> stale;
+    for(auto it = signatures.begin(); it != signatures.end(); it++)
+    {
+        const Pattern& pattern = it->second;
+        auto cached = entries.find(it->first);
+
+        if(cached != entries.end() &&
+            cached->second.pattern_hash == pattern.hash())
+        {
+            uintptr_t address = module.base() + cached->second.offset;
+            if(module.contains(address, pattern.size()) &&
+                pattern.matches(reinterpret_cast<const uint8_t*>(address)))
+            {
+                res[it->first] = address;
+                continue;
+            }
+        }
+
+        scanner.add(pattern);
+        stale.push_back(it->first);
+    }
+
+    scan_count = stale.size();
+    if(stale.empty())
+        return res;
+
+    // Rescan the readable segments for the stale signatures only
+    std::vector<const uint8_t*> hits(stale.size(), nullptr);
+    for(const Segment& segment : module.segments())
+    {
+        if(!(segment.flags & PF_R))
+            continue;
+
+        std::size_t pending = scanner.scan(
+            reinterpret_cast<const uint8_t*>(segment.begin),
+            reinterpret_cast<const uint8_t*>(segment.end),
+            hits
+        );
+
+        if(pending == 0)
+            break;
+    }
+
+    for(std::size_t i = 0; i < stale.size(); i++)
+    {
+        if(hits[i] == nullptr)
+        {
+            entries.erase(stale[i]);
+            continue;
+        }
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(hits[i]);
+        put(stale[i], signatures.at(stale[i]), address - module.base());
+        res[stale[i]] = address;
+    }
+
+    return res;
+}
+
+std::size_t edo::SignatureCache::prepare(
+    const ElfFile& file,
+    const std::map<std::string, Pattern>& signatures
+)
+{
+    std::string id = file.id();
+    if(id != module_key)
+    {
+        entries.clear();
+        module_key = id;
+    }
+
+    Scanner scanner;
+    for(auto it = signatures.begin(); it != signatures.end(); it++)
+        scanner.add(it->second);
+
+    std::vector<const uint8_t*> hits = scanner.scan(file);
+
+    std::size_t found = 0;
+    std::size_t i = 0;
+    for(auto it = signatures.begin(); it != signatures.end(); it++, i++)
+    {
+        if(hits[i] == nullptr)
+        {
+            entries.erase(it->first);
+            continue;
+        }
+
+        put(it->first, it->second, file.address(hits[i] - file.data()));
+        found++;
+    }
+
+    return found;
+}
+
+std::size_t edo::SignatureCache::scanned()
+{
+    return scan_count;
+}
@@ -0,0 +1,417 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "edo/base/strings.hpp"
+#include "edo/scan/x86.hpp"
+
+namespace
+{
+    /// Opcode flags
+    const uint8_t MODRM = 0x01;
+    const uint8_t IMM8 = 0x02;
+    const uint8_t IMM16 = 0x04;
+    /// 16 or 32-bit immediate depending on the operand size
+    const uint8_t IMMZ = 0x08;
+    /// 16, 32 or 64-bit immediate depending on the operand size
+    const uint8_t IMMV = 0x10;
+    const uint8_t REL8 = 0x20;
+    const uint8_t REL32 = 0x40;
+    const uint8_t INVALID = 0x80;
+
+    /// Operand layouts of the one byte and 0F opcode maps in 64-bit mode
+    /// Prefixes and escapes are handled before the tables are consulted
+    struct OpcodeTables
+    {
+        uint8_t one[256];
+        uint8_t two[256];
+
+        OpcodeTables()
+        {
+            fill(one, 0x00, 0xFF, 0);
+            fill(two, 0x00, 0xFF, MODRM);
+
+            // ALU operations, 00-3F
+            for(int op = 0x00; op < 0x40; op += 0x08)
+            {
+                fill(one, op, op + 3, MODRM);
+                one[op + 4] = IMM8;
+                one[op + 5] = IMMZ;
+                one[op + 6] = INVALID;
+                one[op + 7] = INVALID;
+            }
+
+            // Segment overrides are prefixes, 0F is an escape
+            one[0x26] = one[0x2E] = one[0x36] = one[0x3E] = one[0x0F] = 0;
+
+            one[0x60] = one[0x61] = one[0x62] = INVALID;
+            one[0x63] = MODRM;
+            one[0x68] = IMMZ;
+            one[0x69] = MODRM | IMMZ;
+            one[0x6A] = IMM8;
+            one[0x6B] = MODRM | IMM8;
+            fill(one, 0x70, 0x7F, REL8);
+            one[0x80] = MODRM | IMM8;
+            one[0x81] = MODRM | IMMZ;
+            one[0x82] = INVALID;
+            one[0x83] = MODRM | IMM8;
+            fill(one, 0x84, 0x8F, MODRM);
+            one[0x9A] = INVALID;
+            one[0xA8] = IMM8;
+            one[0xA9] = IMMZ;
+            fill(one, 0xB0, 0xB7, IMM8);
+            fill(one, 0xB8, 0xBF, IMMV);
+            one[0xC0] = one[0xC1] = MODRM | IMM8;
+            one[0xC2] = IMM16;
+            one[0xC4] = one[0xC5] = INVALID;
+            one[0xC6] = MODRM | IMM8;
+            one[0xC7] = MODRM | IMMZ;
+            one[0xC8] = IMM16 | IMM8;
+            one[0xCA] = IMM16;
+            one[0xCD] = IMM8;
+            one[0xCE] = INVALID;
+            fill(one, 0xD0, 0xD3, MODRM);
+            one[0xD4] = one[0xD5] = one[0xD6] = INVALID;
+            fill(one, 0xD8, 0xDF, MODRM);
+            fill(one, 0xE0, 0xE3, REL8);
+            fill(one, 0xE4, 0xE7, IMM8);
+            one[0xE8] = one[0xE9] = REL32;
+            one[0xEA] = INVALID;
+            one[0xEB] = REL8;
+            one[0xF6] = one[0xF7] = one[0xFE] = one[0xFF] = MODRM;
+
+            two[0x04] = two[0x0A] = two[0x0C] = INVALID;
+            fill(two, 0x05, 0x09, 0);
+            two[0x0B] = two[0x0E] = 0;
+            two[0x0F] = MODRM | IMM8;
+            fill(two, 0x24, 0x27, INVALID);
+            fill(two, 0x30, 0x3F, INVALID);
+            fill(two, 0x30, 0x35, 0);
+            two[0x37] = 0;
+            fill(two, 0x70, 0x73, MODRM | IMM8);
+            two[0x77] = 0;
+            fill(two, 0x80, 0x8F, REL32);
+            two[0xA0] = two[0xA1] = two[0xA2] = 0;
+            two[0xA4] = two[0xAC] = two[0xBA] = MODRM | IMM8;
+            two[0xA6] = two[0xA7] = INVALID;
+            two[0xA8] = two[0xA9] = two[0xAA] = 0;
+            two[0xC2] = two[0xC4] = two[0xC5] = two[0xC6] = MODRM | IMM8;
+            fill(two, 0xC8, 0xCF, 0);
+        }
+
+        static void fill(uint8_t* table, int first, int last, uint8_t flags)
+        {
+            for(int i = first; i <= last; i++)
+                table[i] = flags;
+        }
+    };
+
+    const OpcodeTables tables;
+
+    int64_t read_signed(const uint8_t* data, std::size_t size)
+    {
+        switch(size)
+        {
+            case 1:
+                return static_cast<int8_t>(data[0]);
+            case 2:
+            {
+                int16_t value;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case 4:
+            {
+                int32_t value;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            default:
+            {
+                int64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+        }
+    }
+}
+
+bool edo::Instruction::has_target() const
+{
+    return relative_size != 0;
+}
+
+bool edo::Instruction::branch() const
+{
+    return relative_size != 0 && relative_offset == immediate_offset;
+}
+
+uintptr_t edo::Instruction::target(const uintptr_t address) const
+{
+    return address + length + static_cast<intptr_t>(relative);
+}
+
+edo::Instruction edo::decode(const uint8_t* code, const std::size_t size)
+{
+    Instruction res;
+    std::memset(&res, 0, sizeof(res));
+
+    std::size_t limit = size < EDO_X86_MAX_LENGTH ? size : EDO_X86_MAX_LENGTH;
+    std::size_t pos = 0;
+    bool operand16 = false;
+    bool address32 = false;
+
+    // Legacy prefixes, in any order
+    while(pos < limit)
+    {
+        uint8_t byte = code[pos];
+        if(byte == 0x66)
+            operand16 = true;
+        else if(byte == 0x67)
+            address32 = true;
+        else if(byte != 0xF0 && byte != 0xF2 && byte != 0xF3 &&
+            byte != 0x2E && byte != 0x36 && byte != 0x3E && byte != 0x26 &&
+            byte != 0x64 && byte != 0x65)
+        {
+            break;
+        }
+
+        pos++;
+    }
+
+    // REX has to immediately precede the opcode
+    if(pos < limit && (code[pos] & 0xF0) == 0x40)
+        res.rex = code[pos++];
+
+    if(pos >= limit)
+        return res;
+
+    uint8_t flags;
+    uint8_t byte = code[pos++];
+    if(byte == 0xC4 || byte == 0xC5 || byte == 0x62)
+    {
+        // VEX and EVEX, always followed by an opcode and a ModRM byte
+        std::size_t payload = byte == 0xC5 ? 1 : byte == 0xC4 ? 2 : 3;
+        if(pos + payload >= limit || res.rex != 0)
+            return res;
+
+        res.vex = true;
+        res.map = byte == 0xC5 ? 1 : byte == 0xC4 ?
+            (code[pos] & 0x1F) : (code[pos] & 0x03);
+        if(res.map < 1 || res.map > 3)
+            return res;
+
+        pos += payload;
+        res.opcode = code[pos++];
+
+        // vzeroupper and vzeroall are the only VEX instructions without
+        // a ModRM byte, the 0F table has them as 0F 77
+        if(res.map == 1)
+            flags = tables.two[res.opcode] & (MODRM | IMM8);
+        else
+            flags = res.map == 3 ? MODRM | IMM8 : MODRM;
+
+        if(byte == 0x62)
+            flags |= MODRM;
+    }
+    else if(byte == 0x0F)
+    {
+        if(pos >= limit)
+            return res;
+
+        byte = code[pos++];
+        if(byte == 0x38 || byte == 0x3A)
+        {
+            if(pos >= limit)
+                return res;
+
+            res.map = byte == 0x38 ? 2 : 3;
+            res.opcode = code[pos++];
+            flags = res.map == 3 ? MODRM | IMM8 : MODRM;
+        }
+        else
+        {
+            res.map = 1;
+            res.opcode = byte;
+            flags = tables.two[byte];
+        }
+    }
+    else
+    {
+        res.opcode = byte;
+        flags = tables.one[byte];
+    }
+
+    if(flags & INVALID)
+        return res;
+
+    if(flags & MODRM)
+    {
+        if(pos >= limit)
+            return res;
+
+        res.has_modrm = true;
+        res.modrm = code[pos++];
+
+        uint8_t mod = res.modrm >> 6;
+        uint8_t rm = res.modrm & 0x07;
+        uint8_t reg = (res.modrm >> 3) & 0x07;
+
+        // test r/m, imm is the only form of F6 and F7 with an immediate
+        if(res.map == 0 && (res.opcode == 0xF6 || res.opcode == 0xF7) &&
+            reg < 2)
+        {
+            flags |= res.opcode == 0xF6 ? IMM8 : IMMZ;
+        }
+
+        // xbegin is encoded as C7 F8 with a relative immediate
+        if(res.map == 0 && res.opcode == 0xC7 && res.modrm == 0xF8)
+            flags |= REL32;
+
+        if(mod != 3)
+        {
+            uint8_t base = rm;
+            if(rm == 4)
+            {
+                if(pos >= limit)
+                    return res;
+
+                base = code[pos++] & 0x07;
+            }
+
+            if(mod == 1)
+                res.displacement_size = 1;
+            else if(mod == 2 || (mod == 0 && base == 5))
+                res.displacement_size = 4;
+
+            // Without a SIB byte, mod 00 rm 101 addresses relative to RIP
+            if(mod == 0 && rm == 5)
+            {
+                res.relative_offset = pos;
+                res.relative_size = 4;
+            }
+
+            res.displacement_offset = pos;
+            pos += res.displacement_size;
+        }
+    }
+
+    // moffs forms of mov take a full width address
+    if(res.map == 0 && !res.vex && res.opcode >= 0xA0 && res.opcode <= 0xA3)
+        res.immediate_size = address32 ? 4 : 8;
+    else if(flags & (IMM8 | IMM16 | IMMZ | IMMV))
+    {
+        if(flags & IMM16)
+            res.immediate_size += 2;
+        if(flags & IMM8)
+            res.immediate_size += 1;
+        if(flags & IMMZ)
+            res.immediate_size = operand16 ? 2 : 4;
+        if(flags & IMMV)
+            res.immediate_size = (res.rex & 0x08) ? 8 : operand16 ? 2 : 4;
+    }
+    else if(flags & REL8)
+        res.immediate_size = 1;
+    else if(flags & REL32)
+        res.immediate_size = 4;
+
+    if(flags & (REL8 | REL32))
+    {
+        res.relative_offset = pos;
+        res.relative_size = res.immediate_size;
+    }
+
+    res.immediate_offset = pos;
+    pos += res.immediate_size;
+
+    if(pos > limit)
+        return res;
+
+    if(res.displacement_size != 0)
+    {
+        res.displacement = static_cast<int32_t>(read_signed(
+            code + res.displacement_offset, res.displacement_size));
+    }
+
+    if(res.immediate_size != 0)
+    {
+        // enter has two separate immediates, the first one is kept
+        res.immediate = read_signed(code + res.immediate_offset,
+            res.immediate_size == 3 ? 2 : res.immediate_size);
+    }
+
+    if(res.relative_size != 0)
+    {
+        res.relative = static_cast<int32_t>(read_signed(
+            code + res.relative_offset, res.relative_size));
+    }
+
+    res.length = pos;
+    return res;
+}
+
+std::size_t edo::instruction_length(const uint8_t* code)
+{
+    return decode(code).length;
+}
+
+std::vector<uintptr_t> edo::resolve_targets(
+    const std::vector<const uint8_t*>& hits,
+    const std::vector<std::size_t>& offsets
+)
+{
+    if(!offsets.empty() && offsets.size() != hits.size())
+        throw std::invalid_argument(MISMATCHED_OFFSETS);
+
+    std::vector<uintptr_t> res(hits.size(), 0);
+    for(std::size_t i = 0; i < hits.size(); i++)
+    {
+        if(hits[i] == nullptr)
+            continue;
+
+        const uint8_t* code = hits[i] + (offsets.empty() ? 0 : offsets[i]);
+        Instruction instruction = edo::decode(code);
+
+        if(instruction.length != 0 && instruction.has_target())
+            res[i] = instruction.target(reinterpret_cast<uintptr_t>(code));
+    }
+
+    return res;
+}
+
+std::vector<uint64_t> edo::resolve_targets(
+    const ElfFile& file,
+    const std::vector<const uint8_t*>& hits,
+    const std::vector<std::size_t>& offsets
+)
+{
+    if(!offsets.empty() && offsets.size() != hits.size())
+        throw std::invalid_argument(MISMATCHED_OFFSETS);
+
+    const uint8_t* end = file.data() + file.size();
+    std::vector<uint64_t> res(hits.size(), 0);
+    for(std::size_t i = 0; i < hits.size(); i++)
+    {
+        if(hits[i] == nullptr)
+            continue;
+
+        const uint8_t* code = hits[i] + (offsets.empty() ? 0 : offsets[i]);
+        if(code < file.data() || code >= end)
+            continue;
+
+        Instruction instruction = edo::decode(code, end - code);
+        if(instruction.length == 0 || !instruction.has_target())
+            continue;
+
+        try
+        {
+            uint64_t address = file.address(code - file.data());
+            res[i] = instruction.target(address);
+        }
+        catch(const std::out_of_range&)
+        {
+
+        }
+    }
+
+    return res;
+}
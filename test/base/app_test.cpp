@@ -0,0 +1,241 @@
+#include <atomic>
+#include <thread>
+#include <unistd.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/app.hpp"
+#include "edo/base/bytebuf.hpp"
+
+namespace
+{
+    /// Exits after a given amount of calls to main()
+    class CountingApp : public edo::IApplication
+    {
+    public:
+        CountingApp(int limit) : calls(0), limit(limit)
+        {
+
+        }
+
+        void main() override
+        {
+            if(++calls == limit)
+                setExit(true);
+        }
+
+        int calls;
+        int limit;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(app_test)
+
+BOOST_AUTO_TEST_CASE(test_run_calls_main_at_rate)
+{
+    CountingApp app(21);
+    app.scheduler().set_rate(1000.0);
+
+    int64_t begin = edo::TickScheduler::now();
+    app.run();
+    double elapsed = (edo::TickScheduler::now() - begin) / 1e6;
+
+    BOOST_REQUIRE_EQUAL(app.calls, 21);
+    BOOST_REQUIRE(app.shouldExit());
+    BOOST_REQUIRE_EQUAL(app.stats().ticks(), 21);
+    BOOST_REQUIRE(app.stats().max() < 1000000);
+    BOOST_REQUIRE(elapsed >= 19.9);
+    BOOST_REQUIRE(elapsed < 50);
+}
+
+BOOST_AUTO_TEST_CASE(test_run_events)
+{
+    int fds[2];
+    BOOST_REQUIRE(pipe(fds) == 0);
+
+    CountingApp app(3);
+    int received = 0;
+    app.events().watch(fds[0], [&](uint32_t)
+    {
+        char c;
+        BOOST_REQUIRE(read(fds[0], &c, 1) == 1);
+        received++;
+    });
+
+    std::thread writer([&]()
+    {
+        for(int i = 0; i < 3; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            BOOST_REQUIRE(write(fds[1], "x", 1) == 1);
+        }
+    });
+
+    app.runEvents();
+    writer.join();
+
+    BOOST_REQUIRE_EQUAL(received, 3);
+    BOOST_REQUIRE_EQUAL(app.calls, 3);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_set_exit_interrupts_events)
+{
+    CountingApp app(-1);
+
+    std::thread stopper([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        app.setExit(true);
+    });
+
+    app.runEvents();
+    stopper.join();
+
+    BOOST_REQUIRE(app.shouldExit());
+}
+
+BOOST_AUTO_TEST_CASE(test_frame_resets_every_tick)
+{
+    class FrameApp : public edo::IApplication
+    {
+    public:
+        FrameApp() : calls(0), fresh(0), overflows(0)
+        {
+
+        }
+
+        void main() override
+        {
+            if(frame().used() == 0)
+                fresh++;
+
+            if(calls == 1)
+                overflows = frame().overflows();
+
+            // More than the first chunk holds, so the first tick chains
+            edo::FrameVector<uint8_t> garbage{edo::FrameAllocator<uint8_t>(
+                frame())};
+            garbage.resize(100000);
+            edo::Bytebuf buf(frame());
+            buf.put(garbage.data(), garbage.size());
+
+            if(++calls == 5)
+                setExit(true);
+        }
+
+        int calls;
+        int fresh;
+        uint64_t overflows;
+    };
+
+    FrameApp app;
+    app.scheduler().set_rate(1000.0);
+    app.run();
+
+    BOOST_REQUIRE_EQUAL(app.fresh, 5);
+    BOOST_REQUIRE(app.frame().high_water() >= 200000);
+
+    // Only the first tick chained, the later ones fit the merged chunk
+    BOOST_REQUIRE(app.overflows > 0);
+    BOOST_REQUIRE_EQUAL(app.frame().overflows(), app.overflows);
+}
+
+BOOST_AUTO_TEST_CASE(test_join_tasks)
+{
+    // Every tick spawns a task which must have finished by the next one
+    class SpawningApp : public edo::IApplication
+    {
+    public:
+        SpawningApp() : ticks(0), finished(0), joined(true)
+        {
+
+        }
+
+        void main() override
+        {
+            if(finished.load() != ticks)
+                joined = false;
+
+            if(++ticks == 20)
+                setExit(true);
+
+            pool().spawn([this]()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                finished++;
+            });
+        }
+
+        int ticks;
+        std::atomic<int> finished;
+        bool joined;
+    };
+
+    SpawningApp app;
+    app.scheduler().set_rate(1e6);
+    app.setJoinTasks(true);
+    app.run();
+
+    BOOST_REQUIRE(app.joinTasks());
+    BOOST_REQUIRE(app.joined);
+
+    // Every tick covers the joined task
+    BOOST_REQUIRE(app.stats().durations().percentile(0.5) >= 200000);
+    BOOST_REQUIRE_EQUAL(app.finished.load(), 20);
+}
+
+BOOST_AUTO_TEST_CASE(test_exit_from_task)
+{
+    CountingApp app(-1);
+    app.scheduler().set_rate(1000.0);
+    app.pool().spawn([&app]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        app.setExit(true);
+    });
+
+    // Returns once the task has set the flag and the pool is joined
+    app.run();
+    BOOST_REQUIRE(app.shouldExit());
+    BOOST_REQUIRE(app.calls > 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_coroutine_delay_wakes_events)
+{
+    // A coroutine which exits the application after a delay
+    class Exit : public edo::Coroutine
+    {
+    public:
+        Exit(edo::IApplication& app) : app(app)
+        {
+
+        }
+
+        edo::Await operator()() override
+        {
+            BOOST_ASIO_CORO_REENTER(this)
+            {
+                BOOST_ASIO_CORO_YIELD return edo::Await::delay(3000000);
+                app.setExit(true);
+            }
+            return edo::Await::done();
+        }
+
+        edo::IApplication& app;
+    };
+
+    CountingApp app(-1);
+    app.coroutines().spawn<Exit>(app);
+
+    // The loop does not sleep until the coroutine has started, then
+    // sleeps until its delay has passed
+    int64_t begin = edo::TickScheduler::now();
+    app.runEvents();
+
+    BOOST_REQUIRE(edo::TickScheduler::now() - begin >= 3000000);
+    BOOST_REQUIRE(app.calls < 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
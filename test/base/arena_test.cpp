@@ -0,0 +1,166 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/arena.hpp"
+#include "edo/base/bytebuf.hpp"
+
+struct ArenaFixture
+{
+    ArenaFixture() : arena(1024)
+    {
+
+    }
+
+    /// Returns whether a pointer has a given alignment
+    bool aligned(const void* pointer, std::size_t alignment)
+    {
+        return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+    }
+
+    edo::FrameArena arena;
+};
+
+BOOST_FIXTURE_TEST_SUITE(arena_test, ArenaFixture)
+
+BOOST_AUTO_TEST_CASE(test_allocations_are_bumped)
+{
+    uint8_t* a = static_cast<uint8_t*>(arena.allocate(10, 1));
+    uint8_t* b = static_cast<uint8_t*>(arena.allocate(6, 1));
+
+    BOOST_REQUIRE(b == a + 10);
+    BOOST_REQUIRE_EQUAL(arena.used(), 16);
+    BOOST_REQUIRE_EQUAL(arena.capacity(), 1024);
+    BOOST_REQUIRE_EQUAL(arena.overflows(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_alignment)
+{
+    arena.allocate(1, 1);
+    void* p = arena.allocate(8, 64);
+    BOOST_REQUIRE(aligned(p, 64));
+
+    p = arena.allocate(3, 1);
+    p = arena.allocate(16);
+    BOOST_REQUIRE(aligned(p, alignof(std::max_align_t)));
+
+    BOOST_REQUIRE_THROW(arena.allocate(8, 3), std::invalid_argument);
+    BOOST_REQUIRE_THROW(arena.allocate(8, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_rewinds)
+{
+    void* first = arena.allocate(100, 1);
+    arena.allocate(200, 1);
+    arena.reset();
+
+    BOOST_REQUIRE_EQUAL(arena.used(), 0);
+    BOOST_REQUIRE_EQUAL(arena.high_water(), 300);
+    BOOST_REQUIRE(arena.allocate(100, 1) == first);
+}
+
+BOOST_AUTO_TEST_CASE(test_overflow_chains_and_merges)
+{
+    arena.allocate(1000, 1);
+    void* spilled = arena.allocate(100, 1);
+    void* large = arena.allocate(10000, 8);
+
+    BOOST_REQUIRE(spilled != nullptr);
+    BOOST_REQUIRE(aligned(large, 8));
+    BOOST_REQUIRE_EQUAL(arena.overflows(), 2);
+    BOOST_REQUIRE_EQUAL(arena.used(), 11100);
+    BOOST_REQUIRE(arena.capacity() >= 11100);
+
+    // The same frame again fits into the merged chunk
+    std::size_t capacity = arena.capacity();
+    arena.reset();
+    BOOST_REQUIRE_EQUAL(arena.capacity(), capacity);
+
+    arena.allocate(1000, 1);
+    arena.allocate(100, 1);
+    arena.allocate(10000, 8);
+    BOOST_REQUIRE_EQUAL(arena.overflows(), 2);
+    BOOST_REQUIRE(arena.high_water() >= 11100);
+}
+
+BOOST_AUTO_TEST_CASE(test_containers)
+{
+    edo::FrameVector<int> numbers{edo::FrameAllocator<int>(arena)};
+    for(int i = 0; i < 100; i++)
+        numbers.push_back(i);
+
+    BOOST_REQUIRE_EQUAL(numbers[99], 99);
+    BOOST_REQUIRE(numbers.get_allocator().arena() == &arena);
+    BOOST_REQUIRE(arena.used() >= 100 * sizeof(int));
+
+    edo::FrameString text("a string too long for the small buffer",
+        edo::FrameAllocator<char>(arena));
+    BOOST_REQUIRE_EQUAL(text.size(), 38);
+
+    // Without an arena they use the heap
+    std::size_t used = arena.used();
+    edo::FrameVector<int> heap(50, 7);
+    BOOST_REQUIRE(heap.get_allocator().arena() == nullptr);
+    BOOST_REQUIRE_EQUAL(arena.used(), used);
+}
+
+BOOST_AUTO_TEST_CASE(test_bytebuf)
+{
+    edo::Bytebuf buf(arena);
+    buf.put(static_cast<uint32_t>(0xDEADBEEF));
+    buf.put(std::string("frame"));
+
+    BOOST_REQUIRE(arena.used() > 0);
+    BOOST_REQUIRE_EQUAL(buf.get<uint32_t>(0), 0xDEADBEEF);
+    BOOST_REQUIRE_EQUAL(buf.get_string(4), "frame");
+
+    // Copies use the heap and outlive the frame
+    std::size_t used = arena.used();
+    edo::Bytebuf copy = buf;
+    edo::Bytebuf assigned;
+    assigned.put(static_cast<uint8_t>(1));
+    assigned = buf;
+    edo::Bytebuf frame_moved(arena);
+    frame_moved.put(std::string("frame"));
+    used = arena.used();
+    edo::Bytebuf moved;
+    moved = std::move(frame_moved);
+    BOOST_REQUIRE_EQUAL(arena.used(), used);
+
+    // Overwrites whatever the next frame gets
+    arena.reset();
+    std::size_t capacity = arena.capacity();
+    std::memset(arena.allocate(capacity, 1), 0xCD, capacity);
+    BOOST_REQUIRE_EQUAL(copy.get_string(4), "frame");
+    BOOST_REQUIRE_EQUAL(assigned.get_string(4), "frame");
+    BOOST_REQUIRE_EQUAL(moved.get_string(0), "frame");
+}
+
+BOOST_AUTO_TEST_CASE(test_copies_use_the_heap)
+{
+    edo::FrameVector<int> frame{edo::FrameAllocator<int>(arena)};
+    frame.assign(10, 3);
+
+    edo::FrameVector<int> copy(frame);
+    BOOST_REQUIRE(copy.get_allocator().arena() == nullptr);
+
+    edo::FrameVector<int> assigned;
+    assigned = frame;
+    BOOST_REQUIRE(assigned.get_allocator().arena() == nullptr);
+    BOOST_REQUIRE(assigned == frame);
+
+    // Move assignment keeps the heap, move construction the arena
+    edo::FrameVector<int> moved;
+    moved = std::move(frame);
+    BOOST_REQUIRE(moved.get_allocator().arena() == nullptr);
+    BOOST_REQUIRE(moved == assigned);
+
+    edo::FrameVector<int> other{edo::FrameAllocator<int>(arena)};
+    edo::FrameVector<int> constructed(std::move(other));
+    BOOST_REQUIRE(constructed.get_allocator().arena() == &arena);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/binlog.hpp"
+
+struct BinlogFixture
+{
+    ~BinlogFixture()
+    {
+        std::remove("binlog_test.log");
+    }
+
+    /// Returns every message of the log
+    std::vector<edo::LogEntry> read()
+    {
+        edo::BinaryLogReader reader("binlog_test.log");
+        std::vector<edo::LogEntry> entries;
+
+        edo::LogEntry entry;
+        while(reader.next(entry))
+            entries.push_back(entry);
+
+        return entries;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(binlog_test, BinlogFixture)
+
+BOOST_AUTO_TEST_CASE(test_format_ids)
+{
+    uint32_t id = edo::BinaryLogger::format("binlog_test {}");
+    BOOST_REQUIRE_EQUAL(edo::BinaryLogger::format("binlog_test {}"), id);
+    BOOST_REQUIRE(edo::BinaryLogger::format("binlog_test {} {}") != id);
+}
+
+BOOST_AUTO_TEST_CASE(test_arguments)
+{
+    {
+        edo::BinaryLogger logger("binlog_test.log");
+        EDO_LOG(logger, "plain");
+        EDO_LOG(logger, "{} {} {} {}", true, 'x', -42, 42u);
+        EDO_LOG(logger, "{} {}", static_cast<int8_t>(-1),
+            static_cast<uint64_t>(18446744073709551615ULL));
+        EDO_LOG(logger, "{}|{}", 1.5, 0.25f);
+        EDO_LOG(logger, "packet {} from {}", std::string("login"), "server");
+        EDO_LOG(logger, "at {}", reinterpret_cast<void*>(0x1000));
+        EDO_LOG(logger, "{} and {}", 1);
+        EDO_LOG(logger, "extra", 1, "two");
+    }
+
+    std::vector<edo::LogEntry> entries = read();
+    BOOST_REQUIRE_EQUAL(entries.size(), 8);
+    BOOST_REQUIRE_EQUAL(entries[0].message, "plain");
+    BOOST_REQUIRE_EQUAL(entries[1].message, "true x -42 42");
+    BOOST_REQUIRE_EQUAL(entries[2].message, "-1 18446744073709551615");
+    BOOST_REQUIRE_EQUAL(entries[3].message, "1.5|0.25");
+    BOOST_REQUIRE_EQUAL(entries[4].message, "packet login from server");
+    BOOST_REQUIRE_EQUAL(entries[5].message, "at 0x1000");
+    BOOST_REQUIRE_EQUAL(entries[6].message, "1 and {}");
+    BOOST_REQUIRE_EQUAL(entries[7].message, "extra 1 two");
+
+    BOOST_REQUIRE_EQUAL(entries[0].thread, 1);
+    BOOST_REQUIRE(entries[0].format != entries[1].format);
+}
+
+BOOST_AUTO_TEST_CASE(test_times_are_wall_clock)
+{
+    int64_t before = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    {
+        edo::BinaryLogger logger("binlog_test.log");
+        EDO_LOG(logger, "now");
+    }
+    int64_t after = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::vector<edo::LogEntry> entries = read();
+    BOOST_REQUIRE_EQUAL(entries.size(), 1);
+
+    // Allows for the clocks drifting apart a little
+    BOOST_REQUIRE(entries[0].time >= before - 1000000);
+    BOOST_REQUIRE(entries[0].time <= after + 1000000);
+}
+
+BOOST_AUTO_TEST_CASE(test_threads_keep_their_order)
+{
+    {
+        edo::BinaryLogger logger("binlog_test.log", 4096, 1000000);
+
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; t++)
+        {
+            threads.emplace_back([&logger, t]()
+            {
+                for(int i = 0; i < 2000; i++)
+                {
+                    EDO_LOG(logger, "thread {} message {}", t, i);
+
+                    // Leaves the drain time to keep up with the small ring
+                    if(i % 64 == 0)
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(2));
+                }
+            });
+        }
+
+        for(std::thread& thread : threads)
+            thread.join();
+
+        BOOST_REQUIRE_EQUAL(logger.errors(), 0);
+    }
+
+    // Messages of a thread come in order, a dropped one leaves a gap
+    std::vector<edo::LogEntry> entries = read();
+    std::vector<int> last(5, -1);
+    for(edo::LogEntry& entry : entries)
+    {
+        BOOST_REQUIRE(entry.thread >= 1 && entry.thread <= 4);
+
+        int t, i;
+        BOOST_REQUIRE_EQUAL(std::sscanf(entry.message.c_str(),
+            "thread %d message %d", &t, &i), 2);
+        BOOST_REQUIRE(i > last[entry.thread]);
+        last[entry.thread] = i;
+    }
+
+    BOOST_REQUIRE(entries.size() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_full_ring_drops)
+{
+    {
+        // A long interval keeps the drain from emptying the ring
+        edo::BinaryLogger logger("binlog_test.log", 64, 1000000000000LL);
+        for(int i = 0; i < 10; i++)
+            EDO_LOG(logger, "{}", i);
+
+        BOOST_REQUIRE_EQUAL(logger.dropped(), 8);
+
+        logger.flush();
+        EDO_LOG(logger, "{}", 10);
+        BOOST_REQUIRE_EQUAL(logger.dropped(), 8);
+    }
+
+    std::vector<edo::LogEntry> entries = read();
+    BOOST_REQUIRE_EQUAL(entries.size(), 3);
+    BOOST_REQUIRE_EQUAL(entries[2].message, "10");
+}
+
+BOOST_AUTO_TEST_CASE(test_cut_off_log)
+{
+    {
+        edo::BinaryLogger logger("binlog_test.log");
+        EDO_LOG(logger, "first");
+        EDO_LOG(logger, "second {}", std::string("message"));
+    }
+
+    std::vector<uint8_t> data = edo::read_file("binlog_test.log");
+    edo::write_file("binlog_test.log", data.data(), data.size() - 3);
+
+    std::vector<edo::LogEntry> entries = read();
+    BOOST_REQUIRE_EQUAL(entries.size(), 1);
+    BOOST_REQUIRE_EQUAL(entries[0].message, "first");
+}
+
+BOOST_AUTO_TEST_CASE(test_malformatted_logs_throw)
+{
+    std::ofstream("binlog_test.log") << "not a log at all";
+    BOOST_REQUIRE_THROW(edo::BinaryLogReader("binlog_test.log"),
+        edo::EdoError);
+
+    BOOST_REQUIRE_THROW(edo::BinaryLogReader("binlog_test.missing"),
+        edo::NotFoundError);
+    BOOST_REQUIRE_THROW(edo::BinaryLogger("/nonexistent/binlog_test.log"),
+        edo::EdoError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
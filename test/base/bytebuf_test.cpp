@@ -308,4 +308,43 @@ BOOST_AUTO_TEST_CASE(test_get_throws_when_index_less_than_zero)
     BOOST_REQUIRE_THROW(b.get<int32_t>(-1), std::out_of_range);
 }
 
+BOOST_AUTO_TEST_CASE(test_put_get_string)
+{
+    std::string str = "edo";
+    b.put(str);
+
+    BOOST_REQUIRE_EQUAL(b.size(), sizeof(uint32_t) + 3);
+    BOOST_REQUIRE_EQUAL(b.get_pos(), sizeof(uint32_t) + 3);
+    BOOST_REQUIRE_EQUAL(b.get<uint32_t>(0), 3);
+    BOOST_REQUIRE_EQUAL(b.get_string(0), str);
+}
+
+BOOST_AUTO_TEST_CASE(test_put_string_at_index)
+{
+    b.put(static_cast<uint32_t>(10));
+    b.put(0, std::string("ab"));
+
+    BOOST_REQUIRE_EQUAL(b.get_string(0), "ab");
+    BOOST_REQUIRE_EQUAL(b.get<uint32_t>(6), 10);
+}
+
+BOOST_AUTO_TEST_CASE(test_get_string_advances_position)
+{
+    b.put(std::string("first"));
+    b.put(std::string(""));
+    b.rewind();
+
+    BOOST_REQUIRE_EQUAL(b.get_string(), "first");
+    BOOST_REQUIRE_EQUAL(b.get_string(), "");
+    BOOST_REQUIRE_EQUAL(b.get_pos(), b.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_get_string_throws_when_exceeding_size)
+{
+    b.put(static_cast<uint32_t>(10));
+    b.put(static_cast<uint8_t>(1));
+
+    BOOST_REQUIRE_THROW(b.get_string(0), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+#include <cstdio>
+#include <limits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/config_snapshot.hpp"
+
+struct ConfigSnapshotFixture
+{
+    ConfigSnapshotFixture()
+    {
+        path = "config_snapshot_test.bin";
+        conf.parse("height=200\nwidth=800\nname=edo\nscale=1.5\n"
+            "offset=-42\nbig=9223372036854775807\npadded=007\n");
+    }
+
+    ~ConfigSnapshotFixture()
+    {
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+    edo::ConfigMap conf;
+};
+
+BOOST_FIXTURE_TEST_SUITE(config_snapshot_test, ConfigSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(test_snapshot_holds_all_keys)
+{
+    edo::Bytebuf buf = conf.serialize_snapshot();
+    edo::ConfigSnapshot snapshot(buf.data(), buf.size());
+
+    BOOST_REQUIRE_EQUAL(snapshot.size(), conf.size());
+    for(auto it = conf.begin(); it != conf.end(); it++)
+    {
+        BOOST_REQUIRE(snapshot.has_key(it->first));
+        BOOST_REQUIRE_EQUAL(snapshot.get(it->first), it->second);
+    }
+
+    BOOST_REQUIRE(!snapshot.has_key("depth"));
+    BOOST_REQUIRE(!snapshot.has_key("heigh"));
+    BOOST_REQUIRE_THROW(snapshot.get("depth"), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_pairs_are_sorted)
+{
+    edo::Bytebuf buf = conf.serialize_snapshot();
+    edo::ConfigSnapshot snapshot(buf.data(), buf.size());
+
+    std::size_t i = 0;
+    for(auto it = conf.begin(); it != conf.end(); it++, i++)
+    {
+        BOOST_REQUIRE_EQUAL(snapshot.key(i).to_string(), it->first);
+        BOOST_REQUIRE_EQUAL(snapshot.value(i).to_string(), it->second);
+    }
+
+    BOOST_REQUIRE_THROW(snapshot.key(i), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_casts_like_config_map)
+{
+    edo::Bytebuf buf = conf.serialize_snapshot();
+    edo::ConfigSnapshot snapshot(buf.data(), buf.size());
+
+    BOOST_REQUIRE_EQUAL(snapshot.get<int>("height"), 200);
+    BOOST_REQUIRE_EQUAL(snapshot.get<int16_t>("offset"), -42);
+    BOOST_REQUIRE_EQUAL(snapshot.get<int64_t>("big"),
+        std::numeric_limits<int64_t>::max());
+    BOOST_REQUIRE_EQUAL(snapshot.get<double>("width"), 800.0);
+    BOOST_REQUIRE_EQUAL(snapshot.get<double>("scale"), 1.5);
+    BOOST_REQUIRE_EQUAL(snapshot.get<int>("padded"), 7);
+    BOOST_REQUIRE_EQUAL(snapshot.get<std::string>("name"), "edo");
+
+    // Out of range integers fail or wrap exactly as the text would
+    BOOST_REQUIRE_THROW(snapshot.get<int32_t>("big"), std::runtime_error);
+    BOOST_REQUIRE_THROW(snapshot.get<int>("scale"), std::runtime_error);
+    BOOST_REQUIRE_THROW(snapshot.get<int>("name"), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(snapshot.get<uint32_t>("offset"),
+        conf.get<uint32_t>("offset"));
+    BOOST_REQUIRE_EQUAL(snapshot.get<float>("big"), conf.get<float>("big"));
+    BOOST_REQUIRE_THROW(snapshot.get<int>("depth"), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_maps_files)
+{
+    edo::Bytebuf buf = conf.serialize_snapshot();
+    edo::write_file(path, buf.data(), buf.size());
+
+    edo::ConfigSnapshot snapshot(path);
+    BOOST_REQUIRE_EQUAL(snapshot.size(), conf.size());
+    BOOST_REQUIRE_EQUAL(snapshot.get<int>("width"), 800);
+
+    BOOST_REQUIRE_THROW(edo::ConfigSnapshot("config_snapshot_test.none"),
+        edo::NotFoundError);
+}
+
+BOOST_AUTO_TEST_CASE(test_snapshot_parses_into_config_map)
+{
+    edo::Bytebuf buf = conf.serialize_snapshot();
+    edo::ConfigSnapshot snapshot(buf.data(), buf.size());
+
+    edo::ConfigMap loaded;
+    loaded.put("width", "1024");
+    edo::ConfigHandle<int> height = loaded.handle<int>("height");
+    loaded.parse(snapshot);
+
+    BOOST_REQUIRE_EQUAL(loaded.size(), conf.size());
+    BOOST_REQUIRE_EQUAL(loaded.get("width"), "1024");
+    BOOST_REQUIRE_EQUAL(loaded.get("name"), "edo");
+    BOOST_REQUIRE_EQUAL(height.get(), 200);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty_snapshot)
+{
+    edo::ConfigMap empty;
+    edo::Bytebuf buf = empty.serialize_snapshot();
+    edo::ConfigSnapshot snapshot(buf.data(), buf.size());
+
+    BOOST_REQUIRE_EQUAL(snapshot.size(), 0);
+    BOOST_REQUIRE(!snapshot.has_key("height"));
+}
+
+BOOST_AUTO_TEST_CASE(test_malformatted_snapshot_throws)
+{
+    edo::Bytebuf buf = conf.serialize_snapshot();
+    std::vector<uint8_t> data(buf.data(), buf.data() + buf.size());
+
+    std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+    BOOST_REQUIRE_THROW(edo::ConfigSnapshot(truncated.data(),
+        truncated.size()), std::runtime_error);
+
+    std::vector<uint8_t> magic = data;
+    magic[0] ^= 0xFF;
+    BOOST_REQUIRE_THROW(edo::ConfigSnapshot(magic.data(), magic.size()),
+        std::runtime_error);
+
+    BOOST_REQUIRE_THROW(edo::ConfigSnapshot(data.data(), 8),
+        std::runtime_error);
+
+    // An entry pointing past the string table fails once it is read
+    std::vector<uint8_t> entry = data;
+    entry[24 + 3] = 0x7F;
+    edo::ConfigSnapshot snapshot(entry.data(), entry.size());
+    BOOST_REQUIRE_THROW(snapshot.key(0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/base/config_source.hpp"
+
+struct ConfigSourceFixture
+{
+    ConfigSourceFixture()
+    {
+        path = "config_source_test.conf";
+        write("fps=60\nwidth=800\n");
+    }
+
+    ~ConfigSourceFixture()
+    {
+        std::remove(path.c_str());
+        std::remove((path + ".new").c_str());
+    }
+
+    /// Replaces the file by renaming, so the watcher never reads a
+    /// partially written one
+    void write(const std::string& contents)
+    {
+        std::string temporary = path + ".new";
+        edo::write_file(temporary,
+            reinterpret_cast<const uint8_t*>(contents.data()), contents.size());
+        std::rename(temporary.c_str(), path.c_str());
+    }
+
+    /// Waits for the watcher to publish a given version
+    bool await_version(edo::ConfigSource& source, uint64_t version)
+    {
+        for(int i = 0; i < 500 && source.version() < version; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        return source.version() >= version;
+    }
+
+    std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(config_source_test, ConfigSourceFixture)
+
+BOOST_AUTO_TEST_CASE(test_initial_load)
+{
+    edo::ConfigSource source(path);
+    edo::ConfigSource::Snapshot snapshot = source.snapshot();
+
+    BOOST_REQUIRE_EQUAL(snapshot.version(), 1);
+    BOOST_REQUIRE_EQUAL(snapshot->get("fps"), "60");
+    BOOST_REQUIRE_EQUAL((*snapshot).get<int>("width"), 800);
+
+    BOOST_REQUIRE_THROW(edo::ConfigSource("config_source_test.none"),
+        edo::NotFoundError);
+}
+
+BOOST_AUTO_TEST_CASE(test_reload_on_write)
+{
+    edo::ConfigSource source(path);
+
+    std::string contents = "fps=144\nwidth=800\n";
+    edo::write_file(path,
+        reinterpret_cast<const uint8_t*>(contents.data()), contents.size());
+    BOOST_REQUIRE(await_version(source, 2));
+    BOOST_REQUIRE_EQUAL(source.snapshot()->get("fps"), "144");
+}
+
+BOOST_AUTO_TEST_CASE(test_reload_on_rename)
+{
+    edo::ConfigSource source(path);
+
+    write("fps=30\n");
+
+    BOOST_REQUIRE(await_version(source, 2));
+    BOOST_REQUIRE_EQUAL(source.snapshot()->get("fps"), "30");
+    BOOST_REQUIRE(!source.snapshot()->has_key("width"));
+}
+
+BOOST_AUTO_TEST_CASE(test_malformatted_keeps_version)
+{
+    edo::ConfigSource source(path);
+
+    write("fps==60\n");
+    BOOST_REQUIRE(!source.reload());
+    BOOST_REQUIRE(source.errors() >= 1);
+    BOOST_REQUIRE_EQUAL(source.version(), 1);
+    BOOST_REQUIRE_EQUAL(source.snapshot()->get("fps"), "60");
+}
+
+BOOST_AUTO_TEST_CASE(test_pinned_snapshot_survives_reloads)
+{
+    edo::ConfigSource source(path);
+    edo::ConfigSource::Snapshot pinned = source.snapshot();
+
+    write("fps=1\n");
+    BOOST_REQUIRE(source.reload());
+    write("fps=2\n");
+    BOOST_REQUIRE(source.reload());
+
+    BOOST_REQUIRE_EQUAL(pinned.version(), 1);
+    BOOST_REQUIRE_EQUAL(pinned->get("fps"), "60");
+    BOOST_REQUIRE_EQUAL(source.snapshot()->get("fps"), "2");
+}
+
+BOOST_AUTO_TEST_CASE(test_subscriptions)
+{
+    edo::ConfigSource source(path);
+
+    std::vector<std::string> changes;
+    auto record = [&changes](const std::string* value, const std::string* old)
+    {
+        changes.push_back((old ? *old : "-") + ">" + (value ? *value : "-"));
+    };
+
+    std::size_t fps = source.subscribe("fps", record);
+    source.subscribe("height", record);
+
+    // Unchanged keys are not reported
+    write("fps=60\nwidth=1024\n");
+    source.reload();
+    BOOST_REQUIRE(changes.empty());
+
+    write("fps=120\nheight=600\n");
+    source.reload();
+    BOOST_REQUIRE_EQUAL(changes.size(), 2);
+    BOOST_REQUIRE_EQUAL(changes[0], "60>120");
+    BOOST_REQUIRE_EQUAL(changes[1], "->600");
+
+    source.unsubscribe(fps);
+    BOOST_REQUIRE_THROW(source.unsubscribe(fps), std::out_of_range);
+
+    write("fps=30\n");
+    source.reload();
+    BOOST_REQUIRE_EQUAL(changes.size(), 3);
+    BOOST_REQUIRE_EQUAL(changes[2], "600>-");
+}
+
+BOOST_AUTO_TEST_CASE(test_throwing_subscription)
+{
+    edo::ConfigSource source(path);
+
+    std::atomic<int> calls(0);
+    source.subscribe("fps", [](const std::string*, const std::string*)
+    {
+        throw std::runtime_error("failed");
+    });
+    source.subscribe("fps", [&calls](const std::string*, const std::string*)
+    {
+        calls++;
+    });
+
+    // The watcher thread survives the exception, and the callbacks after
+    // the throwing one still run
+    write("fps=30\n");
+    for(int i = 0; i < 500 && calls.load() == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    BOOST_REQUIRE(calls.load() >= 1);
+    BOOST_REQUIRE(source.errors() >= 1);
+
+    write("fps=15\n");
+    BOOST_REQUIRE(source.reload());
+    BOOST_REQUIRE_EQUAL(source.snapshot()->get("fps"), "15");
+}
+
+BOOST_AUTO_TEST_CASE(test_readers_see_whole_versions)
+{
+    edo::ConfigSource source(path);
+    write("a=0\nb=0\nc=0\n");
+    source.reload();
+
+    // Every version has the same value for all keys, a reader seeing
+    // different ones would have seen a partial update
+    std::atomic<bool> done(false);
+    std::atomic<bool> consistent(true);
+    std::vector<std::thread> readers;
+    for(int i = 0; i < 3; i++)
+    {
+        readers.emplace_back([&]()
+        {
+            while(!done)
+            {
+                edo::ConfigSource::Snapshot snapshot = source.snapshot();
+                std::string a = snapshot->get("a");
+                if(snapshot->get("b") != a || snapshot->get("c") != a)
+                    consistent = false;
+            }
+        });
+    }
+
+    for(int i = 1; i <= 200; i++)
+    {
+        std::string n = std::to_string(i);
+        write("a=" + n + "\nb=" + n + "\nc=" + n + "\n");
+        source.reload();
+    }
+
+    done = true;
+    for(std::thread& reader : readers)
+        reader.join();
+
+    BOOST_REQUIRE(consistent);
+    BOOST_REQUIRE_EQUAL(source.snapshot()->get("a"), "200");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
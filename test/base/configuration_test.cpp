@@ -42,6 +42,49 @@ BOOST_AUTO_TEST_CASE(test_parse_skips_empty_lines)
     BOOST_REQUIRE_EQUAL(conf.get("fps"), "60");
 }
 
+BOOST_AUTO_TEST_CASE(test_parse_last_line_without_newline)
+{
+    conf.parse("fps=60\ncc=3");
+
+    BOOST_REQUIRE_EQUAL(conf.size(), 2);
+    BOOST_REQUIRE_EQUAL(conf.get("cc"), "3");
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_keeps_existing_keys)
+{
+    conf.put("fps", "30");
+    conf.parse("fps=60\nfps=90\ncc=3\n");
+
+    BOOST_REQUIRE_EQUAL(conf.size(), 2);
+    BOOST_REQUIRE_EQUAL(conf.get("fps"), "30");
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_rejects_extra_separators)
+{
+    BOOST_REQUIRE_THROW(conf.parse("height=200="), std::runtime_error);
+    BOOST_REQUIRE_THROW(conf.parse("a=b=c"), std::runtime_error);
+    BOOST_REQUIRE_THROW(conf.parse("="), std::runtime_error);
+    BOOST_REQUIRE_THROW(conf.parse("fps=60\nheight\n"), std::runtime_error);
+
+    // Lines before the malformatted one are kept
+    BOOST_REQUIRE_EQUAL(conf.get("fps"), "60");
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_buffer)
+{
+    const char buffer[] = "fps=60\ncc=3\nwidth=800";
+
+    // Only the given length is parsed
+    conf.parse(buffer, 12);
+
+    BOOST_REQUIRE_EQUAL(conf.size(), 2);
+    BOOST_REQUIRE_EQUAL(conf.get("cc"), "3");
+    BOOST_REQUIRE_EQUAL(conf.has_key("width"), false);
+
+    conf.parse(buffer, 0);
+    BOOST_REQUIRE_EQUAL(conf.size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(test_serialize_uses_proper_format)
 {
     conf.put("fps", "60");
@@ -147,4 +190,109 @@ BOOST_AUTO_TEST_CASE(test_erase_throws_out_of_range_on_nonexisting_element)
     BOOST_REQUIRE_THROW(conf.erase("fps"), std::out_of_range);
 }
 
+BOOST_AUTO_TEST_CASE(test_handle_reads_converted_value)
+{
+    conf.put("fps", "60");
+    edo::ConfigHandle<int32_t> fps = conf.handle<int32_t>("fps");
+
+    BOOST_REQUIRE(fps.valid());
+    BOOST_REQUIRE_EQUAL(fps.get(), 60);
+    BOOST_REQUIRE_EQUAL(*fps, 60);
+}
+
+BOOST_AUTO_TEST_CASE(test_handle_refreshes_on_put_and_erase)
+{
+    edo::ConfigHandle<float> scale = conf.handle<float>("scale");
+    BOOST_REQUIRE(!scale.valid());
+    BOOST_REQUIRE_THROW(scale.get(), std::out_of_range);
+
+    conf.put("scale", "1.5");
+    BOOST_REQUIRE(scale.valid());
+    BOOST_REQUIRE_CLOSE(scale.get(), 1.5, 0.0001);
+
+    conf.put<float>("scale", 2.0f);
+    BOOST_REQUIRE_CLOSE(scale.get(), 2.0, 0.0001);
+
+    conf.erase("scale");
+    BOOST_REQUIRE(!scale.valid());
+    BOOST_REQUIRE_THROW(scale.get(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_handle_refreshes_on_parse_and_clear)
+{
+    edo::ConfigHandle<int32_t> width = conf.handle<int32_t>("width");
+    edo::ConfigHandle<std::string> title = conf.handle<std::string>("title");
+
+    conf.parse("height=200\nwidth=800\ntitle=edo\n");
+    BOOST_REQUIRE_EQUAL(width.get(), 800);
+    BOOST_REQUIRE_EQUAL(title.get(), "edo");
+
+    // Parsing keeps existing keys, and so do their handles
+    conf.parse("width=1024\n");
+    BOOST_REQUIRE_EQUAL(width.get(), 800);
+
+    conf.clear();
+    BOOST_REQUIRE(!width.valid());
+    BOOST_REQUIRE(!title.valid());
+}
+
+BOOST_AUTO_TEST_CASE(test_handle_bad_cast)
+{
+    conf.put("fps", "60");
+    edo::ConfigHandle<int32_t> fps = conf.handle<int32_t>("fps");
+
+    conf.put("fps", "fast");
+    BOOST_REQUIRE(!fps.valid());
+    BOOST_REQUIRE_THROW(fps.get(), std::runtime_error);
+
+    // The last good value is kept
+    BOOST_REQUIRE_EQUAL(*fps, 60);
+
+    conf.put("fps", "30");
+    BOOST_REQUIRE_EQUAL(fps.get(), 30);
+}
+
+BOOST_AUTO_TEST_CASE(test_handle_copies_and_assignment)
+{
+    conf.put("fps", "60");
+    edo::ConfigHandle<int32_t> fps = conf.handle<int32_t>("fps");
+    edo::ConfigHandle<int32_t> copy = fps;
+
+    // A copied map does not update the handles of the original
+    edo::ConfigMap other(conf);
+    other.put("fps", "30");
+    BOOST_REQUIRE_EQUAL(fps.get(), 60);
+
+    // Assigning to the original does
+    conf = other;
+    BOOST_REQUIRE_EQUAL(fps.get(), 30);
+    BOOST_REQUIRE_EQUAL(copy.get(), 30);
+
+    conf = edo::ConfigMap();
+    BOOST_REQUIRE(!fps.valid());
+}
+
+BOOST_AUTO_TEST_CASE(test_handle_outlives_and_expires)
+{
+    {
+        edo::ConfigHandle<int32_t> temporary = conf.handle<int32_t>("fps");
+    }
+
+    // Expired handles are dropped on the next refresh
+    conf.put("fps", "60");
+    conf.erase("fps");
+
+    edo::ConfigHandle<int32_t> fps;
+    BOOST_REQUIRE(!fps.valid());
+    BOOST_REQUIRE_THROW(fps.get(), std::out_of_range);
+
+    {
+        edo::ConfigMap local;
+        local.put("fps", "60");
+        fps = local.handle<int32_t>("fps");
+    }
+
+    BOOST_REQUIRE_EQUAL(fps.get(), 60);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,348 @@
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unistd.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/app.hpp"
+#include "edo/base/queue.hpp"
+#include "edo/base/coroutine.hpp"
+
+#include <boost/asio/yield.hpp>
+
+namespace
+{
+    /// Counts the ticks it has been resumed on
+    class Counter : public edo::Coroutine
+    {
+    public:
+        Counter(int& count, int limit) : count(count), limit(limit), i(0)
+        {
+
+        }
+
+        edo::Await operator()() override
+        {
+            reenter(this)
+            {
+                for(i = 0; i < limit; i++)
+                {
+                    count++;
+                    yield return edo::Await::tick();
+                }
+            }
+            return edo::Await::done();
+        }
+
+        int& count;
+        int limit;
+        int i;
+    };
+
+    /// Waits for a value, then writes a response to a pipe
+    class Patcher : public edo::Coroutine
+    {
+    public:
+        Patcher(const int& value, int fd, std::string& log)
+            : value(value), fd(fd), log(log)
+        {
+
+        }
+
+        edo::Await operator()() override
+        {
+            reenter(this)
+            {
+                log += "scan ";
+                yield return edo::Await::until([this]() { return value == 42; });
+                log += "changed ";
+                yield return edo::Await::readable(fd);
+
+                char c;
+                if(read(fd, &c, 1) == 1)
+                    log += c;
+
+                yield return edo::Await::delay(2000000);
+                log += " patched";
+            }
+            return edo::Await::done();
+        }
+
+        const int& value;
+        int fd;
+        std::string& log;
+    };
+
+    class Consumer : public edo::Coroutine
+    {
+    public:
+        Consumer(edo::BoundedQueue<int>& queue, std::vector<int>& out)
+            : queue(queue), out(out)
+        {
+
+        }
+
+        edo::Await operator()() override
+        {
+            int v;
+            reenter(this)
+            {
+                while(true)
+                {
+                    yield return edo::Await::data(queue);
+                    while(queue.pop(v))
+                        out.push_back(v);
+                }
+            }
+            return edo::Await::done();
+        }
+
+        edo::BoundedQueue<int>& queue;
+        std::vector<int>& out;
+    };
+
+    class Thrower : public edo::Coroutine
+    {
+    public:
+        edo::Await operator()() override
+        {
+            reenter(this)
+            {
+                yield return edo::Await::tick();
+                throw std::runtime_error("failed");
+            }
+            return edo::Await::done();
+        }
+    };
+
+    /// Counts the times a descriptor became readable, without reading it
+    class Waiter : public edo::Coroutine
+    {
+    public:
+        Waiter(int fd, int& count) : fd(fd), count(count)
+        {
+
+        }
+
+        edo::Await operator()() override
+        {
+            reenter(this)
+            {
+                yield return edo::Await::readable(fd);
+                count++;
+            }
+            return edo::Await::done();
+        }
+
+        int fd;
+        int& count;
+    };
+
+    /// Large enough to need a frame from the heap
+    class Large : public edo::Coroutine
+    {
+    public:
+        edo::Await operator()() override
+        {
+            buffer[0] = 1;
+            return edo::Await::done();
+        }
+
+        char buffer[8192];
+    };
+}
+
+#include <boost/asio/unyield.hpp>
+
+struct CoroutineFixture
+{
+    CoroutineFixture()
+    {
+        BOOST_REQUIRE(pipe(fds) == 0);
+    }
+
+    ~CoroutineFixture()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    edo::CoroutineRunner runner;
+    int fds[2];
+};
+
+BOOST_FIXTURE_TEST_SUITE(coroutine_test, CoroutineFixture)
+
+BOOST_AUTO_TEST_CASE(test_ticks)
+{
+    int count = 0;
+    std::size_t id = runner.spawn<Counter>(count, 3);
+
+    // Spawned coroutines start on the next step
+    BOOST_REQUIRE(runner.active(id));
+    BOOST_REQUIRE_EQUAL(count, 0);
+
+    for(int i = 1; i <= 3; i++)
+    {
+        BOOST_REQUIRE_EQUAL(runner.step(), 1);
+        BOOST_REQUIRE_EQUAL(count, i);
+    }
+
+    BOOST_REQUIRE(runner.active(id));
+    runner.step();
+    BOOST_REQUIRE(!runner.active(id));
+    BOOST_REQUIRE_EQUAL(runner.size(), 0);
+    BOOST_REQUIRE_EQUAL(runner.step(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_workflow)
+{
+    int value = 0;
+    std::string log;
+    std::size_t id = runner.spawn<Patcher>(value, fds[0], log);
+
+    runner.step();
+    runner.step();
+    BOOST_REQUIRE_EQUAL(log, "scan ");
+
+    value = 42;
+    runner.step();
+    BOOST_REQUIRE_EQUAL(log, "scan changed ");
+
+    runner.step();
+    BOOST_REQUIRE_EQUAL(log, "scan changed ");
+
+    // The delay counts from the step the coroutine yields it in
+    BOOST_REQUIRE(write(fds[1], "x", 1) == 1);
+    int64_t begin = edo::TickScheduler::now();
+    runner.step();
+    BOOST_REQUIRE_EQUAL(log, "scan changed x");
+
+    // The runner descriptor wakes up a sleeper once the delay passes
+    edo::EventLoop loop;
+    loop.watch(runner.fd(), [](uint32_t) {});
+    while(runner.active(id))
+    {
+        loop.poll(1000);
+        runner.step();
+    }
+
+    BOOST_REQUIRE(edo::TickScheduler::now() - begin >= 2000000);
+    BOOST_REQUIRE_EQUAL(log, "scan changed x patched");
+}
+
+BOOST_AUTO_TEST_CASE(test_queue_data)
+{
+    edo::BoundedQueue<int> queue(16);
+    std::vector<int> out;
+    std::size_t id = runner.spawn<Consumer>(queue, out);
+
+    runner.step();
+    BOOST_REQUIRE_EQUAL(runner.step(), 0);
+
+    queue.push(1);
+    queue.push(2);
+    BOOST_REQUIRE_EQUAL(runner.step(), 1);
+    BOOST_REQUIRE_EQUAL(out.size(), 2);
+
+    runner.cancel(id);
+    BOOST_REQUIRE(!runner.active(id));
+    BOOST_REQUIRE_THROW(runner.cancel(id), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_cancel_fd_wait)
+{
+    int value = 42;
+    std::string log;
+    std::size_t id = runner.spawn<Patcher>(value, fds[0], log);
+
+    runner.step();
+    runner.step();
+    runner.cancel(id);
+
+    // The descriptor can be waited for again
+    runner.spawn<Patcher>(value, fds[0], log);
+    runner.step();
+    runner.step();
+    BOOST_REQUIRE(write(fds[1], "y", 1) == 1);
+    runner.step();
+    BOOST_REQUIRE(log.find('y') != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_exception)
+{
+    std::size_t id = runner.spawn<Thrower>();
+    runner.step();
+    BOOST_REQUIRE_THROW(runner.step(), std::runtime_error);
+    BOOST_REQUIRE(!runner.active(id));
+}
+
+BOOST_AUTO_TEST_CASE(test_exception_finishes_step)
+{
+    int count = 0;
+    runner.spawn<Thrower>();
+    runner.spawn<Counter>(count, 1);
+    runner.spawn<Counter>(count, 5);
+    runner.step();
+    BOOST_REQUIRE_EQUAL(count, 2);
+
+    // The coroutines after the thrower still run and finish
+    BOOST_REQUIRE_THROW(runner.step(), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(count, 3);
+    BOOST_REQUIRE_EQUAL(runner.size(), 1);
+    BOOST_REQUIRE(runner.pending());
+
+    BOOST_REQUIRE_EQUAL(runner.step(), 1);
+    BOOST_REQUIRE_EQUAL(count, 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_fd)
+{
+    int count = 0;
+    runner.spawn<Waiter>(fds[0], count);
+    runner.spawn<Waiter>(fds[0], count);
+    runner.step();
+    BOOST_REQUIRE_EQUAL(runner.step(), 0);
+
+    BOOST_REQUIRE(write(fds[1], "x", 1) == 1);
+    BOOST_REQUIRE_EQUAL(runner.step(), 2);
+    BOOST_REQUIRE_EQUAL(count, 2);
+    BOOST_REQUIRE_EQUAL(runner.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_reuse_ids)
+{
+    int count = 0;
+    std::size_t first = runner.spawn<Counter>(count, 1);
+    runner.step();
+    runner.step();
+    BOOST_REQUIRE(!runner.active(first));
+
+    // The slot is reused, the old id does not name the new coroutine
+    std::size_t second = runner.spawn<Counter>(count, 1);
+    BOOST_REQUIRE(second != first);
+    BOOST_REQUIRE(runner.active(second));
+    BOOST_REQUIRE(!runner.active(first));
+    BOOST_REQUIRE_THROW(runner.cancel(first), std::out_of_range);
+    BOOST_REQUIRE(runner.active(second));
+
+    runner.cancel(second);
+    BOOST_REQUIRE_EQUAL(runner.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_many)
+{
+    int count = 0;
+    for(int i = 0; i < 10000; i++)
+        runner.spawn<Counter>(count, 2);
+
+    runner.spawn<Large>();
+    BOOST_REQUIRE_EQUAL(runner.size(), 10001);
+
+    while(runner.size() > 0)
+        runner.step();
+
+    BOOST_REQUIRE_EQUAL(count, 20000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,243 @@
+#include <thread>
+#include <stdexcept>
+#include <unistd.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/events.hpp"
+#include "edo/base/scheduler.hpp"
+
+struct EventsFixture
+{
+    EventsFixture()
+    {
+        BOOST_REQUIRE(pipe(fds) == 0);
+    }
+
+    ~EventsFixture()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    void send(char c)
+    {
+        BOOST_REQUIRE(write(fds[1], &c, 1) == 1);
+    }
+
+    edo::EventLoop loop;
+    int fds[2];
+};
+
+BOOST_FIXTURE_TEST_SUITE(events_test, EventsFixture)
+
+BOOST_AUTO_TEST_CASE(test_watch)
+{
+    std::string received;
+    std::size_t id = loop.watch(fds[0], [&](uint32_t events)
+    {
+        BOOST_REQUIRE(events & EPOLLIN);
+
+        char c;
+        BOOST_REQUIRE(read(fds[0], &c, 1) == 1);
+        received += c;
+    });
+
+    BOOST_REQUIRE(loop.active(id));
+    BOOST_REQUIRE_EQUAL(loop.size(), 1);
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 0);
+
+    send('a');
+    BOOST_REQUIRE_EQUAL(loop.poll(1000), 1);
+    send('b');
+    BOOST_REQUIRE_EQUAL(loop.poll(1000), 1);
+    BOOST_REQUIRE_EQUAL(received, "ab");
+
+    loop.remove(id);
+    send('c');
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 0);
+    BOOST_REQUIRE(!loop.active(id));
+    BOOST_REQUIRE_EQUAL(loop.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_modify)
+{
+    uint32_t seen = 0;
+    std::size_t id = loop.watch(fds[1], [&](uint32_t events)
+    {
+        seen = events;
+    }, 0);
+
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 0);
+
+    loop.modify(id, EPOLLOUT);
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 1);
+    BOOST_REQUIRE(seen & EPOLLOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_timer)
+{
+    uint64_t expirations = 0;
+    std::size_t id = loop.timer(2000000, [&](uint64_t n)
+    {
+        expirations += n;
+    });
+
+    int64_t begin = edo::TickScheduler::now();
+    while(expirations < 5)
+        loop.poll();
+
+    double elapsed = (edo::TickScheduler::now() - begin) / 1e6;
+    BOOST_REQUIRE(elapsed >= 9.5);
+    BOOST_REQUIRE(loop.active(id));
+}
+
+BOOST_AUTO_TEST_CASE(test_one_shot_timer)
+{
+    int calls = 0;
+    std::size_t id = loop.timer(1000000, [&](uint64_t)
+    {
+        calls++;
+    }, false);
+
+    BOOST_REQUIRE_EQUAL(loop.poll(1000), 1);
+    BOOST_REQUIRE_EQUAL(calls, 1);
+    BOOST_REQUIRE(!loop.active(id));
+    BOOST_REQUIRE_EQUAL(loop.poll(10), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_wakeup_from_thread)
+{
+    int calls = 0;
+    std::size_t id = loop.wakeup([&]()
+    {
+        calls++;
+    });
+
+    // Notifications before the dispatch coalesce into one call
+    loop.notify(id);
+    loop.notify(id);
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 1);
+    BOOST_REQUIRE_EQUAL(calls, 1);
+
+    std::thread notifier([&]()
+    {
+        loop.notify(id);
+    });
+
+    BOOST_REQUIRE_EQUAL(loop.poll(1000), 1);
+    notifier.join();
+    BOOST_REQUIRE_EQUAL(calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_stop_from_thread)
+{
+    std::thread stopper([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        loop.stop();
+    });
+
+    loop.run();
+    stopper.join();
+
+    // An interrupt returns without dispatching anything
+    loop.interrupt();
+    BOOST_REQUIRE_EQUAL(loop.poll(1000), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_remove_within_batch)
+{
+    int calls = 0;
+    std::size_t first = 0;
+    std::size_t second = 0;
+
+    first = loop.wakeup([&]()
+    {
+        calls++;
+        loop.remove(second);
+    });
+    second = loop.wakeup([&]()
+    {
+        calls++;
+        loop.remove(first);
+    });
+
+    loop.notify(first);
+    loop.notify(second);
+
+    // Whichever runs first removes the other
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 1);
+    BOOST_REQUIRE_EQUAL(calls, 1);
+    BOOST_REQUIRE_EQUAL(loop.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_reuse_slots)
+{
+    int calls = 0;
+    std::size_t first = loop.timer(1000, [&](uint64_t)
+    {
+        calls++;
+    }, false);
+    BOOST_REQUIRE_EQUAL(loop.poll(1000), 1);
+
+    // The slot of the fired timer is reused, its id stays invalid
+    std::size_t second = loop.wakeup([&]()
+    {
+        calls++;
+    });
+    BOOST_REQUIRE(second != first);
+    BOOST_REQUIRE(!loop.active(first));
+    BOOST_REQUIRE_THROW(loop.notify(first), std::out_of_range);
+    BOOST_REQUIRE_THROW(loop.remove(first), std::out_of_range);
+    BOOST_REQUIRE(loop.active(second));
+    BOOST_REQUIRE_EQUAL(loop.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_reuse_slot_within_batch)
+{
+    int stale = 0;
+    std::size_t first = 0;
+    std::size_t second = 0;
+
+    first = loop.wakeup([&]()
+    {
+        loop.remove(second);
+
+        // Takes the slot of the removed source, nothing is written to the pipe
+        loop.watch(fds[0], [&](uint32_t)
+        {
+            stale++;
+        });
+    });
+    second = loop.wakeup([&]()
+    {
+        loop.remove(first);
+        loop.watch(fds[0], [&](uint32_t)
+        {
+            stale++;
+        });
+    });
+
+    loop.notify(first);
+    loop.notify(second);
+
+    // The event of the removed source does not reach the new one
+    BOOST_REQUIRE_EQUAL(loop.poll(0), 1);
+    BOOST_REQUIRE_EQUAL(stale, 0);
+    BOOST_REQUIRE_EQUAL(loop.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_sources)
+{
+    std::size_t id = loop.wakeup([]() {});
+
+    BOOST_REQUIRE_THROW(loop.notify(id + 1), std::out_of_range);
+    BOOST_REQUIRE_THROW(loop.modify(id, EPOLLIN), std::out_of_range);
+    BOOST_REQUIRE_THROW(loop.timer(0, [](uint64_t) {}), std::invalid_argument);
+
+    loop.remove(id);
+    BOOST_REQUIRE_THROW(loop.remove(id), std::out_of_range);
+    BOOST_REQUIRE_THROW(loop.notify(id), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
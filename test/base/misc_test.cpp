@@ -1,4 +1,7 @@
+#include <cstdio>
 #include <boost/test/unit_test.hpp>
+
+#include "edo/base/error.hpp"
 #include "edo/base/misc.hpp"
 
 struct FollowFixture
@@ -78,4 +81,29 @@ BOOST_FIXTURE_TEST_CASE(test_follow_with_non_zero_offset, FollowFixture)
     BOOST_REQUIRE_EQUAL(reinterpret_cast<int32_t*>(res), &val);
 }
 
+BOOST_AUTO_TEST_CASE(test_write_and_read_file)
+{
+    uint8_t data[] = {1, 2, 0, 4};
+    edo::write_file("misc_test.bin", data, sizeof(data));
+    auto res = edo::read_file("misc_test.bin");
+    std::remove("misc_test.bin");
+
+    BOOST_REQUIRE_EQUAL(res.size(), 4);
+    BOOST_REQUIRE_EQUAL(res[2], 0);
+    BOOST_REQUIRE_EQUAL(res[3], 4);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_file_throws_not_found_error)
+{
+    BOOST_REQUIRE_THROW(edo::read_file("nonexistant.bin"), edo::NotFoundError);
+}
+
+BOOST_AUTO_TEST_CASE(test_fnv1a_known_values)
+{
+    const uint8_t* a = reinterpret_cast<const uint8_t*>("a");
+
+    BOOST_REQUIRE_EQUAL(edo::fnv1a(a, 0), 0xcbf29ce484222325ULL);
+    BOOST_REQUIRE_EQUAL(edo::fnv1a(a, 1), 0xaf63dc4c8601ec8cULL);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
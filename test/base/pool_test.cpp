@@ -0,0 +1,199 @@
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/pool.hpp"
+
+struct PoolFixture
+{
+    PoolFixture() : pool(4)
+    {
+
+    }
+
+    /// Sums [begin, end) by splitting it into tasks down to a given grain
+    void sum(
+        const std::vector<int>& values,
+        std::size_t begin,
+        std::size_t end,
+        std::atomic<long>& total
+    )
+    {
+        if(end - begin <= 64)
+        {
+            long partial = 0;
+            for(std::size_t i = begin; i < end; i++)
+                partial += values[i];
+
+            total += partial;
+            return;
+        }
+
+        std::size_t middle = begin + (end - begin) / 2;
+        pool.spawn([this, &values, begin, middle, &total]()
+        {
+            sum(values, begin, middle, total);
+        });
+        sum(values, middle, end, total);
+    }
+
+    edo::ThreadPool pool;
+};
+
+BOOST_FIXTURE_TEST_SUITE(pool_test, PoolFixture)
+
+BOOST_AUTO_TEST_CASE(test_spawn)
+{
+    BOOST_REQUIRE_EQUAL(pool.size(), 4);
+
+    std::atomic<int> count(0);
+    std::vector<edo::Task> tasks;
+    for(int i = 0; i < 1000; i++)
+    {
+        tasks.push_back(pool.spawn([&count]()
+        {
+            count++;
+        }));
+    }
+
+    pool.wait();
+    BOOST_REQUIRE_EQUAL(count.load(), 1000);
+    BOOST_REQUIRE_EQUAL(pool.pending(), 0);
+
+    for(edo::Task& task : tasks)
+        BOOST_REQUIRE(task.done());
+}
+
+BOOST_AUTO_TEST_CASE(test_nested_spawn)
+{
+    std::vector<int> values(100000);
+    long expected = 0;
+    for(std::size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = static_cast<int>(i % 97);
+        expected += values[i];
+    }
+
+    std::atomic<long> total(0);
+    pool.spawn([&]()
+    {
+        sum(values, 0, values.size(), total);
+    });
+
+    pool.wait();
+    BOOST_REQUIRE_EQUAL(total.load(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(test_continuations)
+{
+    std::atomic<int> a(0);
+    std::atomic<int> b(0);
+    int result = 0;
+
+    edo::Task first = pool.spawn([&a]()
+    {
+        a = 2;
+    });
+    edo::Task second = pool.spawn([&b]()
+    {
+        b = 3;
+    });
+    edo::Task joined = pool.spawn([&]()
+    {
+        result = a * b;
+    }, {first, second});
+    edo::Task last = pool.then(joined, [&result]()
+    {
+        result += 1;
+    });
+
+    last.wait();
+    BOOST_REQUIRE(first.done());
+    BOOST_REQUIRE(joined.done());
+    BOOST_REQUIRE_EQUAL(result, 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_finished_dependency)
+{
+    edo::Task first = pool.spawn([]() {});
+    first.wait();
+
+    bool ran = false;
+    pool.then(first, [&ran]()
+    {
+        ran = true;
+    }).wait();
+
+    BOOST_REQUIRE(ran);
+
+    // An empty handle counts as finished
+    pool.then(edo::Task(), []() {}).wait();
+}
+
+BOOST_AUTO_TEST_CASE(test_exception)
+{
+    edo::Task failed = pool.spawn([]()
+    {
+        throw std::runtime_error("failed");
+    });
+
+    bool ran = false;
+    edo::Task after = pool.then(failed, [&ran]()
+    {
+        ran = true;
+    });
+
+    BOOST_REQUIRE_THROW(failed.wait(), std::runtime_error);
+    after.wait();
+    BOOST_REQUIRE(ran);
+}
+
+BOOST_AUTO_TEST_CASE(test_wait_within_task_throws)
+{
+    bool threw = false;
+    edo::Task outer = pool.spawn([this, &threw]()
+    {
+        edo::Task inner = pool.spawn([]() {});
+
+        try
+        {
+            pool.wait();
+        }
+        catch(const std::logic_error&)
+        {
+            threw = true;
+        }
+
+        inner.wait();
+    });
+
+    // Also when the task runs on a thread waiting on one of its tasks
+    outer.wait();
+    BOOST_REQUIRE(threw);
+
+    pool.wait();
+    BOOST_REQUIRE_EQUAL(pool.pending(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_destructor_waits)
+{
+    std::atomic<int> count(0);
+    {
+        edo::ThreadPool local(2);
+        for(int i = 0; i < 100; i++)
+        {
+            local.spawn([&local, &count]()
+            {
+                local.spawn([&count]()
+                {
+                    count++;
+                });
+            });
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL(count.load(), 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
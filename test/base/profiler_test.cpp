@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/scheduler.hpp"
+#include "edo/base/profiler.hpp"
+
+struct ProfilerFixture
+{
+    ~ProfilerFixture()
+    {
+        std::remove("profiler_test.json");
+    }
+
+    edo::Profiler profiler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(profiler_test, ProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(test_metric_ids)
+{
+    std::size_t ticks = profiler.metric("ticks",
+        edo::Profiler::Kind::counter);
+    std::size_t sizes = profiler.metric("sizes",
+        edo::Profiler::Kind::histogram);
+
+    BOOST_REQUIRE(ticks != sizes);
+    BOOST_REQUIRE_EQUAL(profiler.metric("ticks",
+        edo::Profiler::Kind::counter), ticks);
+    BOOST_REQUIRE_THROW(profiler.metric("ticks",
+        edo::Profiler::Kind::timer), std::invalid_argument);
+
+    BOOST_REQUIRE_THROW(profiler.count(sizes + 1), std::out_of_range);
+    BOOST_REQUIRE_THROW(profiler.add(edo::Profiler::MAX_METRICS),
+        std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_too_many_metrics_throws)
+{
+    for(std::size_t i = 0; i < edo::Profiler::MAX_METRICS; i++)
+        profiler.metric(std::to_string(i), edo::Profiler::Kind::counter);
+
+    BOOST_REQUIRE_THROW(profiler.metric("one more",
+        edo::Profiler::Kind::counter), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_counters_sum_threads)
+{
+    std::size_t id = profiler.metric("packets", edo::Profiler::Kind::counter);
+    BOOST_REQUIRE_EQUAL(profiler.count(id), 0);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]()
+        {
+            for(int i = 0; i < 10000; i++)
+                profiler.add(id);
+        });
+    }
+
+    for(std::thread& thread : threads)
+        thread.join();
+
+    profiler.add(id, 5);
+    BOOST_REQUIRE_EQUAL(profiler.count(id), 40005);
+
+    profiler.reset();
+    BOOST_REQUIRE_EQUAL(profiler.count(id), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_histograms_merge_threads)
+{
+    std::size_t id = profiler.metric("sizes", edo::Profiler::Kind::histogram);
+
+    std::thread other([&]()
+    {
+        profiler.record(id, 1000);
+    });
+    other.join();
+
+    profiler.record(id, 10);
+    profiler.record(id, 20);
+
+    edo::Histogram merged;
+    profiler.merge(id, merged);
+    BOOST_REQUIRE_EQUAL(merged.count(), 3);
+    BOOST_REQUIRE_EQUAL(merged.sum(), 1030);
+    BOOST_REQUIRE_EQUAL(merged.max(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_scoped_timer)
+{
+    std::size_t id = profiler.metric("work", edo::Profiler::Kind::timer);
+    {
+        edo::ScopedTimer timer(profiler, id);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    edo::Histogram merged;
+    profiler.merge(id, merged);
+    BOOST_REQUIRE_EQUAL(merged.count(), 1);
+    BOOST_REQUIRE(merged.max() >= 2000000);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_events)
+{
+    std::size_t id = profiler.metric("frame \"main\"",
+        edo::Profiler::Kind::timer);
+
+    // Runs before tracing is enabled leave no events
+    profiler.time(id, 0, 1000);
+    BOOST_REQUIRE(profiler.trace().find("\"ph\"") == std::string::npos);
+
+    profiler.set_tracing(true);
+    BOOST_REQUIRE(profiler.tracing());
+
+    int64_t now = edo::TickScheduler::now();
+    profiler.time(id, now, now + 1500);
+
+    std::string trace = profiler.trace();
+    BOOST_REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    BOOST_REQUIRE(trace.find("\"name\": \"frame \\\"main\\\"\"")
+        != std::string::npos);
+    BOOST_REQUIRE(trace.find("\"ph\": \"X\"") != std::string::npos);
+    BOOST_REQUIRE(trace.find("\"dur\": 1.500") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_drops_when_full)
+{
+    std::size_t id = profiler.metric("short", edo::Profiler::Kind::timer);
+    profiler.set_tracing(true);
+
+    for(std::size_t i = 0; i < edo::Profiler::MAX_EVENTS + 3; i++)
+        profiler.time(id, 0, 1);
+
+    BOOST_REQUIRE_EQUAL(profiler.dropped(), 3);
+
+    edo::Histogram merged;
+    profiler.merge(id, merged);
+    BOOST_REQUIRE_EQUAL(merged.count(), edo::Profiler::MAX_EVENTS + 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_json_export)
+{
+    std::size_t packets = profiler.metric("packets",
+        edo::Profiler::Kind::counter);
+    std::size_t tick = profiler.metric("tick", edo::Profiler::Kind::timer);
+    profiler.metric("unused", edo::Profiler::Kind::histogram);
+
+    profiler.add(packets, 7);
+    profiler.time(tick, 0, 100);
+
+    profiler.save_json("profiler_test.json");
+    std::vector<uint8_t> data = edo::read_file("profiler_test.json");
+    std::string json(data.begin(), data.end());
+
+    BOOST_REQUIRE_EQUAL(json, profiler.json());
+    BOOST_REQUIRE(json.find("\"packets\": 7") != std::string::npos);
+    BOOST_REQUIRE(json.find("\"tick\": {\"count\": 1, \"sum\": 100")
+        != std::string::npos);
+    BOOST_REQUIRE(json.find("\"unused\": {\"count\": 0") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_macros)
+{
+    // Compiles either way, records into instance() only when enabled
+    EDO_PROFILE_SCOPE("profiler_test.scope");
+    EDO_PROFILE_COUNT("profiler_test.count", 2);
+    EDO_PROFILE_RECORD("profiler_test.record", 42);
+
+#ifdef EDO_PROFILING
+    edo::Profiler& global = edo::Profiler::instance();
+    BOOST_REQUIRE(global.count(global.metric("profiler_test.count",
+        edo::Profiler::Kind::counter)) >= 2);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/queue.hpp"
+
+struct QueueFixture
+{
+    QueueFixture() : queue(4, 16)
+    {
+
+    }
+
+    /// Pushes a single integer as message
+    bool push(uint32_t value)
+    {
+        return queue.push(reinterpret_cast<const uint8_t*>(&value),
+            sizeof(value));
+    }
+
+    /// Drains the queue and returns the received integers
+    std::vector<uint32_t> drain()
+    {
+        std::vector<uint32_t> res;
+        queue.drain([&](edo::Bytebuf& buf)
+        {
+            res.push_back(buf.get<uint32_t>());
+        });
+
+        return res;
+    }
+
+    edo::BufferQueue queue;
+};
+
+BOOST_FIXTURE_TEST_SUITE(queue_test, QueueFixture)
+
+BOOST_AUTO_TEST_CASE(test_bounded_queue)
+{
+    edo::BoundedQueue<int> q(3);
+    int value;
+
+    BOOST_REQUIRE_EQUAL(q.capacity(), 4);
+    BOOST_REQUIRE(!q.pop(value));
+
+    for(int i = 0; i < 4; i++)
+        BOOST_REQUIRE(q.push(i));
+
+    BOOST_REQUIRE(!q.push(4));
+    BOOST_REQUIRE_EQUAL(q.size(), 4);
+
+    for(int i = 0; i < 4; i++)
+    {
+        BOOST_REQUIRE(q.pop(value));
+        BOOST_REQUIRE_EQUAL(value, i);
+    }
+
+    BOOST_REQUIRE(!q.pop(value));
+}
+
+BOOST_AUTO_TEST_CASE(test_push_and_drain_in_order)
+{
+    BOOST_REQUIRE(push(1));
+    BOOST_REQUIRE(push(2));
+    BOOST_REQUIRE(push(3));
+    BOOST_REQUIRE_EQUAL(queue.size(), 3);
+
+    std::vector<uint32_t> res = drain();
+
+    BOOST_REQUIRE_EQUAL(res.size(), 3);
+    BOOST_REQUIRE_EQUAL(res[0], 1);
+    BOOST_REQUIRE_EQUAL(res[2], 3);
+    BOOST_REQUIRE_EQUAL(queue.size(), 0);
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_drops_when_full_or_too_large)
+{
+    for(uint32_t i = 0; i < 4; i++)
+        BOOST_REQUIRE(push(i));
+
+    BOOST_REQUIRE(!push(4));
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 1);
+
+    std::vector<uint8_t> large(17);
+    BOOST_REQUIRE(!queue.push(large.data(), large.size()));
+    BOOST_REQUIRE_EQUAL(queue.dropped(), 2);
+
+    // Drained buffers are pooled again
+    BOOST_REQUIRE_EQUAL(drain().size(), 4);
+    BOOST_REQUIRE(push(5));
+}
+
+BOOST_AUTO_TEST_CASE(test_drain_in_batches)
+{
+    for(uint32_t i = 0; i < 4; i++)
+        push(i);
+
+    std::size_t count = queue.drain([](edo::Bytebuf&) {}, 3);
+
+    BOOST_REQUIRE_EQUAL(count, 3);
+    BOOST_REQUIRE_EQUAL(drain()[0], 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_acquire_and_publish)
+{
+    edo::Bytebuf* buf = queue.acquire();
+    BOOST_REQUIRE(buf != nullptr);
+    BOOST_REQUIRE_EQUAL(buf->size(), 0);
+    BOOST_REQUIRE(buf->capacity() >= 16);
+
+    buf->put(static_cast<uint32_t>(42));
+    queue.publish(buf);
+
+    edo::Bytebuf* unused = queue.acquire();
+    queue.release(unused);
+
+    std::vector<uint32_t> res = drain();
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_REQUIRE_EQUAL(res[0], 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_many_producers)
+{
+    const uint32_t producers = 4;
+    const uint32_t messages = 20000;
+    edo::BufferQueue shared(256, 8);
+    std::atomic<uint32_t> running(producers);
+
+    std::vector<std::thread> threads;
+    for(uint32_t p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+        {
+            for(uint32_t i = 0; i < messages; i++)
+            {
+                uint32_t message[] = {p, i};
+                shared.push(reinterpret_cast<const uint8_t*>(message),
+                    sizeof(message));
+            }
+
+            running--;
+        });
+    }
+
+    // Every producer's messages arrive in order, minus the dropped ones
+    std::vector<int64_t> last(producers, -1);
+    uint64_t received = 0;
+    bool ordered = true;
+    auto handler = [&](edo::Bytebuf& buf)
+    {
+        uint32_t p = buf.get<uint32_t>();
+        uint32_t i = buf.get<uint32_t>();
+        ordered = ordered && p < producers && i > last[p];
+        last[p] = i;
+        received++;
+    };
+
+    while(running > 0)
+        shared.drain(handler);
+    shared.drain(handler);
+
+    for(std::thread& thread : threads)
+        thread.join();
+
+    BOOST_REQUIRE(ordered);
+    BOOST_REQUIRE_EQUAL(received + shared.dropped(), producers * messages);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/scheduler.hpp"
+
+struct SchedulerFixture
+{
+    SchedulerFixture() : scheduler(1000.0)
+    {
+
+    }
+
+    /// Runs a given amount of ticks and returns the elapsed milliseconds
+    double run(uint64_t ticks)
+    {
+        int64_t begin = edo::TickScheduler::now();
+        for(uint64_t i = 0; i < ticks; i++)
+            scheduler.wait();
+
+        return (edo::TickScheduler::now() - begin) / 1e6;
+    }
+
+    void stall(int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+
+    edo::TickScheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(scheduler_test, SchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(test_rate_validation)
+{
+    BOOST_REQUIRE_EQUAL(scheduler.rate(), 1000.0);
+    BOOST_REQUIRE_THROW(scheduler.set_rate(0), std::invalid_argument);
+    BOOST_REQUIRE_THROW(edo::TickScheduler(-1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_keeps_rate)
+{
+    scheduler.start();
+
+    // The first tick is due immediately, 50 more follow at 1 kHz
+    double elapsed = run(51);
+
+    BOOST_REQUIRE(elapsed >= 49.9);
+    BOOST_REQUIRE(elapsed < 80);
+    BOOST_REQUIRE_EQUAL(scheduler.ticks(), 51);
+}
+
+BOOST_AUTO_TEST_CASE(test_does_not_drift_with_work)
+{
+    scheduler.start();
+
+    // Work shorter than the period does not delay the schedule, the
+    // deadlines stay on the grid of the start however late a tick ran
+    int64_t first = scheduler.deadline();
+    for(int i = 0; i < 21; i++)
+    {
+        scheduler.wait();
+        int64_t busy = edo::TickScheduler::now() + 500000;
+        while(edo::TickScheduler::now() < busy)
+        {
+
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL(scheduler.deadline() - first, 21000000);
+}
+
+BOOST_AUTO_TEST_CASE(test_catch_up_after_overrun)
+{
+    scheduler.start();
+    scheduler.wait();
+    stall(10);
+
+    // The missed ticks run back to back
+    double elapsed = run(5);
+
+    BOOST_REQUIRE(elapsed < 2);
+    BOOST_REQUIRE_EQUAL(scheduler.overruns(), 5);
+    BOOST_REQUIRE_EQUAL(scheduler.skipped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_skip_after_overrun)
+{
+    scheduler.set_overrun_policy(edo::OverrunPolicy::skip);
+    scheduler.start();
+    scheduler.wait();
+    stall(10);
+
+    uint64_t skipped = scheduler.wait();
+
+    BOOST_REQUIRE(skipped >= 8);
+    BOOST_REQUIRE_EQUAL(scheduler.skipped(), skipped);
+    BOOST_REQUIRE_EQUAL(scheduler.overruns(), 1);
+
+    // Back on schedule, the next tick waits
+    int64_t deadline = scheduler.deadline();
+    scheduler.wait();
+    BOOST_REQUIRE(edo::TickScheduler::now() >= deadline);
+    BOOST_REQUIRE_EQUAL(scheduler.overruns(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_spin_window)
+{
+    scheduler.set_spin_window(200000);
+    scheduler.start();
+    scheduler.wait();
+
+    int64_t deadline = scheduler.deadline();
+    scheduler.wait();
+    int64_t late = edo::TickScheduler::now() - deadline;
+
+    BOOST_REQUIRE(late >= 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_set_rate_restarts_schedule)
+{
+    scheduler.start();
+    run(3);
+    scheduler.set_rate(500.0);
+    int64_t restart = scheduler.deadline();
+
+    // A late restart catches up, so measure from its deadline
+    double elapsed = run(11);
+
+    BOOST_REQUIRE(edo::TickScheduler::now() - restart >= 20000000);
+    BOOST_REQUIRE(elapsed < 40);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
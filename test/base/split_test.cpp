@@ -0,0 +1,110 @@
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/split.hpp"
+
+struct SplitFixture
+{
+    /// Collects the tokens of a lazy split
+    std::vector<std::string> tokens(const edo::Splitter& splitter)
+    {
+        std::vector<std::string> result;
+        for(boost::string_view token : splitter)
+            result.push_back(token.to_string());
+
+        return result;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(split_test, SplitFixture)
+
+BOOST_AUTO_TEST_CASE(test_split_view_at_char)
+{
+    std::vector<std::string> res = tokens(edo::split_view("a=bc=d", '='));
+
+    BOOST_REQUIRE_EQUAL(res.size(), 3);
+    BOOST_REQUIRE_EQUAL(res[0], "a");
+    BOOST_REQUIRE_EQUAL(res[1], "bc");
+    BOOST_REQUIRE_EQUAL(res[2], "d");
+}
+
+BOOST_AUTO_TEST_CASE(test_split_view_matches_split)
+{
+    const char* inputs[] = {"", "=", "==", "===", "a", "a=", "=a", "a==b",
+        "key=value", "a=b=", "\n\nx\n"};
+    const char delims[] = {'=', '\n'};
+
+    for(const char* input : inputs)
+    {
+        for(char delim : delims)
+        {
+            std::vector<std::string> lazy = tokens(
+                edo::split_view(input, delim));
+            std::vector<std::string> eager = edo::split(input, delim);
+
+            BOOST_REQUIRE_EQUAL_COLLECTIONS(lazy.begin(), lazy.end(),
+                eager.begin(), eager.end());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_split_keeps_getline_tokens)
+{
+    // Tokens as std::getline produced them before
+    BOOST_REQUIRE_EQUAL(edo::split("", '=').size(), 1);
+    BOOST_REQUIRE_EQUAL(edo::split("a=", '=').size(), 1);
+    BOOST_REQUIRE_EQUAL(edo::split("=a", '=').size(), 2);
+    BOOST_REQUIRE_EQUAL(edo::split("a==", '=').size(), 2);
+    BOOST_REQUIRE_EQUAL(edo::split("===", '=').size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_split_view_at_string)
+{
+    std::vector<std::string> res = tokens(
+        edo::split_view("a, b,, c, ", ", "));
+
+    BOOST_REQUIRE_EQUAL(res.size(), 3);
+    BOOST_REQUIRE_EQUAL(res[0], "a");
+    BOOST_REQUIRE_EQUAL(res[1], "b,");
+    BOOST_REQUIRE_EQUAL(res[2], "c");
+
+    // Partial matches at the end are part of the token
+    res = tokens(edo::split_view("a::b:", "::"));
+    BOOST_REQUIRE_EQUAL(res.size(), 2);
+    BOOST_REQUIRE_EQUAL(res[1], "b:");
+
+    res = tokens(edo::split_view("a->b", "=>"));
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_REQUIRE_EQUAL(res[0], "a->b");
+}
+
+BOOST_AUTO_TEST_CASE(test_split_view_single_char_string)
+{
+    std::vector<std::string> chars = tokens(edo::split_view("x;y;", ';'));
+    std::vector<std::string> strings = tokens(edo::split_view("x;y;", ";"));
+
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(chars.begin(), chars.end(),
+        strings.begin(), strings.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_split_view_points_into_string)
+{
+    std::string str = "left|right";
+    edo::Splitter splitter = edo::split_view(str, '|');
+
+    edo::Splitter::iterator it = splitter.begin();
+    BOOST_REQUIRE(it->data() == str.data());
+    it++;
+    BOOST_REQUIRE(it->data() == str.data() + 5);
+    BOOST_REQUIRE(++it == splitter.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_split_view_empty_delimiter_throws)
+{
+    BOOST_REQUIRE_THROW(edo::split_view("abc", ""), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+#include <thread>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/stats.hpp"
+
+struct StatsFixture
+{
+    edo::Histogram histogram;
+    edo::TickStats stats;
+};
+
+BOOST_FIXTURE_TEST_SUITE(stats_test, StatsFixture)
+
+BOOST_AUTO_TEST_CASE(test_buckets)
+{
+    // Small values are exact
+    for(uint64_t v = 0; v < 32; v++)
+    {
+        BOOST_REQUIRE_EQUAL(edo::Histogram::bucket_lower(edo::Histogram::bucket(v)), v);
+        BOOST_REQUIRE_EQUAL(edo::Histogram::bucket_upper(edo::Histogram::bucket(v)), v);
+    }
+
+    BOOST_REQUIRE_EQUAL(edo::Histogram::bucket(~0ull), edo::Histogram::BUCKETS - 1);
+    BOOST_REQUIRE_EQUAL(edo::Histogram::bucket_upper(edo::Histogram::BUCKETS - 1), ~0ull);
+
+    // Buckets are contiguous and contain their values
+    for(std::size_t i = 1; i < edo::Histogram::BUCKETS; i++)
+    {
+        BOOST_REQUIRE_EQUAL(edo::Histogram::bucket_lower(i),
+            edo::Histogram::bucket_upper(i - 1) + 1);
+    }
+
+    std::mt19937_64 random(7);
+    for(int i = 0; i < 10000; i++)
+    {
+        uint64_t v = random() >> (random() % 64);
+        std::size_t b = edo::Histogram::bucket(v);
+        BOOST_REQUIRE(edo::Histogram::bucket_lower(b) <= v);
+        BOOST_REQUIRE(edo::Histogram::bucket_upper(b) >= v);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_percentiles)
+{
+    BOOST_REQUIRE_EQUAL(histogram.percentile(0.99), 0);
+
+    std::mt19937_64 random(3);
+    std::vector<uint64_t> values;
+    for(int i = 0; i < 100000; i++)
+    {
+        uint64_t v = 1000 + random() % 1000000;
+        values.push_back(v);
+        histogram.record(v);
+    }
+
+    std::sort(values.begin(), values.end());
+    BOOST_REQUIRE_EQUAL(histogram.count(), values.size());
+    BOOST_REQUIRE_EQUAL(histogram.max(), values.back());
+
+    const double fractions[] = {0.5, 0.9, 0.99, 0.999};
+    for(double fraction : fractions)
+    {
+        uint64_t exact = values[static_cast<std::size_t>(fraction * values.size()) - 1];
+        uint64_t bound = histogram.percentile(fraction);
+
+        BOOST_REQUIRE(bound >= exact);
+        BOOST_REQUIRE(bound <= exact + exact / 16);
+    }
+
+    BOOST_REQUIRE_EQUAL(histogram.percentile(1.0), values.back());
+
+    histogram.reset();
+    BOOST_REQUIRE_EQUAL(histogram.count(), 0);
+    BOOST_REQUIRE_EQUAL(histogram.max(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge)
+{
+    edo::Histogram other;
+    histogram.record(10);
+    other.record(20);
+    other.record(3000);
+
+    histogram.merge(other);
+    BOOST_REQUIRE_EQUAL(histogram.count(), 3);
+    BOOST_REQUIRE_EQUAL(histogram.sum(), 3030);
+    BOOST_REQUIRE_EQUAL(histogram.max(), 3000);
+    BOOST_REQUIRE_EQUAL(histogram.bucket_count(edo::Histogram::bucket(20)), 1);
+    BOOST_REQUIRE_EQUAL(other.count(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_read)
+{
+    std::atomic<bool> done(false);
+    std::thread writer([&]()
+    {
+        for(uint64_t i = 1; i <= 200000; i++)
+            histogram.record(i % 5000);
+
+        done = true;
+    });
+
+    // Reads never block the writer and stay within its bounds
+    while(!done)
+    {
+        BOOST_REQUIRE(histogram.percentile(0.99) < 5000);
+        BOOST_REQUIRE(histogram.max() < 5000);
+    }
+
+    writer.join();
+    BOOST_REQUIRE_EQUAL(histogram.count(), 200000);
+}
+
+BOOST_AUTO_TEST_CASE(test_tick_stats)
+{
+    stats.set_late_threshold(1000);
+    BOOST_REQUIRE_EQUAL(stats.late_threshold(), 1000);
+
+    stats.record(500, 10, false);
+    stats.record(700, 5000, false);
+    stats.record(20000, 90000, true);
+    stats.record(-1, 0, false);
+
+    BOOST_REQUIRE_EQUAL(stats.ticks(), 4);
+    BOOST_REQUIRE_EQUAL(stats.overruns(), 1);
+    BOOST_REQUIRE_EQUAL(stats.late_wakeups(), 1);
+    BOOST_REQUIRE_EQUAL(stats.max_lateness(), 5000);
+    BOOST_REQUIRE_EQUAL(stats.max(), 20000);
+    BOOST_REQUIRE_EQUAL(stats.p99(), 20000);
+    BOOST_REQUIRE_EQUAL(stats.durations().percentile(0.25), 0);
+
+    std::string dump = stats.str();
+    BOOST_REQUIRE(dump.find("ticks 4, overruns 1, late wakeups 1") == 0);
+    BOOST_REQUIRE(dump.find("max 20000") != std::string::npos);
+
+    stats.reset();
+    BOOST_REQUIRE_EQUAL(stats.ticks(), 0);
+    BOOST_REQUIRE_EQUAL(stats.overruns(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
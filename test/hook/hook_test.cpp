@@ -0,0 +1,201 @@
+#include <cstring>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/error.hpp"
+#include "edo/hook/hook.hpp"
+
+namespace
+{
+    typedef int (*Function)(int);
+
+    __attribute__((noinline)) int hook_test_square(int x)
+    {
+        asm volatile("");
+        return x * x;
+    }
+
+    __attribute__((noinline)) int hook_test_negate(int x)
+    {
+        asm volatile("");
+        return -x;
+    }
+
+    Function square_original = nullptr;
+    Function negate_original = nullptr;
+
+    int square_detour(int x)
+    {
+        return square_original(x) + 1;
+    }
+
+    int negate_detour(int x)
+    {
+        return negate_original(x) * 2;
+    }
+
+    int call(Function function, int x)
+    {
+        Function volatile f = function;
+        return f(x);
+    }
+}
+
+struct HookFixture
+{
+    HookFixture()
+    {
+        code = static_cast<uint8_t*>(mmap(nullptr, 4096,
+            PROT_READ | PROT_WRITE | PROT_EXEC,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        std::memset(code, 0xCC, 4096);
+    }
+
+    ~HookFixture()
+    {
+        munmap(code, 4096);
+    }
+
+    /// Copies machine code to the scratch page and returns it
+    Function assemble(std::size_t offset, const std::vector<uint8_t>& bytes)
+    {
+        std::memcpy(code + offset, bytes.data(), bytes.size());
+        return reinterpret_cast<Function>(code + offset);
+    }
+
+    uint8_t* code;
+};
+
+BOOST_FIXTURE_TEST_SUITE(hook_test, HookFixture)
+
+BOOST_AUTO_TEST_CASE(test_hook_and_unhook)
+{
+    edo::HookEngine engine;
+    std::size_t id = engine.hook(reinterpret_cast<void*>(hook_test_square),
+        reinterpret_cast<void*>(square_detour));
+    square_original = engine.original<Function>(id);
+
+    BOOST_REQUIRE(!engine.active(id));
+    BOOST_REQUIRE_EQUAL(call(hook_test_square, 3), 9);
+
+    engine.commit();
+
+    BOOST_REQUIRE(engine.active(id));
+    BOOST_REQUIRE_EQUAL(call(hook_test_square, 3), 10);
+    BOOST_REQUIRE_EQUAL(call(square_original, 3), 9);
+
+    engine.unhook(id);
+    engine.commit();
+
+    BOOST_REQUIRE_EQUAL(call(hook_test_square, 3), 9);
+    BOOST_REQUIRE_EQUAL(engine.size(), 0);
+    BOOST_REQUIRE_THROW(engine.active(id), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_commit_batches_hooks)
+{
+    {
+        edo::HookEngine engine;
+        std::size_t a = engine.hook(reinterpret_cast<void*>(hook_test_square),
+            reinterpret_cast<void*>(square_detour));
+        std::size_t b = engine.hook(reinterpret_cast<void*>(hook_test_negate),
+            reinterpret_cast<void*>(negate_detour));
+        square_original = engine.original<Function>(a);
+        negate_original = engine.original<Function>(b);
+
+        engine.commit();
+
+        BOOST_REQUIRE_EQUAL(engine.size(), 2);
+        BOOST_REQUIRE_EQUAL(call(hook_test_square, 2), 5);
+        BOOST_REQUIRE_EQUAL(call(hook_test_negate, 2), -4);
+        BOOST_REQUIRE_THROW(engine.hook(
+            reinterpret_cast<void*>(hook_test_square),
+            reinterpret_cast<void*>(square_detour)), std::runtime_error);
+    }
+
+    // The destructor removes every hook
+    BOOST_REQUIRE_EQUAL(call(hook_test_square, 2), 4);
+    BOOST_REQUIRE_EQUAL(call(hook_test_negate, 2), -2);
+}
+
+BOOST_AUTO_TEST_CASE(test_relocate_rip_relative_operand)
+{
+    // lea rax, [rip+0x100]; ret
+    Function f = assemble(0, {0x48, 0x8D, 0x05, 0x00, 0x01, 0x00, 0x00, 0xC3});
+    long expected = reinterpret_cast<long>(code + 7 + 0x100);
+
+    edo::HookEngine engine;
+    std::size_t id = engine.hook(reinterpret_cast<void*>(f),
+        reinterpret_cast<void*>(hook_test_negate));
+    engine.commit();
+
+    typedef long (*Lea)();
+    BOOST_REQUIRE_EQUAL(engine.original<Lea>(id)(), expected);
+    BOOST_REQUIRE_EQUAL(call(f, 5), -5);
+}
+
+BOOST_AUTO_TEST_CASE(test_relocate_short_branch)
+{
+    // test edi, edi; je +6; mov eax, 1; ret; mov eax, 2; ret
+    Function f = assemble(0, {0x85, 0xFF, 0x74, 0x06, 0xB8, 0x01, 0x00,
+        0x00, 0x00, 0xC3, 0xB8, 0x02, 0x00, 0x00, 0x00, 0xC3});
+
+    edo::HookEngine engine;
+    std::size_t id = engine.hook(reinterpret_cast<void*>(f),
+        reinterpret_cast<void*>(hook_test_negate));
+    engine.commit();
+
+    Function original = engine.original<Function>(id);
+    BOOST_REQUIRE_EQUAL(call(original, 0), 2);
+    BOOST_REQUIRE_EQUAL(call(original, 7), 1);
+    BOOST_REQUIRE_EQUAL(call(f, 7), -7);
+}
+
+BOOST_AUTO_TEST_CASE(test_hook_throws_when_too_short)
+{
+    // xor eax, eax; ret
+    Function f = assemble(0, {0x31, 0xC0, 0xC3});
+
+    edo::HookEngine engine;
+    BOOST_REQUIRE_THROW(engine.hook(reinterpret_cast<void*>(f),
+        reinterpret_cast<void*>(hook_test_negate)), edo::EdoError);
+    BOOST_REQUIRE_EQUAL(engine.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_hook_throws_on_branch_into_relocated_bytes)
+{
+    // test edi, edi; je +3 into the mov past the jump to the detour, which
+    // is relocated all the same; mov eax, 1; ret
+    Function f = assemble(0, {0x85, 0xFF, 0x74, 0x03, 0xB8, 0x01, 0x00,
+        0x00, 0x00, 0xC3});
+
+    edo::HookEngine engine;
+    BOOST_REQUIRE_THROW(engine.hook(reinterpret_cast<void*>(f),
+        reinterpret_cast<void*>(hook_test_negate)), edo::EdoError);
+    BOOST_REQUIRE_EQUAL(engine.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_allocates_near)
+{
+    edo::TrampolineArena arena;
+    uintptr_t near = reinterpret_cast<uintptr_t>(code);
+
+    uint8_t* a = arena.allocate(near);
+    uint8_t* b = arena.allocate(near);
+    int64_t distance = static_cast<int64_t>(reinterpret_cast<uintptr_t>(a) - near);
+
+    BOOST_REQUIRE(a != b);
+    BOOST_REQUIRE(distance > INT32_MIN && distance < INT32_MAX);
+    BOOST_REQUIRE_EQUAL(arena.chunks(), 1);
+
+    arena.release(a);
+    BOOST_REQUIRE(arena.allocate(near) == a);
+
+    // A request far away needs its own chunk
+    arena.allocate(near > 0x200000000ULL ? near - 0x100000000ULL :
+        near + 0x100000000ULL);
+    BOOST_REQUIRE_EQUAL(arena.chunks(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
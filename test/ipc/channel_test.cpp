@@ -0,0 +1,206 @@
+#include <string>
+#include <vector>
+#include <cstring>
+#include <chrono>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/ipc/channel.hpp"
+
+struct ChannelFixture
+{
+    ChannelFixture() : channel(4096)
+    {
+
+    }
+
+    /// Sends a record of given length filled with a given byte
+    bool send(std::size_t length, uint8_t fill)
+    {
+        std::vector<uint8_t> data(length, fill);
+        return channel.try_send(data.data(), data.size());
+    }
+
+    edo::Channel channel;
+};
+
+BOOST_FIXTURE_TEST_SUITE(channel_test, ChannelFixture)
+
+BOOST_AUTO_TEST_CASE(test_send_and_receive)
+{
+    edo::Bytebuf out;
+    out.put(static_cast<uint32_t>(7));
+    out.put(std::string("seven"));
+
+    BOOST_REQUIRE(channel.send(out));
+
+    edo::Bytebuf in;
+    BOOST_REQUIRE(channel.receive(in, 0));
+    BOOST_REQUIRE_EQUAL(in.size(), out.size());
+    BOOST_REQUIRE_EQUAL(in.get<uint32_t>(), 7);
+    BOOST_REQUIRE_EQUAL(in.get_string(), "seven");
+    BOOST_REQUIRE(!channel.receive(in, 0));
+}
+
+BOOST_AUTO_TEST_CASE(test_reserve_in_place)
+{
+    uint8_t* record = channel.reserve(3);
+    BOOST_REQUIRE(record != nullptr);
+    record[0] = 1;
+    record[1] = 2;
+    record[2] = 3;
+
+    BOOST_REQUIRE(!channel.wait(0));
+    channel.commit();
+    BOOST_REQUIRE(channel.wait(0));
+
+    std::size_t count = channel.drain([&](const uint8_t* data, std::size_t length)
+    {
+        BOOST_REQUIRE(data == record);
+        BOOST_REQUIRE_EQUAL(length, 3);
+        BOOST_REQUIRE_EQUAL(data[2], 3);
+    });
+
+    BOOST_REQUIRE_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_rejects_malformatted_records)
+{
+    // The header sits right before the data of a record
+    uint32_t length = 1 << 20;
+    uint8_t* record = channel.reserve(8);
+    std::memcpy(record - 8, &length, sizeof(length));
+    channel.commit();
+
+    edo::Bytebuf in;
+    BOOST_REQUIRE_THROW(channel.receive(in, 0), std::runtime_error);
+
+    // A record running past the end of the ring
+    edo::Channel other(4096);
+    edo::Channel reader = edo::Channel::open(other.fd());
+    std::vector<uint8_t> data(4000, 1);
+    BOOST_REQUIRE(other.try_send(data.data(), 2000));
+    BOOST_REQUIRE(other.try_send(data.data(), 1000));
+    BOOST_REQUIRE(reader.receive(in, 0));
+    BOOST_REQUIRE(reader.receive(in, 0));
+
+    length = 2000;
+    record = other.reserve(8);
+    std::memcpy(record - 8, &length, sizeof(length));
+    other.commit();
+    BOOST_REQUIRE_THROW(reader.receive(in, 0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_full_and_too_large)
+{
+    BOOST_REQUIRE_EQUAL(channel.capacity(), 4096);
+    BOOST_REQUIRE_THROW(send(channel.max_record() + 1, 0), std::out_of_range);
+
+    std::size_t sent = 0;
+    while(send(100, 0))
+        sent++;
+
+    BOOST_REQUIRE_EQUAL(sent, 4096 / 112);
+    std::vector<uint8_t> data(100);
+    BOOST_REQUIRE(!channel.send(data.data(), data.size(), 5));
+    BOOST_REQUIRE_EQUAL(channel.drain([](const uint8_t*, std::size_t) {}), sent);
+    BOOST_REQUIRE(send(100, 0));
+}
+
+BOOST_AUTO_TEST_CASE(test_records_wrap_around)
+{
+    // Records of odd sizes leave padding at the end of the ring
+    for(int i = 0; i < 100; i++)
+    {
+        std::size_t length = 300 + i * 7;
+        BOOST_REQUIRE(send(length, static_cast<uint8_t>(i)));
+        BOOST_REQUIRE(send(length / 2, static_cast<uint8_t>(i + 1)));
+
+        std::size_t count = channel.drain([&](const uint8_t* data, std::size_t size)
+        {
+            BOOST_REQUIRE(size == length || size == length / 2);
+            BOOST_REQUIRE_EQUAL(data[0], data[size - 1]);
+        });
+
+        BOOST_REQUIRE_EQUAL(count, 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_open_from_fd)
+{
+    edo::Channel other = edo::Channel::open(channel.fd());
+    BOOST_REQUIRE_EQUAL(other.capacity(), channel.capacity());
+
+    BOOST_REQUIRE(send(10, 0xAB));
+
+    edo::Bytebuf in;
+    BOOST_REQUIRE(other.receive(in, 0));
+    BOOST_REQUIRE_EQUAL(in.get<uint8_t>(9), 0xAB);
+
+    int fd = memfd_create("edo-test-malformatted", 0);
+    BOOST_REQUIRE(ftruncate(fd, 16384) == 0);
+    BOOST_REQUIRE_THROW(edo::Channel::open(fd), std::runtime_error);
+    close(fd);
+
+    // The rejected file is not left mapped
+    std::vector<uint8_t> maps = edo::read_file("/proc/self/maps");
+    std::string str(maps.begin(), maps.end());
+    BOOST_REQUIRE(str.find("edo-test-malformatted") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_wait_times_out)
+{
+    auto begin = std::chrono::steady_clock::now();
+    BOOST_REQUIRE(!channel.wait(20));
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    BOOST_REQUIRE(elapsed >= std::chrono::milliseconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(test_between_processes)
+{
+    const uint32_t count = 20000;
+    edo::Channel reply(4096);
+
+    pid_t pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+
+    if(pid == 0)
+    {
+        // Sum every record and send the result back
+        uint64_t sum = 0;
+        uint32_t received = 0;
+        while(received < count && channel.wait(5000))
+        {
+            received += channel.drain([&](const uint8_t* data, std::size_t)
+            {
+                uint32_t value;
+                std::memcpy(&value, data, sizeof(value));
+                sum += value;
+            });
+        }
+
+        reply.send(reinterpret_cast<uint8_t*>(&sum), sizeof(sum), 5000);
+        _exit(0);
+    }
+
+    uint64_t expected = 0;
+    for(uint32_t i = 0; i < count; i++)
+    {
+        BOOST_REQUIRE(channel.send(reinterpret_cast<uint8_t*>(&i), sizeof(i), 5000));
+        expected += i;
+    }
+
+    edo::Bytebuf result;
+    bool received = reply.receive(result, 5000);
+    waitpid(pid, nullptr, 0);
+
+    BOOST_REQUIRE(received);
+    BOOST_REQUIRE_EQUAL(result.get<uint64_t>(), expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,40 @@
+#include <sys/mman.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/dirty.hpp"
+
+BOOST_AUTO_TEST_SUITE(dirty_test)
+
+BOOST_AUTO_TEST_CASE(test_clear_matches_kernel_support)
+{
+    edo::DirtyTracker tracker;
+    BOOST_REQUIRE_EQUAL(tracker.clear(), edo::DirtyTracker::supported());
+}
+
+BOOST_AUTO_TEST_CASE(test_dirty_reads_one_flag_per_page)
+{
+    std::size_t size = 2 * edo::DirtyTracker::page_size();
+    uint8_t* pages = static_cast<uint8_t*>(mmap(nullptr, size,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+    edo::DirtyTracker tracker;
+    std::vector<uint8_t> flags;
+    bool cleared = tracker.clear();
+    pages[0] = 1;
+
+    BOOST_REQUIRE_EQUAL(
+        tracker.dirty(reinterpret_cast<uintptr_t>(pages), 2, flags),
+        true
+    );
+    BOOST_REQUIRE_EQUAL(flags.size(), 2);
+
+    if(cleared)
+    {
+        BOOST_REQUIRE(flags[0] != 0);
+        BOOST_REQUIRE(flags[1] == 0);
+    }
+
+    munmap(pages, size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <link.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/misc.hpp"
+#include "edo/base/error.hpp"
+#include "edo/mem/elf.hpp"
+#include "edo/mem/module.hpp"
+#include "edo/scan/scanner.hpp"
+
+// A unique byte sequence in the read only data of the test executable
+extern const uint8_t elf_test_target[];
+const uint8_t elf_test_target[] = {0x3C, 0x91, 0xE4, 0x0B, 0x7A, 0xD2,
+    0x58, 0x16, 0xAF, 0x63};
+
+struct ElfFixture
+{
+    ElfFixture()
+    {
+        path = "elf_test.bin";
+    }
+
+    ~ElfFixture()
+    {
+        std::remove(path.c_str());
+    }
+
+    edo::Module module = edo::Module::find("");
+    edo::ElfFile file{module.path()};
+    std::string path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(elf_test, ElfFixture)
+
+BOOST_AUTO_TEST_CASE(test_parse_headers)
+{
+    const edo::ElfSection* text = file.section(".text");
+
+    BOOST_REQUIRE(text != nullptr);
+    BOOST_REQUIRE_EQUAL(text->type, SHT_PROGBITS);
+    BOOST_REQUIRE(text->flags & SHF_EXECINSTR);
+    BOOST_REQUIRE(file.section(".rodata") != nullptr);
+    BOOST_REQUIRE(file.section(".nonexistant") == nullptr);
+
+    std::size_t loads = 0;
+    for(const edo::ElfSegment& segment : file.segments())
+    {
+        if(segment.type == PT_LOAD)
+            loads++;
+    }
+
+    BOOST_REQUIRE_EQUAL(loads, module.segments().size());
+}
+
+BOOST_AUTO_TEST_CASE(test_id_matches_loaded_module)
+{
+    BOOST_REQUIRE(file.build_id() == module.build_id());
+    BOOST_REQUIRE_EQUAL(file.id(), module.id());
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_offsets_and_addresses)
+{
+    uint64_t address = reinterpret_cast<uintptr_t>(elf_test_target) - module.base();
+    uint64_t offset = file.offset(address);
+
+    BOOST_REQUIRE_EQUAL(file.address(offset), address);
+    BOOST_REQUIRE(std::memcmp(file.data() + offset, elf_test_target,
+        sizeof(elf_test_target)) == 0);
+    BOOST_REQUIRE_THROW(file.offset(0xFFFFFFFFFFFF0000ULL), std::out_of_range);
+    BOOST_REQUIRE_THROW(file.address(file.size() + 1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_file)
+{
+    edo::Scanner scanner;
+    scanner.add(edo::Pattern("3C 91 E4 ?? 7A D2 58 16 AF 63"));
+    scanner.add(edo::Pattern("3C 91 E4 0B 7A D2 58 16 AF 64"));
+
+    std::vector<const uint8_t*> hits = scanner.scan(file);
+
+    BOOST_REQUIRE_EQUAL(hits.size(), 2);
+    BOOST_REQUIRE(hits[0] != nullptr);
+    BOOST_REQUIRE(hits[1] == nullptr);
+    BOOST_REQUIRE_EQUAL(file.address(hits[0] - file.data()) + module.base(),
+        reinterpret_cast<uintptr_t>(elf_test_target));
+
+    // The target is not executable
+    BOOST_REQUIRE(scanner.scan(file, {".text"})[0] == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_open_throws_when_invalid)
+{
+    BOOST_REQUIRE_THROW(edo::ElfFile("nonexistant.so"), edo::NotFoundError);
+
+    std::vector<uint8_t> data(256, 0);
+    edo::write_file(path, data.data(), data.size());
+    BOOST_REQUIRE_THROW(edo::ElfFile{path}, std::runtime_error);
+
+    // Section headers pointing past the end of the file
+    data = edo::read_file(module.path());
+    data.resize(data.size() / 2);
+    edo::write_file(path, data.data(), data.size());
+    BOOST_REQUIRE_THROW(edo::ElfFile{path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/memory.hpp"
+
+BOOST_AUTO_TEST_SUITE(memory_test)
+
+BOOST_AUTO_TEST_CASE(test_read)
+{
+    edo::Memory mem;
+    int32_t src = 1234;
+    int32_t dst = 0;
+
+    BOOST_REQUIRE_EQUAL(mem.read(reinterpret_cast<uintptr_t>(&src), dst), true);
+    BOOST_REQUIRE_EQUAL(dst, 1234);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_invalid_address_fails)
+{
+    edo::Memory mem;
+    int32_t dst = 0;
+
+    BOOST_REQUIRE_EQUAL(mem.read(16, dst), false);
+}
+
+BOOST_AUTO_TEST_CASE(test_write)
+{
+    edo::Memory mem;
+    int32_t src = 1234;
+    int32_t dst = 0;
+
+    BOOST_REQUIRE_EQUAL(
+        mem.write(reinterpret_cast<uintptr_t>(&dst), &src, sizeof(src)),
+        true
+    );
+    BOOST_REQUIRE_EQUAL(dst, 1234);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_batch_skips_failed_reads)
+{
+    edo::Memory mem;
+    int32_t values[] = {1, 2, 3};
+    int32_t out[4] = {0, 0, 0, 0};
+
+    std::vector<edo::ReadOp> ops(4);
+    for(int i = 0; i < 4; i++)
+    {
+        ops[i].out = &out[i];
+        ops[i].length = sizeof(int32_t);
+    }
+
+    ops[0].address = reinterpret_cast<uintptr_t>(&values[0]);
+    ops[1].address = 16;
+    ops[2].address = reinterpret_cast<uintptr_t>(&values[1]);
+    ops[3].address = reinterpret_cast<uintptr_t>(&values[2]);
+
+    BOOST_REQUIRE_EQUAL(mem.read_batch(ops), 3);
+    BOOST_REQUIRE_EQUAL(ops[0].ok, true);
+    BOOST_REQUIRE_EQUAL(ops[1].ok, false);
+    BOOST_REQUIRE_EQUAL(ops[2].ok, true);
+    BOOST_REQUIRE_EQUAL(ops[3].ok, true);
+    BOOST_REQUIRE_EQUAL(out[0], 1);
+    BOOST_REQUIRE_EQUAL(out[2], 2);
+    BOOST_REQUIRE_EQUAL(out[3], 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_batch_larger_than_one_system_call)
+{
+    edo::Memory mem;
+    std::vector<uint8_t> src(3000);
+    std::vector<uint8_t> dst(3000, 0);
+    std::vector<edo::ReadOp> ops(3000);
+
+    for(std::size_t i = 0; i < src.size(); i++)
+    {
+        src[i] = static_cast<uint8_t>(i);
+        ops[i].address = reinterpret_cast<uintptr_t>(&src[i]);
+        ops[i].out = &dst[i];
+        ops[i].length = 1;
+    }
+
+    BOOST_REQUIRE_EQUAL(mem.read_batch(ops), 3000);
+    BOOST_REQUIRE(src == dst);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
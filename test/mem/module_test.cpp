@@ -0,0 +1,51 @@
+#include <boost/test/unit_test.hpp>
+
+#include "edo/base/error.hpp"
+#include "edo/mem/module.hpp"
+
+namespace
+{
+    int module_test_local = 10;
+}
+
+BOOST_AUTO_TEST_SUITE(module_test)
+
+BOOST_AUTO_TEST_CASE(test_find_main_executable)
+{
+    edo::Module m = edo::Module::find("");
+
+    BOOST_REQUIRE(!m.segments().empty());
+    BOOST_REQUIRE(m.path().find("edo-test") != std::string::npos);
+    BOOST_REQUIRE(m.contains(
+        reinterpret_cast<uintptr_t>(&module_test_local), sizeof(int)));
+}
+
+BOOST_AUTO_TEST_CASE(test_find_by_file_name)
+{
+    edo::Module m = edo::Module::find("edo-test");
+    BOOST_REQUIRE_EQUAL(m.path(), edo::Module::find("").path());
+}
+
+BOOST_AUTO_TEST_CASE(test_find_throws_not_found_error)
+{
+    BOOST_REQUIRE_THROW(edo::Module::find("nonexistant.so"),
+        edo::NotFoundError);
+}
+
+BOOST_AUTO_TEST_CASE(test_id_is_stable)
+{
+    edo::Module m = edo::Module::find("");
+
+    BOOST_REQUIRE(!m.id().empty());
+    BOOST_REQUIRE_EQUAL(m.id(), edo::Module::find("").id());
+}
+
+BOOST_AUTO_TEST_CASE(test_contains_rejects_ranges_outside_module)
+{
+    edo::Module m = edo::Module::find("");
+
+    BOOST_REQUIRE_EQUAL(m.contains(0, 1), false);
+    BOOST_REQUIRE_EQUAL(m.contains(m.segments().back().end, 1), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/pointer.hpp"
+
+struct PointerFixture
+{
+    PointerFixture()
+    {
+        value = 10;
+        inner[0] = 0;
+        inner[1] = reinterpret_cast<uintptr_t>(&value);
+        outer = reinterpret_cast<uintptr_t>(&inner);
+
+        std::vector<intptr_t> offsets;
+        offsets.push_back(0);
+        offsets.push_back(sizeof(uintptr_t));
+        path = edo::PointerPath(reinterpret_cast<uintptr_t>(&outer), offsets);
+    }
+
+    uintptr_t expected()
+    {
+        return reinterpret_cast<uintptr_t>(&value);
+    }
+
+    int32_t value;
+    uintptr_t inner[2];
+    uintptr_t outer;
+    edo::PointerPath path;
+    edo::Memory mem;
+};
+
+BOOST_FIXTURE_TEST_SUITE(pointer_test, PointerFixture)
+
+BOOST_AUTO_TEST_CASE(test_path_resolve)
+{
+    uintptr_t res = 0;
+
+    BOOST_REQUIRE_EQUAL(path.depth(), 2);
+    BOOST_REQUIRE_EQUAL(path.resolve(mem, res), true);
+    BOOST_REQUIRE_EQUAL(res, expected());
+}
+
+BOOST_AUTO_TEST_CASE(test_path_resolve_fails_on_bad_pointer)
+{
+    uintptr_t res = 0;
+    outer = 16;
+
+    BOOST_REQUIRE_EQUAL(path.resolve(mem, res), false);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolver_resolves_every_path)
+{
+    edo::PointerResolver resolver;
+    resolver.add(path);
+    resolver.add(edo::PointerPath(1234, std::vector<intptr_t>()));
+
+    BOOST_REQUIRE_EQUAL(resolver.resolve(), 2);
+    BOOST_REQUIRE_EQUAL(resolver.address(0), expected());
+    BOOST_REQUIRE_EQUAL(resolver.address(1), 1234);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolver_reports_bad_pointers)
+{
+    edo::PointerResolver resolver;
+    resolver.add(path);
+    inner[1] = 16;
+
+    std::vector<intptr_t> offsets(3, 0);
+    resolver.add(edo::PointerPath(reinterpret_cast<uintptr_t>(&outer), offsets));
+    resolver.add(path);
+
+    BOOST_REQUIRE_EQUAL(resolver.resolve(), 2);
+    BOOST_REQUIRE_EQUAL(resolver.valid(0), true);
+    BOOST_REQUIRE_EQUAL(resolver.valid(1), false);
+    BOOST_REQUIRE_EQUAL(resolver.address(2), 16);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolver_follows_last_hop_changes)
+{
+    int32_t other = 0;
+    edo::PointerResolver resolver;
+    resolver.add(path);
+    resolver.resolve();
+
+    inner[1] = reinterpret_cast<uintptr_t>(&other);
+    resolver.resolve();
+
+    BOOST_REQUIRE_EQUAL(resolver.address(0),
+        reinterpret_cast<uintptr_t>(&other));
+}
+
+BOOST_AUTO_TEST_CASE(test_resolver_rereads_chain_when_first_hop_changes)
+{
+    int32_t other = 0;
+    uintptr_t other_inner[2] = {0, reinterpret_cast<uintptr_t>(&other)};
+
+    edo::PointerResolver resolver;
+    resolver.add(path);
+    resolver.resolve();
+
+    outer = reinterpret_cast<uintptr_t>(&other_inner);
+    resolver.resolve();
+
+    BOOST_REQUIRE_EQUAL(resolver.address(0),
+        reinterpret_cast<uintptr_t>(&other));
+}
+
+BOOST_AUTO_TEST_CASE(test_resolver_rereads_chain_when_middle_hop_changes)
+{
+    int32_t other = 0;
+    uintptr_t other_inner[2] = {0, reinterpret_cast<uintptr_t>(&other)};
+    uintptr_t middle = reinterpret_cast<uintptr_t>(&inner);
+    uintptr_t top = reinterpret_cast<uintptr_t>(&middle);
+
+    std::vector<intptr_t> offsets;
+    offsets.push_back(0);
+    offsets.push_back(0);
+    offsets.push_back(sizeof(uintptr_t));
+
+    edo::PointerResolver resolver;
+    resolver.add(edo::PointerPath(reinterpret_cast<uintptr_t>(&top), offsets));
+    resolver.resolve();
+
+    middle = reinterpret_cast<uintptr_t>(&other_inner);
+    BOOST_REQUIRE_EQUAL(resolver.resolve(), 1);
+
+    BOOST_REQUIRE_EQUAL(resolver.valid(0), true);
+    BOOST_REQUIRE_EQUAL(resolver.address(0),
+        reinterpret_cast<uintptr_t>(&other));
+}
+
+BOOST_AUTO_TEST_CASE(test_resolver_validates_against_regions)
+{
+    edo::RegionTable regions = edo::RegionTable::load();
+    edo::PointerResolver resolver;
+    resolver.set_regions(&regions);
+    resolver.add(path);
+
+    BOOST_REQUIRE_EQUAL(resolver.resolve(), 1);
+
+    outer = 16;
+    BOOST_REQUIRE_EQUAL(resolver.resolve(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,289 @@
+#include <cstdio>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/ptrscan.hpp"
+
+namespace
+{
+    struct Player
+    {
+        int32_t padding[6];
+        int32_t health;
+    };
+
+    struct World
+    {
+        uintptr_t padding[3];
+        Player* player;
+    };
+
+    // The static end of the chains searched for
+    World* ptrscan_world = nullptr;
+
+    const std::size_t BSS_WORLDS = 2048;
+
+    // Zero-initialized and larger than a page, so its end lies in the part
+    // of .bss mapped anonymously after the file
+    World* ptrscan_bss_worlds[BSS_WORLDS];
+}
+
+struct PointerScanFixture
+{
+    // Building the map also picks up pointers left behind by earlier
+    // builds in the test process, so the map is built only once
+    PointerScanFixture() : scanner(shared_scanner())
+    {
+        world = ptrscan_world;
+        scanner.set_max_depth(2);
+        scanner.set_max_results(0);
+    }
+
+    ~PointerScanFixture()
+    {
+        std::remove("ptrscan_test.bin");
+    }
+
+    static edo::PointerScanner& shared_scanner()
+    {
+        static edo::PointerScanner* scanner = nullptr;
+        if(scanner == nullptr)
+        {
+            ptrscan_world = new World();
+            ptrscan_world->player = new Player();
+            ptrscan_bss_worlds[BSS_WORLDS - 1] = ptrscan_world;
+
+            scanner = new edo::PointerScanner();
+            scanner->set_max_offset(0x100);
+            scanner->set_threads(2);
+            scanner->build(edo::RegionTable::load());
+        }
+
+        return *scanner;
+    }
+
+    uintptr_t target()
+    {
+        return reinterpret_cast<uintptr_t>(&world->player->health);
+    }
+
+    // Returns the chain through ptrscan_world if found
+    const edo::PointerChain* expected(const std::vector<edo::PointerChain>& chains)
+    {
+        return expected(chains, reinterpret_cast<uintptr_t>(&ptrscan_world));
+    }
+
+    // Returns the chain through a world stored at a given address if found
+    const edo::PointerChain* expected(
+        const std::vector<edo::PointerChain>& chains,
+        const uintptr_t root
+    )
+    {
+        std::map<std::string, uintptr_t> bases =
+            edo::module_bases(edo::RegionTable::load());
+
+        for(const edo::PointerChain& chain : chains)
+        {
+            if(chain.offsets.size() == 3 && chain.offsets[1] ==
+                static_cast<intptr_t>(offsetof(World, player)) &&
+                bases[chain.module] + chain.offsets[0] == root)
+            {
+                return &chain;
+            }
+        }
+
+        return nullptr;
+    }
+
+    World* world;
+    edo::PointerScanner& scanner;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ptrscan_test, PointerScanFixture)
+
+BOOST_AUTO_TEST_CASE(test_build_sorts_pointer_map)
+{
+    const std::vector<edo::PointerEntry>& entries = scanner.entries();
+
+    BOOST_REQUIRE(!entries.empty());
+    for(std::size_t i = 1; i < entries.size(); i++)
+        BOOST_REQUIRE(entries[i - 1].value <= entries[i].value);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_finds_static_chain)
+{
+    auto chains = scanner.scan(target());
+    const edo::PointerChain* chain = expected(chains);
+
+    BOOST_REQUIRE(chain != nullptr);
+    BOOST_REQUIRE_EQUAL(chain->module, "edo-test");
+    BOOST_REQUIRE_EQUAL(chain->last_offset(), offsetof(Player, health));
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_finds_chain_in_anonymous_bss)
+{
+    uintptr_t root = reinterpret_cast<uintptr_t>(
+        &ptrscan_bss_worlds[BSS_WORLDS - 1]);
+
+    edo::RegionTable regions = edo::RegionTable::load();
+    const edo::Region* region = regions.find(root);
+    BOOST_REQUIRE(region != nullptr);
+    BOOST_REQUIRE(region->path.empty());
+
+    auto chains = scanner.scan(target());
+    const edo::PointerChain* chain = expected(chains, root);
+
+    BOOST_REQUIRE(chain != nullptr);
+    BOOST_REQUIRE_EQUAL(chain->module, "edo-test");
+}
+
+BOOST_AUTO_TEST_CASE(test_module_bases_include_bss)
+{
+    edo::RegionTable regions;
+    regions.parse(
+        "00400000-00401000 r--p 00000000 08:01 1 /opt/game/bin/game\n"
+        "00600000-00601000 rw-p 00001000 08:01 1 /opt/game/bin/game\n"
+        "00601000-00603000 rw-p 00000000 00:00 0 \n"
+        "00700000-00701000 rw-p 00000000 00:00 0 \n");
+
+    std::map<std::string, uintptr_t> bases = edo::module_bases(regions);
+    BOOST_REQUIRE_EQUAL(bases.size(), 1);
+    BOOST_REQUIRE_EQUAL(bases["game"], 0x400000);
+}
+
+BOOST_AUTO_TEST_CASE(test_module_bases_skip_ambiguous_names)
+{
+    edo::RegionTable regions;
+    regions.parse(
+        "00400000-00401000 r--p 00000000 08:01 1 /opt/game/bin/game\n"
+        "00600000-00601000 rw-p 00001000 08:01 1 /opt/game/bin/game\n"
+        "7f000000-7f001000 r--p 00000000 08:01 2 /opt/game/lib/core.so\n"
+        "7f100000-7f101000 r--p 00000000 08:01 3 /opt/mods/lib/core.so\n");
+
+    std::map<std::string, uintptr_t> bases = edo::module_bases(regions);
+    BOOST_REQUIRE_EQUAL(bases.size(), 1);
+    BOOST_REQUIRE_EQUAL(bases["game"], 0x400000);
+    BOOST_REQUIRE(bases.find("core.so") == bases.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_respects_max_depth)
+{
+    scanner.set_max_depth(1);
+    auto chains = scanner.scan(target());
+
+    BOOST_REQUIRE(expected(chains) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_respects_max_results)
+{
+    scanner.set_max_results(1);
+    BOOST_REQUIRE(scanner.scan(target()).size() <= 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_chain_resolves_to_target)
+{
+    auto chains = scanner.scan(target());
+    const edo::PointerChain* chain = expected(chains);
+    BOOST_REQUIRE(chain != nullptr);
+
+    std::map<std::string, uintptr_t> bases =
+        edo::module_bases(edo::RegionTable::load());
+    uintptr_t res = 0;
+
+    BOOST_REQUIRE(chain->path(bases[chain->module]).resolve(edo::Memory(), res));
+    BOOST_REQUIRE_EQUAL(res + chain->last_offset(), target());
+}
+
+BOOST_AUTO_TEST_CASE(test_save_and_load_chain_set)
+{
+    edo::PointerChainSet set(scanner.scan(target()));
+    set.save("ptrscan_test.bin");
+
+    edo::PointerChainSet loaded;
+    loaded.load("ptrscan_test.bin");
+
+    BOOST_REQUIRE_EQUAL(loaded.size(), set.size());
+    BOOST_REQUIRE(expected(loaded.chains()) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_serialize_keeps_wide_chains)
+{
+    edo::PointerChain chain;
+    chain.module = "game";
+    chain.offsets.assign(300, 0x10);
+    chain.offsets[0] = static_cast<intptr_t>(1) << 40;
+    chain.offsets[1] = -(static_cast<intptr_t>(1) << 35);
+
+    edo::Bytebuf buf = edo::PointerChainSet({chain}).serialize();
+    buf.rewind();
+
+    edo::PointerChainSet parsed;
+    parsed.parse(buf);
+    BOOST_REQUIRE_EQUAL(parsed.size(), 1);
+    BOOST_REQUIRE(parsed.chains()[0].offsets == chain.offsets);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_rejects_other_versions)
+{
+    edo::Bytebuf buf;
+    buf.put(static_cast<uint32_t>(0x53504445));
+    buf.put(static_cast<uint32_t>(1));
+    buf.put(static_cast<uint32_t>(0));
+    buf.put(static_cast<uint32_t>(0));
+    buf.rewind();
+
+    edo::PointerChainSet parsed;
+    BOOST_REQUIRE_THROW(parsed.parse(buf), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_rejects_oversized_counts)
+{
+    edo::Bytebuf modules;
+    modules.put(static_cast<uint32_t>(0x53504445));
+    modules.put(static_cast<uint32_t>(2));
+    modules.put(static_cast<uint32_t>(0xFFFFFFFF));
+    modules.rewind();
+
+    edo::PointerChainSet parsed;
+    BOOST_REQUIRE_THROW(parsed.parse(modules), std::out_of_range);
+
+    edo::Bytebuf chains;
+    chains.put(static_cast<uint32_t>(0x53504445));
+    chains.put(static_cast<uint32_t>(2));
+    chains.put(static_cast<uint32_t>(0));
+    chains.put(static_cast<uint32_t>(0xFFFFFFFF));
+    chains.rewind();
+    BOOST_REQUIRE_THROW(parsed.parse(chains), std::out_of_range);
+
+    edo::Bytebuf offsets;
+    offsets.put(static_cast<uint32_t>(0x53504445));
+    offsets.put(static_cast<uint32_t>(2));
+    offsets.put(static_cast<uint32_t>(1));
+    offsets.put(std::string("game"));
+    offsets.put(static_cast<uint32_t>(1));
+    offsets.put(static_cast<uint32_t>(0));
+    offsets.put(static_cast<uint32_t>(0xFFFFFFFF));
+    offsets.rewind();
+    BOOST_REQUIRE_THROW(parsed.parse(offsets), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_filter_keeps_chains_to_new_target)
+{
+    edo::PointerChainSet set(scanner.scan(target()));
+
+    // Move the player, only chains through the world remain valid
+    Player* moved = new Player();
+    Player* old = world->player;
+    world->player = moved;
+
+    set.filter(edo::Memory(), edo::RegionTable::load(),
+        reinterpret_cast<uintptr_t>(&moved->health));
+
+    world->player = old;
+    delete moved;
+
+    BOOST_REQUIRE(expected(set.chains()) != nullptr);
+    for(const edo::PointerChain& chain : set.chains())
+        BOOST_REQUIRE(chain.offsets.size() > 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/region.hpp"
+
+struct RegionFixture
+{
+    RegionFixture()
+    {
+        table.parse(
+            "00400000-00452000 r-xp 00000000 08:02 173521 /usr/bin/game\n"
+            "00651000-00652000 rw-p 00051000 08:02 173521 /usr/bin/game\n"
+            "00652000-00655000 rw-p 00000000 00:00 0 \n"
+            "01000000-01021000 rw-p 00000000 00:00 0 [heap]\n"
+            "7f0000000000-7f0000001000 ---p 00000000 00:00 0\n"
+        );
+    }
+
+    edo::RegionTable table;
+};
+
+BOOST_FIXTURE_TEST_SUITE(region_test, RegionFixture)
+
+BOOST_AUTO_TEST_CASE(test_parse_reads_every_field)
+{
+    BOOST_REQUIRE_EQUAL(table.size(), 5);
+
+    const edo::Region& r = table.regions()[1];
+    BOOST_REQUIRE_EQUAL(r.begin, 0x651000);
+    BOOST_REQUIRE_EQUAL(r.end, 0x652000);
+    BOOST_REQUIRE_EQUAL(r.size(), 0x1000);
+    BOOST_REQUIRE_EQUAL(r.readable, true);
+    BOOST_REQUIRE_EQUAL(r.writable, true);
+    BOOST_REQUIRE_EQUAL(r.executable, false);
+    BOOST_REQUIRE_EQUAL(r.offset, 0x51000);
+    BOOST_REQUIRE_EQUAL(r.path, "/usr/bin/game");
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_anonymous_and_pseudo_paths)
+{
+    BOOST_REQUIRE_EQUAL(table.regions()[2].path, "");
+    BOOST_REQUIRE_EQUAL(table.regions()[3].path, "[heap]");
+    BOOST_REQUIRE_EQUAL(table.regions()[4].path, "");
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_throws_runtime_error_when_malformed)
+{
+    BOOST_REQUIRE_THROW(table.parse("00400000 r-xp\n"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_find)
+{
+    BOOST_REQUIRE(table.find(0x400000) == &table.regions()[0]);
+    BOOST_REQUIRE(table.find(0x451FFF) == &table.regions()[0]);
+    BOOST_REQUIRE(table.find(0x452000) == nullptr);
+    BOOST_REQUIRE(table.find(0x1000010) == &table.regions()[3]);
+    BOOST_REQUIRE(table.find(0) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_readable_spans_adjacent_regions)
+{
+    BOOST_REQUIRE_EQUAL(table.readable(0x651FF8, 16), true);
+    BOOST_REQUIRE_EQUAL(table.readable(0x654FF8, 16), false);
+    BOOST_REQUIRE_EQUAL(table.readable(0x7f0000000000, 1), false);
+}
+
+BOOST_AUTO_TEST_CASE(test_load_current_process)
+{
+    int local = 0;
+    edo::RegionTable own = edo::RegionTable::load();
+
+    BOOST_REQUIRE(own.size() > 0);
+    BOOST_REQUIRE(own.readable(reinterpret_cast<uintptr_t>(&local),
+        sizeof(local)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,284 @@
+#include <set>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/valscan.hpp"
+
+// Reports only the pages it is told about as written to
+struct FakeTracker : public edo::DirtyTracker
+{
+    FakeTracker()
+    {
+        clears = 0;
+    }
+
+    bool clear() override
+    {
+        clears++;
+        return true;
+    }
+
+    bool dirty(
+        const uintptr_t begin,
+        const std::size_t pages,
+        std::vector<uint8_t>& out
+    ) override
+    {
+        out.assign(pages, 0);
+        for(std::size_t i = 0; i < pages; i++)
+            out[i] = written.count(begin + i * page_size()) ? 1 : 0;
+
+        return true;
+    }
+
+    std::size_t clears;
+    std::set<uintptr_t> written;
+};
+
+struct ValueScanFixture
+{
+    ValueScanFixture()
+    {
+        size = 4 * 4096;
+        buffer = static_cast<uint8_t*>(mmap(nullptr, size,
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+        // Only the buffer is scanned, keeping the results predictable
+        char maps[128];
+        std::snprintf(maps, sizeof(maps), "%llx-%llx rw-p 00000000 00:00 0\n",
+            static_cast<unsigned long long>(address(0)),
+            static_cast<unsigned long long>(address(size)));
+        regions.parse(maps);
+    }
+
+    ~ValueScanFixture()
+    {
+        munmap(buffer, size);
+    }
+
+    uintptr_t address(const std::size_t offset)
+    {
+        return reinterpret_cast<uintptr_t>(buffer) + offset;
+    }
+
+    template<typename T>
+    void put(const std::size_t offset, const T value)
+    {
+        std::memcpy(buffer + offset, &value, sizeof(T));
+    }
+
+    std::size_t size;
+    uint8_t* buffer;
+    edo::RegionTable regions;
+    edo::ValueScanner scanner;
+};
+
+BOOST_FIXTURE_TEST_SUITE(valscan_test, ValueScanFixture)
+
+BOOST_AUTO_TEST_CASE(test_first_scan_exact)
+{
+    put<int32_t>(0, 1337);
+    put<int32_t>(4096 + 64, 1337);
+    put<int32_t>(3 * 4096 + 4092, 1337);
+
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::exact, 1337), 3);
+
+    auto res = scanner.addresses();
+    BOOST_REQUIRE_EQUAL(res[0], address(0));
+    BOOST_REQUIRE_EQUAL(res[1], address(4096 + 64));
+    BOOST_REQUIRE_EQUAL(res[2], address(3 * 4096 + 4092));
+}
+
+BOOST_AUTO_TEST_CASE(test_first_scan_unaligned_across_pages)
+{
+    put<int32_t>(4094, 0x12345678);
+    put<int32_t>(8193, 0x12345678);
+
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::exact, 0x12345678), 0);
+
+    scanner.set_alignment(1);
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::exact, 0x12345678), 2);
+
+    auto res = scanner.addresses();
+    BOOST_REQUIRE_EQUAL(res[0], address(4094));
+    BOOST_REQUIRE_EQUAL(res[1], address(8193));
+}
+
+BOOST_AUTO_TEST_CASE(test_first_scan_range)
+{
+    put<float>(16, 1.5f);
+    put<float>(32, 2.5f);
+    put<float>(48, 3.5f);
+
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<float>(regions,
+        edo::ScanOp::range, 1.0f, 3.0f), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_first_scan_unknown_keeps_every_offset)
+{
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int64_t>(regions,
+        edo::ScanOp::unknown), size / sizeof(int64_t));
+
+    // Zero pages are not copied
+    BOOST_REQUIRE(scanner.memory_usage() < 4096);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_changed_and_unchanged)
+{
+    scanner.first_scan<int32_t>(regions, edo::ScanOp::unknown);
+
+    put<int32_t>(8, 1);
+    put<int32_t>(4096, 2);
+    put<int32_t>(3 * 4096 + 12, 3);
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::changed), 3);
+    BOOST_REQUIRE_EQUAL(scanner.addresses()[1], address(4096));
+
+    put<int32_t>(4096, 5);
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::unchanged), 2);
+    BOOST_REQUIRE_EQUAL(scanner.addresses()[1], address(3 * 4096 + 12));
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_increased_and_decreased)
+{
+    for(std::size_t i = 0; i < 8; i++)
+        put<double>(i * 512, 10.0);
+
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<double>(regions,
+        edo::ScanOp::exact, 10.0), 8);
+
+    put<double>(0, 11.0);
+    put<double>(512, 9.0);
+    put<double>(1024, 12.0);
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<double>(edo::ScanOp::increased), 2);
+
+    put<double>(0, 10.5);
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<double>(edo::ScanOp::decreased), 1);
+    BOOST_REQUIRE_EQUAL(scanner.addresses()[0], address(0));
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_exact_narrows_dense_candidates)
+{
+    for(std::size_t i = 0; i < 1000; i++)
+        put<int16_t>(i * 2, 7);
+
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int16_t>(regions,
+        edo::ScanOp::exact, 7), 1000);
+
+    put<int16_t>(20, 8);
+    put<int16_t>(1000, 8);
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int16_t>(edo::ScanOp::exact, 7), 998);
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int16_t>(edo::ScanOp::unchanged), 998);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_stride_not_dividing_size)
+{
+    scanner.set_alignment(3);
+    scanner.first_scan<int32_t>(regions, edo::ScanOp::unknown);
+
+    // Both lie at offsets of the stride which are not multiples of it
+    // modulo the size of the value
+    put<int32_t>(6, 1337);
+    put<int32_t>(4096 + 9, 1337);
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::exact, 1337),
+        2);
+
+    auto res = scanner.addresses();
+    BOOST_REQUIRE_EQUAL(res[0], address(6));
+    BOOST_REQUIRE_EQUAL(res[1], address(4096 + 9));
+
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::exact, 1337), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_drops_unmapped_pages)
+{
+    put<uint8_t>(100, 42);
+    put<uint8_t>(3 * 4096 + 100, 42);
+    scanner.first_scan<uint8_t>(regions, edo::ScanOp::exact, 42);
+
+    munmap(buffer + 3 * 4096, 4096);
+    size = 3 * 4096;
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<uint8_t>(edo::ScanOp::unchanged), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_throws_invalid_argument)
+{
+    scanner.first_scan<int32_t>(regions, edo::ScanOp::unknown);
+
+    BOOST_REQUIRE_THROW(scanner.next_scan<float>(edo::ScanOp::changed),
+        std::invalid_argument);
+    BOOST_REQUIRE_THROW(scanner.next_scan<int32_t>(edo::ScanOp::unknown),
+        std::invalid_argument);
+    BOOST_REQUIRE_THROW(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::changed), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_only_rereads_dirty_pages)
+{
+    FakeTracker tracker;
+    scanner.set_dirty_tracker(&tracker);
+    scanner.first_scan<int32_t>(regions, edo::ScanOp::unknown);
+
+    // The write to the last page is not reported and must go unnoticed
+    put<int32_t>(8, 1);
+    put<int32_t>(3 * 4096, 1);
+    tracker.written.insert(address(0));
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::changed), 1);
+    BOOST_REQUIRE_EQUAL(scanner.addresses()[0], address(8));
+    BOOST_REQUIRE_EQUAL(tracker.clears, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_compares_clean_pages_to_stored_values)
+{
+    FakeTracker tracker;
+    scanner.set_dirty_tracker(&tracker);
+
+    put<int32_t>(4096 + 4, 5);
+    put<int32_t>(2 * 4096 + 4, 6);
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::range, 5, 6), 2);
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::unchanged), 2);
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::exact, 6), 1);
+    BOOST_REQUIRE_EQUAL(scanner.addresses()[0], address(2 * 4096 + 4));
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::increased), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_rereads_when_values_cross_into_dirty_page)
+{
+    FakeTracker tracker;
+    scanner.set_dirty_tracker(&tracker);
+    scanner.set_alignment(1);
+
+    put<int32_t>(4094, 9);
+    BOOST_REQUIRE_EQUAL(scanner.first_scan<int32_t>(regions,
+        edo::ScanOp::exact, 9), 1);
+
+    put<int32_t>(4094, 10);
+    tracker.written.insert(address(4096));
+
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::changed), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_next_scan_with_kernel_tracker_rereads_changes)
+{
+    edo::DirtyTracker tracker;
+    scanner.set_dirty_tracker(&tracker);
+    scanner.first_scan<int32_t>(regions, edo::ScanOp::unknown);
+
+    put<int32_t>(3 * 4096, 1);
+    BOOST_REQUIRE_EQUAL(scanner.next_scan<int32_t>(edo::ScanOp::changed), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
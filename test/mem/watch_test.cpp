@@ -0,0 +1,249 @@
+#include <sys/mman.h>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/watch.hpp"
+
+namespace
+{
+    struct Entity
+    {
+        int32_t health;
+        int32_t armor;
+        float position[3];
+    };
+}
+
+struct WatchFixture
+{
+    WatchFixture()
+    {
+        entity.health = 100;
+        entity.armor = 50;
+        entity.position[0] = 0.0f;
+        entity.position[1] = 0.0f;
+        entity.position[2] = 0.0f;
+        notifications = 0;
+    }
+
+    uintptr_t address(const void* ptr)
+    {
+        return reinterpret_cast<uintptr_t>(ptr);
+    }
+
+    std::function<void(const int32_t&, const int32_t&)> counter()
+    {
+        return [this](const int32_t&, const int32_t&) { notifications++; };
+    }
+
+    Entity entity;
+    int notifications;
+    edo::WatchList watches;
+};
+
+BOOST_FIXTURE_TEST_SUITE(watch_test, WatchFixture)
+
+BOOST_AUTO_TEST_CASE(test_first_poll_notifies)
+{
+    int32_t seen = 0;
+    watches.watch<int32_t>(address(&entity.health),
+        [&](const int32_t& value, const int32_t&) { seen = value; });
+
+    BOOST_REQUIRE_EQUAL(watches.poll(), 1);
+    BOOST_REQUIRE_EQUAL(seen, 100);
+}
+
+BOOST_AUTO_TEST_CASE(test_poll_only_notifies_changes)
+{
+    int32_t previous = 0;
+    watches.watch<int32_t>(address(&entity.health),
+        [&](const int32_t&, const int32_t& prev) { previous = prev; });
+    watches.watch<int32_t>(address(&entity.armor), counter());
+
+    BOOST_REQUIRE_EQUAL(watches.poll(), 2);
+    BOOST_REQUIRE_EQUAL(watches.poll(), 0);
+
+    entity.health = 90;
+    BOOST_REQUIRE_EQUAL(watches.poll(), 1);
+    BOOST_REQUIRE_EQUAL(previous, 100);
+    BOOST_REQUIRE_EQUAL(notifications, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_adjacent_watches_are_coalesced)
+{
+    watches.watch<int32_t>(address(&entity.health), counter());
+    watches.watch<int32_t>(address(&entity.armor), counter());
+    watches.watch<float>(address(&entity.position[2]),
+        [](const float&, const float&) {});
+    watches.poll();
+
+    BOOST_REQUIRE_EQUAL(watches.spans(), 1);
+
+    watches.set_max_gap(0);
+    watches.unwatch(1);
+    watches.poll();
+
+    BOOST_REQUIRE_EQUAL(watches.spans(), 2);
+    BOOST_REQUIRE_EQUAL(watches.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_get_returns_last_value)
+{
+    std::size_t id = watches.watch<int32_t>(address(&entity.armor), counter());
+    int32_t value = 0;
+
+    BOOST_REQUIRE_EQUAL(watches.get(id, value), false);
+    watches.poll();
+    BOOST_REQUIRE_EQUAL(watches.get(id, value), true);
+    BOOST_REQUIRE_EQUAL(value, 50);
+}
+
+BOOST_AUTO_TEST_CASE(test_unreadable_watches_do_not_notify)
+{
+    std::size_t bad = watches.watch<int32_t>(16, counter());
+    watches.watch<int32_t>(address(&entity.health), counter());
+    watches.poll();
+
+    int32_t value;
+    BOOST_REQUIRE_EQUAL(notifications, 1);
+    BOOST_REQUIRE_EQUAL(watches.get(bad, value), false);
+}
+
+BOOST_AUTO_TEST_CASE(test_spans_over_unmapped_memory_fall_back)
+{
+    // Two watches around an unmapped page, coalesced into one span
+    uint8_t* pages = static_cast<uint8_t*>(mmap(nullptr, 3 * 4096,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    munmap(pages + 4096, 4096);
+
+    watches.set_max_gap(2 * 4096);
+    watches.watch<int32_t>(address(pages + 4092), counter());
+    watches.watch<int32_t>(address(pages + 2 * 4096), counter());
+    watches.poll();
+
+    BOOST_REQUIRE_EQUAL(watches.spans(), 1);
+    BOOST_REQUIRE_EQUAL(notifications, 2);
+
+    munmap(pages, 4096);
+    munmap(pages + 2 * 4096, 4096);
+}
+
+BOOST_AUTO_TEST_CASE(test_pointer_path_watch_follows_path)
+{
+    Entity other = entity;
+    other.health = 1;
+    Entity* current = &entity;
+
+    std::vector<intptr_t> offsets(1, 0);
+    edo::PointerPath path(address(&current), offsets);
+
+    int32_t seen = 0;
+    watches.watch<int32_t>(path, offsetof(Entity, health),
+        [&](const int32_t& value, const int32_t&) { seen = value; });
+
+    watches.poll();
+    BOOST_REQUIRE_EQUAL(seen, 100);
+
+    current = &other;
+    BOOST_REQUIRE_EQUAL(watches.poll(), 1);
+    BOOST_REQUIRE_EQUAL(seen, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_unwatch_drops_pointer_path)
+{
+    Entity other = entity;
+    other.armor = 2;
+    Entity* current = &entity;
+
+    std::vector<intptr_t> offsets(1, 0);
+    edo::PointerPath path(address(&current), offsets);
+
+    std::size_t id = watches.watch<int32_t>(path, offsetof(Entity, health),
+        counter());
+    int32_t seen = 0;
+    watches.watch<int32_t>(path, offsetof(Entity, armor),
+        [&](const int32_t& value, const int32_t&) { seen = value; });
+
+    watches.poll();
+    watches.unwatch(id);
+    BOOST_REQUIRE_EQUAL(notifications, 1);
+
+    // The remaining watch still follows its path
+    current = &other;
+    BOOST_REQUIRE_EQUAL(watches.poll(), 1);
+    BOOST_REQUIRE_EQUAL(seen, 2);
+    BOOST_REQUIRE_EQUAL(notifications, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_unwatch_throws_out_of_range)
+{
+    std::size_t id = watches.watch<int32_t>(address(&entity.armor), counter());
+    watches.unwatch(id);
+
+    BOOST_REQUIRE_THROW(watches.unwatch(id), std::out_of_range);
+    BOOST_REQUIRE_THROW(watches.unwatch(100), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_reuse_slots)
+{
+    std::size_t first = watches.watch<int32_t>(address(&entity.armor),
+        counter());
+    watches.poll();
+    watches.unwatch(first);
+
+    // The slot is reused, the old id does not name the new watch
+    int32_t seen = 0;
+    std::size_t second = watches.watch<int32_t>(address(&entity.health),
+        [&](const int32_t& value, const int32_t&) { seen = value; });
+    BOOST_REQUIRE(second != first);
+    BOOST_REQUIRE_THROW(watches.unwatch(first), std::out_of_range);
+    BOOST_REQUIRE_THROW(watches.get(first), std::out_of_range);
+
+    BOOST_REQUIRE_EQUAL(watches.poll(), 1);
+    BOOST_REQUIRE_EQUAL(seen, 100);
+
+    int32_t value = 0;
+    BOOST_REQUIRE(watches.get(second, value));
+    BOOST_REQUIRE_EQUAL(value, 100);
+    BOOST_REQUIRE_EQUAL(watches.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_callback_may_replace_watch)
+{
+    std::size_t armor = 0;
+    int replaced = 0;
+
+    // Whichever runs first replaces the other, taking its slot
+    auto replace = [&](std::size_t& other)
+    {
+        return [&](const int32_t&, const int32_t&)
+        {
+            if(replaced++ > 0)
+                return;
+
+            watches.unwatch(other);
+            watches.watch<int32_t>(address(&entity.position[0]), counter());
+        };
+    };
+
+    std::size_t health = 0;
+    health = watches.watch<int32_t>(address(&entity.health), replace(armor));
+    armor = watches.watch<int32_t>(address(&entity.armor), replace(health));
+
+    // The new watch is not notified with the value of the removed one
+    watches.poll();
+    BOOST_REQUIRE_EQUAL(replaced, 1);
+    BOOST_REQUIRE_EQUAL(notifications, 0);
+    BOOST_REQUIRE_EQUAL(watches.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_callback_may_unwatch_itself)
+{
+    std::size_t id = 0;
+    id = watches.watch<int32_t>(address(&entity.armor),
+        [&](const int32_t&, const int32_t&) { watches.unwatch(id); });
+
+    watches.poll();
+    BOOST_REQUIRE_EQUAL(watches.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
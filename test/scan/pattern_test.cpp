@@ -0,0 +1,148 @@
+#include <boost/test/unit_test.hpp>
+
+#include "edo/scan/pattern.hpp"
+#include "edo/scan/scanner.hpp"
+
+struct PatternFixture
+{
+    PatternFixture()
+    {
+        uint8_t bytes[] = {0x90, 0x48, 0x8B, 0x05, 0x10, 0x20, 0xE8, 0x90,
+            0x48, 0x8B, 0x0D, 0x30, 0x40, 0xE8, 0xC3};
+        data = std::vector<uint8_t>(bytes, bytes + sizeof(bytes));
+    }
+
+    const uint8_t* begin()
+    {
+        return data.data();
+    }
+
+    const uint8_t* end()
+    {
+        return data.data() + data.size();
+    }
+
+    std::vector<uint8_t> data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(pattern_test, PatternFixture)
+
+BOOST_AUTO_TEST_CASE(test_parse_bytes_and_wildcards)
+{
+    edo::Pattern p("48 8b ?? ? E8");
+
+    BOOST_REQUIRE_EQUAL(p.size(), 5);
+    BOOST_REQUIRE_EQUAL(p.bytes()[0], 0x48);
+    BOOST_REQUIRE_EQUAL(p.bytes()[1], 0x8B);
+    BOOST_REQUIRE_EQUAL(p.mask()[1], 0xFF);
+    BOOST_REQUIRE_EQUAL(p.mask()[2], 0);
+    BOOST_REQUIRE_EQUAL(p.mask()[3], 0);
+    BOOST_REQUIRE_EQUAL(p.str(), "48 8B ?? ?? E8");
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_throws_runtime_error_when_malformed)
+{
+    BOOST_REQUIRE_THROW(edo::Pattern("48 8"), std::runtime_error);
+    BOOST_REQUIRE_THROW(edo::Pattern("48 8BE8"), std::runtime_error);
+    BOOST_REQUIRE_THROW(edo::Pattern("GG"), std::runtime_error);
+    BOOST_REQUIRE_THROW(edo::Pattern("?? ??"), std::runtime_error);
+    BOOST_REQUIRE_THROW(edo::Pattern(""), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_construct_from_bytes_and_mask)
+{
+    uint8_t bytes[] = {0x48, 0x8B, 0x12, 0xE8};
+    uint8_t mask[] = {0xFF, 0xFF, 0, 1};
+    edo::Pattern p(std::vector<uint8_t>(bytes, bytes + 4),
+        std::vector<uint8_t>(mask, mask + 4));
+
+    BOOST_REQUIRE_EQUAL(p.str(), "48 8B ?? E8");
+    BOOST_REQUIRE_EQUAL(p.hash(), edo::Pattern("48 8B ?? E8").hash());
+    BOOST_REQUIRE_THROW(edo::Pattern(std::vector<uint8_t>(2),
+        std::vector<uint8_t>(2)), std::runtime_error);
+    BOOST_REQUIRE_THROW(edo::Pattern(std::vector<uint8_t>(2),
+        std::vector<uint8_t>(1)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_anchor_is_least_common_byte)
+{
+    edo::Pattern p("48 8B ?? 05 E8");
+    BOOST_REQUIRE_EQUAL(p.anchor(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_depends_on_mask)
+{
+    BOOST_REQUIRE(edo::Pattern("48 00").hash() != edo::Pattern("48 ??").hash());
+    BOOST_REQUIRE_EQUAL(edo::Pattern("48 ?").hash(),
+        edo::Pattern("48 ??").hash());
+}
+
+BOOST_AUTO_TEST_CASE(test_find_returns_first_match)
+{
+    edo::Pattern p("48 8B ?? ?? ?? E8");
+    BOOST_REQUIRE(edo::find(p, begin(), end()) == begin() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_find_returns_nullptr_when_not_found)
+{
+    edo::Pattern p("48 8B 15");
+    BOOST_REQUIRE(edo::find(p, begin(), end()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_find_does_not_read_past_end)
+{
+    edo::Pattern p("E8 C3 ??");
+    BOOST_REQUIRE(edo::find(p, begin(), end()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_find_all_returns_every_match)
+{
+    edo::Pattern p("48 8B ?? ?? ?? E8");
+    auto res = edo::find_all(p, begin(), end());
+
+    BOOST_REQUIRE_EQUAL(res.size(), 2);
+    BOOST_REQUIRE(res[0] == begin() + 1);
+    BOOST_REQUIRE(res[1] == begin() + 8);
+}
+
+BOOST_AUTO_TEST_CASE(test_scanner_finds_every_pattern)
+{
+    edo::Scanner s;
+    s.add(edo::Pattern("48 8B 0D"));
+    s.add(edo::Pattern("E8 C3"));
+    s.add(edo::Pattern("48 8B 15"));
+    s.add(edo::Pattern("90 48"));
+
+    auto hits = s.scan(begin(), end());
+
+    BOOST_REQUIRE_EQUAL(hits.size(), 4);
+    BOOST_REQUIRE(hits[0] == begin() + 8);
+    BOOST_REQUIRE(hits[1] == begin() + 13);
+    BOOST_REQUIRE(hits[2] == nullptr);
+    BOOST_REQUIRE(hits[3] == begin());
+}
+
+BOOST_AUTO_TEST_CASE(test_scanner_rejects_empty_pattern)
+{
+    edo::Scanner s;
+    BOOST_REQUIRE_THROW(s.add(edo::Pattern()), std::invalid_argument);
+    BOOST_REQUIRE_EQUAL(s.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_scanner_only_updates_missing_hits)
+{
+    edo::Scanner s;
+    s.add(edo::Pattern("48 8B"));
+    s.add(edo::Pattern("E8 C3"));
+
+    std::vector<const uint8_t*> hits = s.scan(begin() + 7, end());
+    BOOST_REQUIRE(hits[0] == begin() + 8);
+
+    hits[1] = nullptr;
+    std::size_t pending = s.scan(begin(), begin() + 7, hits);
+
+    BOOST_REQUIRE_EQUAL(pending, 1);
+    BOOST_REQUIRE(hits[0] == begin() + 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
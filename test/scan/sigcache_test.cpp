@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/module.hpp"
+#include "edo/scan/sigcache.hpp"
+
+// A unique byte sequence in the test executable to scan for
+extern const uint8_t sigcache_target[];
+const uint8_t sigcache_target[] = {0x5A, 0x17, 0xC3, 0x7E, 0x91, 0x3B,
+    0xA4, 0x62, 0x0D, 0xF8};
+
+struct SignatureCacheFixture
+{
+    SignatureCacheFixture()
+    {
+        signatures["target"] = edo::Pattern("5A 17 C3 ?? 91 3B A4 62 0D F8");
+        path = "sigcache_test.bin";
+    }
+
+    ~SignatureCacheFixture()
+    {
+        std::remove(path.c_str());
+    }
+
+    uintptr_t target()
+    {
+        return reinterpret_cast<uintptr_t>(sigcache_target);
+    }
+
+    edo::Module module = edo::Module::find("");
+    std::map<std::string, edo::Pattern> signatures;
+    std::string path;
+    edo::SignatureCache cache;
+};
+
+BOOST_FIXTURE_TEST_SUITE(sigcache_test, SignatureCacheFixture)
+
+BOOST_AUTO_TEST_CASE(test_resolve_scans_empty_cache)
+{
+    auto res = cache.resolve(module, signatures);
+
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_REQUIRE_EQUAL(res["target"], target());
+    BOOST_REQUIRE_EQUAL(cache.scanned(), 1);
+    BOOST_REQUIRE_EQUAL(cache.key(), module.id());
+}
+
+BOOST_AUTO_TEST_CASE(test_resolve_skips_scan_on_cache_hit)
+{
+    cache.resolve(module, signatures);
+    auto res = cache.resolve(module, signatures);
+
+    BOOST_REQUIRE_EQUAL(res["target"], target());
+    BOOST_REQUIRE_EQUAL(cache.scanned(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolve_rescans_stale_entries)
+{
+    cache.resolve(module, signatures);
+    cache.put("target", signatures["target"], 0);
+
+    auto res = cache.resolve(module, signatures);
+
+    BOOST_REQUIRE_EQUAL(res["target"], target());
+    BOOST_REQUIRE_EQUAL(cache.scanned(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolve_rescans_changed_patterns)
+{
+    cache.resolve(module, signatures);
+    signatures["target"] = edo::Pattern("5A 17 C3 7E");
+
+    auto res = cache.resolve(module, signatures);
+
+    BOOST_REQUIRE_EQUAL(res["target"], target());
+    BOOST_REQUIRE_EQUAL(cache.scanned(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_prepare_from_file)
+{
+    edo::ElfFile file(module.path());
+    signatures["missing"] = edo::Pattern("5A 17 C3 7E 91 3B A4 62 0D F9");
+
+    BOOST_REQUIRE_EQUAL(cache.prepare(file, signatures), 1);
+    BOOST_REQUIRE_EQUAL(cache.key(), module.id());
+    BOOST_REQUIRE(cache.has_key("target"));
+    BOOST_REQUIRE(!cache.has_key("missing"));
+
+    auto res = cache.resolve(module, signatures);
+
+    BOOST_REQUIRE_EQUAL(res["target"], target());
+    BOOST_REQUIRE_EQUAL(cache.scanned(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolve_leaves_out_missing_signatures)
+{
+    signatures["missing"] = edo::Pattern("5A 17 C3 7E 91 3B A4 62 0D F9");
+    auto res = cache.resolve(module, signatures);
+
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_REQUIRE_EQUAL(cache.has_key("missing"), false);
+}
+
+BOOST_AUTO_TEST_CASE(test_save_and_load_keep_hits)
+{
+    cache.resolve(module, signatures);
+    cache.save(path);
+
+    edo::SignatureCache loaded;
+    BOOST_REQUIRE_EQUAL(loaded.load(path), true);
+    BOOST_REQUIRE_EQUAL(loaded.key(), cache.key());
+
+    auto res = loaded.resolve(module, signatures);
+    BOOST_REQUIRE_EQUAL(res["target"], target());
+    BOOST_REQUIRE_EQUAL(loaded.scanned(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_load_fails_on_missing_file)
+{
+    BOOST_REQUIRE_EQUAL(cache.load("nonexistant_cache.bin"), false);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_throws_runtime_error_on_bad_magic)
+{
+    edo::Bytebuf buf;
+    buf.put(static_cast<uint32_t>(0));
+    buf.put(static_cast<uint32_t>(1));
+    buf.rewind();
+
+    BOOST_REQUIRE_THROW(cache.parse(buf), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_rekeying_drops_entries)
+{
+    cache.resolve(module, signatures);
+
+    edo::Bytebuf buf = cache.serialize();
+    buf.rewind();
+    cache.parse(buf);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1);
+
+    cache.clear();
+    BOOST_REQUIRE_EQUAL(cache.size(), 0);
+    BOOST_REQUIRE_EQUAL(cache.key(), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "edo/scan/static_pattern.hpp"
+#include "edo/scan/scanner.hpp"
+
+typedef EDO_PATTERN("48 8b ?? ? E8") MovCall;
+typedef EDO_PATTERN("  48 8B 0D  ") MovRcx;
+typedef EDO_PATTERN("48 8B ?? 05 E8") Rare;
+typedef EDO_PATTERN("48 ?? 4B") Noise;
+
+struct StaticPatternFixture
+{
+    StaticPatternFixture()
+    {
+        uint8_t bytes[] = {0x90, 0x48, 0x8B, 0x05, 0x10, 0x20, 0xE8, 0x90,
+            0x48, 0x8B, 0x0D, 0x30, 0x40, 0xE8, 0xC3};
+        data = std::vector<uint8_t>(bytes, bytes + sizeof(bytes));
+    }
+
+    const uint8_t* begin()
+    {
+        return data.data();
+    }
+
+    const uint8_t* end()
+    {
+        return data.data() + data.size();
+    }
+
+    std::vector<uint8_t> data;
+};
+
+BOOST_FIXTURE_TEST_SUITE(static_pattern_test, StaticPatternFixture)
+
+BOOST_AUTO_TEST_CASE(test_parse_at_compile_time)
+{
+    static_assert(MovCall::size == 5, "size");
+    static_assert(MovCall::byte(0) == 0x48 && MovCall::byte(4) == 0xE8, "byte");
+    static_assert(MovCall::wildcard(2) && MovCall::wildcard(3), "wildcard");
+    static_assert(!MovCall::wildcard(1), "wildcard");
+    static_assert(MovRcx::size == 3, "size");
+    static_assert(Rare::anchor == 3 && Rare::anchor_byte == 0x05, "anchor");
+
+    BOOST_REQUIRE_EQUAL(MovCall::str(), std::string("48 8b ?? ? E8"));
+}
+
+BOOST_AUTO_TEST_CASE(test_matches_runtime_pattern)
+{
+    edo::Pattern p = MovCall::pattern();
+
+    BOOST_REQUIRE_EQUAL(p.str(), "48 8B ?? ?? E8");
+    BOOST_REQUIRE_EQUAL(p.hash(), edo::Pattern("48 8B ?? ?? E8").hash());
+    BOOST_REQUIRE_EQUAL(p.anchor(), MovCall::anchor);
+    BOOST_REQUIRE_EQUAL(Rare::pattern().anchor(), Rare::anchor);
+}
+
+BOOST_AUTO_TEST_CASE(test_find)
+{
+    typedef EDO_PATTERN("48 8B ?? ?? ?? E8") Sig;
+
+    BOOST_REQUIRE(edo::find(Sig(), begin(), end()) == begin() + 1);
+    BOOST_REQUIRE(edo::find(MovRcx(), begin(), end()) == begin() + 8);
+    BOOST_REQUIRE(edo::find(Sig(), begin() + 2, end()) == begin() + 8);
+    BOOST_REQUIRE(edo::find(Sig(), begin() + 2, end() - 2) == nullptr);
+    BOOST_REQUIRE(edo::find(Sig(), begin(), begin() + 3) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_find_agrees_with_runtime_find)
+{
+    std::vector<uint8_t> noise(4096);
+    uint32_t x = 1;
+    for(std::size_t i = 0; i < noise.size(); i++)
+    {
+        x = x * 1103515245 + 12345;
+        noise[i] = static_cast<uint8_t>((x >> 24) & 0x0F) | 0x40;
+    }
+
+    edo::Pattern p = Noise::pattern();
+    const uint8_t* pos = noise.data();
+    const uint8_t* last = noise.data() + noise.size();
+    std::size_t hits = 0;
+    while(true)
+    {
+        const uint8_t* a = edo::find(Noise(), pos, last);
+        const uint8_t* b = edo::find(p, pos, last);
+        BOOST_REQUIRE(a == b);
+
+        if(a == nullptr)
+            break;
+
+        hits++;
+        pos = a + 1;
+    }
+
+    BOOST_REQUIRE(hits > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
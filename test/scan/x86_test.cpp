@@ -0,0 +1,175 @@
+#include <vector>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+
+#include "edo/mem/elf.hpp"
+#include "edo/mem/module.hpp"
+#include "edo/scan/x86.hpp"
+
+namespace
+{
+    struct Encoding
+    {
+        std::vector<uint8_t> bytes;
+        std::size_t length;
+    };
+}
+
+struct X86Fixture
+{
+    X86Fixture()
+    {
+        encodings = {
+            {{0x90}, 1},                                            // nop
+            {{0xC3}, 1},                                            // ret
+            {{0x55}, 1},                                            // push rbp
+            {{0x48, 0x89, 0xE5}, 3},                                // mov rbp, rsp
+            {{0x48, 0x83, 0xEC, 0x20}, 4},                          // sub rsp, 0x20
+            {{0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00}, 7},        // sub rsp, 0x100
+            {{0x8B, 0x44, 0x24, 0x08}, 4},                          // mov eax, [rsp+8]
+            {{0x8B, 0x04, 0x25, 0x00, 0x10, 0x00, 0x00}, 7},        // mov eax, [0x1000]
+            {{0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8}, 10},             // mov rax, imm64
+            {{0x66, 0xB8, 0x34, 0x12}, 4},                          // mov ax, imm16
+            {{0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00}, 6},              // nop word
+            {{0xF3, 0x0F, 0x1E, 0xFA}, 4},                          // endbr64
+            {{0xF6, 0xC1, 0x01}, 3},                                // test cl, 1
+            {{0xF7, 0xD8}, 2},                                      // neg eax
+            {{0xC8, 0x10, 0x00, 0x01}, 4},                          // enter
+            {{0xA1, 1, 2, 3, 4, 5, 6, 7, 8}, 9},                    // mov eax, moffs
+            {{0x0F, 0x38, 0x00, 0xC1}, 4},                          // pshufb
+            {{0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08}, 6},              // palignr
+            {{0xC5, 0xF8, 0x77}, 3},                                // vzeroupper
+            {{0xC5, 0xFD, 0x6F, 0x44, 0x24, 0x20}, 6},              // vmovdqa
+            {{0xC4, 0xE3, 0x7D, 0x18, 0xC1, 0x01}, 6},              // vinsertf128
+            {{0x62, 0xF1, 0x7C, 0x48, 0x10, 0x44, 0x24, 0x01}, 8},  // vmovups zmm
+            {{0x06}, 0},                                            // invalid
+            {{0x0F, 0x0B}, 2},                                      // ud2
+            {{0x48, 0x8B}, 0}                                       // truncated
+        };
+    }
+
+    std::vector<Encoding> encodings;
+};
+
+BOOST_FIXTURE_TEST_SUITE(x86_test, X86Fixture)
+
+BOOST_AUTO_TEST_CASE(test_decode_lengths)
+{
+    for(const Encoding& encoding : encodings)
+    {
+        edo::Instruction instruction = edo::decode(
+            encoding.bytes.data(), encoding.bytes.size());
+
+        BOOST_REQUIRE_EQUAL(instruction.length, encoding.length);
+        BOOST_REQUIRE(!instruction.has_target());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_operands)
+{
+    // cmp byte [rip+0x10], 1
+    uint8_t cmp[] = {0x80, 0x3D, 0x10, 0x00, 0x00, 0x00, 0x01};
+    edo::Instruction instruction = edo::decode(cmp, sizeof(cmp));
+
+    BOOST_REQUIRE_EQUAL(instruction.length, 7);
+    BOOST_REQUIRE(instruction.has_modrm);
+    BOOST_REQUIRE_EQUAL(instruction.displacement_offset, 2);
+    BOOST_REQUIRE_EQUAL(instruction.displacement, 0x10);
+    BOOST_REQUIRE_EQUAL(instruction.immediate_offset, 6);
+    BOOST_REQUIRE_EQUAL(instruction.immediate, 1);
+    BOOST_REQUIRE(instruction.has_target());
+    BOOST_REQUIRE(!instruction.branch());
+    BOOST_REQUIRE_EQUAL(instruction.target(0x1000), 0x1000 + 7 + 0x10);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_relative_targets)
+{
+    uint8_t mov[] = {0x48, 0x8B, 0x05, 0xF0, 0xFF, 0xFF, 0xFF};
+    uint8_t lea[] = {0x48, 0x8D, 0x0D, 0x00, 0x01, 0x00, 0x00};
+    uint8_t vex[] = {0xC5, 0xFE, 0x6F, 0x05, 0x08, 0x00, 0x00, 0x00};
+    uint8_t call[] = {0xE8, 0x10, 0x00, 0x00, 0x00};
+    uint8_t jcc[] = {0x0F, 0x84, 0xFB, 0xFF, 0xFF, 0xFF};
+    uint8_t jmp[] = {0xEB, 0xFE};
+
+    BOOST_REQUIRE_EQUAL(edo::decode(mov).target(0x1000), 0x1000 + 7 - 0x10);
+    BOOST_REQUIRE_EQUAL(edo::decode(lea).target(0x1000), 0x1000 + 7 + 0x100);
+    BOOST_REQUIRE_EQUAL(edo::decode(vex).target(0x1000), 0x1000 + 8 + 0x08);
+    BOOST_REQUIRE_EQUAL(edo::decode(call).target(0x1000), 0x1000 + 5 + 0x10);
+    BOOST_REQUIRE_EQUAL(edo::decode(jcc).target(0x1000), 0x1000 + 6 - 5);
+    BOOST_REQUIRE_EQUAL(edo::decode(jmp).target(0x1000), 0x1000);
+    BOOST_REQUIRE(edo::decode(call).branch());
+    BOOST_REQUIRE(edo::decode(jmp).branch());
+    BOOST_REQUIRE_EQUAL(edo::decode(jmp).relative_size, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolve_targets)
+{
+    uint8_t code[] = {0x90, 0x48, 0x8D, 0x05, 0x10, 0x00, 0x00, 0x00,
+        0xE8, 0x00, 0x00, 0x00, 0x00};
+    std::vector<const uint8_t*> hits = {code, code, nullptr, code + 8};
+    uintptr_t base = reinterpret_cast<uintptr_t>(code);
+
+    std::vector<uintptr_t> targets = edo::resolve_targets(hits, {1, 0, 0, 0});
+
+    BOOST_REQUIRE_EQUAL(targets.size(), 4);
+    BOOST_REQUIRE_EQUAL(targets[0], base + 8 + 0x10);
+    BOOST_REQUIRE_EQUAL(targets[1], 0);
+    BOOST_REQUIRE_EQUAL(targets[2], 0);
+    BOOST_REQUIRE_EQUAL(targets[3], base + 13);
+    BOOST_REQUIRE_EQUAL(edo::resolve_targets({code + 1})[0], targets[0]);
+    BOOST_REQUIRE_THROW(edo::resolve_targets(hits, {1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolve_targets_in_file)
+{
+    edo::Module module = edo::Module::find("");
+    edo::ElfFile file(module.path());
+    const edo::ElfSection* text = file.section(".text");
+
+    // Find the first call in the executable and compare with memory
+    const uint8_t* pos = file.data() + text->offset;
+    const uint8_t* end = pos + text->size;
+    while(pos < end)
+    {
+        edo::Instruction instruction = edo::decode(pos, end - pos);
+        BOOST_REQUIRE(instruction.length != 0);
+
+        if(instruction.map == 0 && instruction.opcode == 0xE8)
+            break;
+
+        pos += instruction.length;
+    }
+
+    BOOST_REQUIRE(pos < end);
+
+    uint64_t address = file.address(pos - file.data());
+    uint64_t target = edo::resolve_targets(file, {pos})[0];
+    std::vector<uintptr_t> loaded = edo::resolve_targets(
+        {reinterpret_cast<const uint8_t*>(module.base() + address)});
+
+    BOOST_REQUIRE(target != 0);
+    BOOST_REQUIRE_EQUAL(loaded[0], module.base() + target);
+}
+
+BOOST_AUTO_TEST_CASE(test_decode_executable_text)
+{
+    edo::ElfFile file(edo::Module::find("").path());
+    const edo::ElfSection* text = file.section(".text");
+
+    // A linear sweep over compiler output has to decode every instruction
+    // and end exactly at the end of the section
+    const uint8_t* pos = file.data() + text->offset;
+    const uint8_t* end = pos + text->size;
+    while(pos < end)
+    {
+        std::size_t length = edo::decode(pos, end - pos).length;
+        if(length == 0)
+            break;
+
+        pos += length;
+    }
+
+    BOOST_REQUIRE(pos == end);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
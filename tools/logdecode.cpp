@@ -0,0 +1,53 @@
+#include <ctime>
+#include <cstdio>
+#include <string>
+#include <exception>
+
+#include "edo/base/binlog.hpp"
+
+namespace
+{
+    /// Formats nanoseconds since the Unix epoch as local time with
+    /// microseconds
+    std::string timestamp(const int64_t time)
+    {
+        time_t seconds = time / 1000000000;
+        tm local;
+        localtime_r(&seconds, &local);
+
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &local);
+
+        char formatted[48];
+        std::snprintf(formatted, sizeof(formatted), "%s.%06lld", date,
+            static_cast<long long>(time % 1000000000 / 1000));
+        return formatted;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if(argc != 2)
+    {
+        std::fprintf(stderr, "usage: %s <log file>\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        edo::BinaryLogReader reader(argv[1]);
+        edo::LogEntry entry;
+        while(reader.next(entry))
+        {
+            std::printf("%s [%u] %s\n", timestamp(entry.time).c_str(),
+                entry.thread, entry.message.c_str());
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[1], e.what());
+        return 1;
+    }
+
+    return 0;
+}